@@ -0,0 +1,519 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "sfwfilter.h"
+
+#include "sfwlogging.h"
+
+#include <string.h>
+#include <math.h>
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+/** Four lane float vector holding x, y, z and unused lane
+ *
+ * Compiles to SSE / NEON operations where available, and to
+ * scalar code elsewhere.
+ */
+typedef float SfwFilterVec __attribute__((vector_size(16)));
+
+typedef struct SfwFilterBiquad
+{
+    SfwFilterVec bq_b0, bq_b1, bq_b2, bq_a1, bq_a2;
+    SfwFilterVec bq_z1, bq_z2;
+} SfwFilterBiquad;
+
+typedef struct SfwFilterWindow
+{
+    SfwFilterVec  win_data[SFWFILTER_WINDOW_MAX];
+    SfwFilterVec  win_sum;
+    size_t        win_size;
+    size_t        win_pos;
+    size_t        win_fill;
+} SfwFilterWindow;
+
+struct SfwFilter
+{
+    SfwFilterType flt_type;
+    bool          flt_primed;
+
+    /* EMA / gravity removal */
+    SfwFilterVec  flt_alpha;
+    SfwFilterVec  flt_state;
+
+    /* Low-pass / high-pass */
+    SfwFilterBiquad flt_biquad;
+
+    /* Moving average / median */
+    SfwFilterWindow flt_window;
+};
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWFILTER_VEC
+ * ------------------------------------------------------------------------- */
+
+static inline SfwFilterVec sfwfilter_vec_splat(float val);
+static inline SfwFilterVec sfwfilter_vec_load (const SfwSample *sample);
+static inline void         sfwfilter_vec_store(SfwSample *sample, SfwFilterVec vec);
+
+/* ------------------------------------------------------------------------- *
+ * SFWFILTER_KERNELS
+ * ------------------------------------------------------------------------- */
+
+static void  sfwfilter_process_ema           (SfwFilter *self, SfwSample *samples, size_t count);
+static void  sfwfilter_process_gravity       (SfwFilter *self, SfwSample *samples, size_t count);
+static void  sfwfilter_process_biquad        (SfwFilter *self, SfwSample *samples, size_t count);
+static void  sfwfilter_process_moving_average(SfwFilter *self, SfwSample *samples, size_t count);
+static float sfwfilter_median_of             (float *data, size_t count);
+static void  sfwfilter_process_median        (SfwFilter *self, SfwSample *samples, size_t count);
+
+/* ------------------------------------------------------------------------- *
+ * SFWFILTER
+ * ------------------------------------------------------------------------- */
+
+static SfwFilter *sfwfilter_create             (SfwFilterType type);
+static SfwFilter *sfwfilter_new_biquad         (SfwFilterType type, double cutoff_hz, double rate_hz, double q);
+SfwFilter        *sfwfilter_new_ema            (float alpha);
+SfwFilter        *sfwfilter_new_lowpass        (double cutoff_hz, double rate_hz, double q);
+SfwFilter        *sfwfilter_new_highpass       (double cutoff_hz, double rate_hz, double q);
+SfwFilter        *sfwfilter_new_moving_average (size_t window);
+SfwFilter        *sfwfilter_new_median         (size_t window);
+SfwFilter        *sfwfilter_new_gravity_removal(float alpha);
+void              sfwfilter_delete             (SfwFilter *self);
+void              sfwfilter_delete_at          (SfwFilter **pself);
+void              sfwfilter_delete_cb          (gpointer self);
+SfwFilterType     sfwfilter_type               (const SfwFilter *self);
+const char       *sfwfilter_name               (const SfwFilter *self);
+void              sfwfilter_reset              (SfwFilter *self);
+void              sfwfilter_process            (SfwFilter *self, SfwSample *samples, size_t count);
+
+/* ========================================================================= *
+ * SFWFILTER_VEC
+ * ========================================================================= */
+
+static inline SfwFilterVec
+sfwfilter_vec_splat(float val)
+{
+    return (SfwFilterVec){ val, val, val, val };
+}
+
+static inline SfwFilterVec
+sfwfilter_vec_load(const SfwSample *sample)
+{
+    return (SfwFilterVec){ sample->xyz.x, sample->xyz.y, sample->xyz.z, 0.0f };
+}
+
+static inline void
+sfwfilter_vec_store(SfwSample *sample, SfwFilterVec vec)
+{
+    sample->xyz.x = vec[0];
+    sample->xyz.y = vec[1];
+    sample->xyz.z = vec[2];
+}
+
+/* ========================================================================= *
+ * SFWFILTER_KERNELS
+ * ========================================================================= */
+
+static void
+sfwfilter_process_ema(SfwFilter *self, SfwSample *samples, size_t count)
+{
+    SfwFilterVec alpha = self->flt_alpha;
+    SfwFilterVec state = self->flt_state;
+
+    for( size_t i = 0; i < count; ++i ) {
+        SfwFilterVec in = sfwfilter_vec_load(&samples[i]);
+        if( !self->flt_primed )
+            state = in, self->flt_primed = true;
+        else
+            state += alpha * (in - state);
+        sfwfilter_vec_store(&samples[i], state);
+    }
+    self->flt_state = state;
+}
+
+static void
+sfwfilter_process_gravity(SfwFilter *self, SfwSample *samples, size_t count)
+{
+    /* Track gravity with low-pass filter and output the remainder */
+    SfwFilterVec alpha   = self->flt_alpha;
+    SfwFilterVec gravity = self->flt_state;
+
+    for( size_t i = 0; i < count; ++i ) {
+        SfwFilterVec in = sfwfilter_vec_load(&samples[i]);
+        if( !self->flt_primed )
+            gravity = in, self->flt_primed = true;
+        else
+            gravity += alpha * (in - gravity);
+        sfwfilter_vec_store(&samples[i], in - gravity);
+    }
+    self->flt_state = gravity;
+}
+
+static void
+sfwfilter_process_biquad(SfwFilter *self, SfwSample *samples, size_t count)
+{
+    /* Direct form II transposed */
+    SfwFilterBiquad *bq = &self->flt_biquad;
+    SfwFilterVec     z1 = bq->bq_z1;
+    SfwFilterVec     z2 = bq->bq_z2;
+
+    for( size_t i = 0; i < count; ++i ) {
+        SfwFilterVec in = sfwfilter_vec_load(&samples[i]);
+        if( !self->flt_primed ) {
+            /* Start from steady state to avoid initial transient */
+            SfwFilterVec dc = (bq->bq_b0 + bq->bq_b1 + bq->bq_b2) /
+                (sfwfilter_vec_splat(1.0f) + bq->bq_a1 + bq->bq_a2);
+            SfwFilterVec out = dc * in;
+            z1 = out - bq->bq_b0 * in;
+            z2 = bq->bq_b2 * in - bq->bq_a2 * out;
+            self->flt_primed = true;
+        }
+        SfwFilterVec out = bq->bq_b0 * in + z1;
+        z1 = bq->bq_b1 * in - bq->bq_a1 * out + z2;
+        z2 = bq->bq_b2 * in - bq->bq_a2 * out;
+        sfwfilter_vec_store(&samples[i], out);
+    }
+    bq->bq_z1 = z1;
+    bq->bq_z2 = z2;
+}
+
+static void
+sfwfilter_process_moving_average(SfwFilter *self, SfwSample *samples,
+                                 size_t count)
+{
+    SfwFilterWindow *win = &self->flt_window;
+
+    for( size_t i = 0; i < count; ++i ) {
+        SfwFilterVec in = sfwfilter_vec_load(&samples[i]);
+
+        if( win->win_fill < win->win_size )
+            win->win_fill++;
+        else
+            win->win_sum -= win->win_data[win->win_pos];
+        win->win_data[win->win_pos] = in;
+        win->win_sum += in;
+
+        if( ++win->win_pos == win->win_size ) {
+            /* Recalculate sum once per window to limit
+             * accumulation of rounding errors */
+            win->win_pos = 0;
+            win->win_sum = sfwfilter_vec_splat(0.0f);
+            for( size_t k = 0; k < win->win_fill; ++k )
+                win->win_sum += win->win_data[k];
+        }
+
+        sfwfilter_vec_store(&samples[i], win->win_sum /
+                            sfwfilter_vec_splat((float)win->win_fill));
+    }
+}
+
+static float
+sfwfilter_median_of(float *data, size_t count)
+{
+    /* Insertion sort - windows are small */
+    for( size_t i = 1; i < count; ++i ) {
+        float  val = data[i];
+        size_t k   = i;
+        for( ; k > 0 && data[k - 1] > val; --k )
+            data[k] = data[k - 1];
+        data[k] = val;
+    }
+    if( count & 1 )
+        return data[count / 2];
+    return 0.5f * (data[count / 2 - 1] + data[count / 2]);
+}
+
+static void
+sfwfilter_process_median(SfwFilter *self, SfwSample *samples, size_t count)
+{
+    SfwFilterWindow *win = &self->flt_window;
+    float            tmp[SFWFILTER_WINDOW_MAX];
+
+    for( size_t i = 0; i < count; ++i ) {
+        win->win_data[win->win_pos] = sfwfilter_vec_load(&samples[i]);
+        if( ++win->win_pos == win->win_size )
+            win->win_pos = 0;
+        if( win->win_fill < win->win_size )
+            win->win_fill++;
+
+        SfwFilterVec out = sfwfilter_vec_splat(0.0f);
+        for( int ch = 0; ch < 3; ++ch ) {
+            for( size_t k = 0; k < win->win_fill; ++k )
+                tmp[k] = win->win_data[k][ch];
+            out[ch] = sfwfilter_median_of(tmp, win->win_fill);
+        }
+        sfwfilter_vec_store(&samples[i], out);
+    }
+}
+
+/* ========================================================================= *
+ * SFWFILTER
+ * ========================================================================= */
+
+static SfwFilter *
+sfwfilter_create(SfwFilterType type)
+{
+    SfwFilter *self = g_new0(SfwFilter, 1);
+    self->flt_type = type;
+    sfwfilter_reset(self);
+    return self;
+}
+
+/** Create biquad filter using coefficients from the "Audio EQ Cookbook"
+ */
+static SfwFilter *
+sfwfilter_new_biquad(SfwFilterType type, double cutoff_hz, double rate_hz,
+                     double q)
+{
+    SfwFilter *self = NULL;
+
+    if( !(rate_hz > 0.0 && cutoff_hz > 0.0 && cutoff_hz < rate_hz / 2) ) {
+        sfwlog_warning("invalid cutoff %g Hz for sample rate %g Hz",
+                       cutoff_hz, rate_hz);
+        goto EXIT;
+    }
+    if( !(q > 0.0) )
+        q = M_SQRT1_2;
+
+    double w0    = 2.0 * M_PI * cutoff_hz / rate_hz;
+    double cw    = cos(w0);
+    double alpha = sin(w0) / (2.0 * q);
+    double a0    = 1.0 + alpha;
+    double b0, b1, b2;
+
+    if( type == SFW_FILTER_LOWPASS )
+        b1 = (1.0 - cw) / a0, b0 = b2 = b1 / 2;
+    else
+        b1 = -(1.0 + cw) / a0, b0 = b2 = -b1 / 2;
+
+    self = sfwfilter_create(type);
+    self->flt_biquad.bq_b0 = sfwfilter_vec_splat(b0);
+    self->flt_biquad.bq_b1 = sfwfilter_vec_splat(b1);
+    self->flt_biquad.bq_b2 = sfwfilter_vec_splat(b2);
+    self->flt_biquad.bq_a1 = sfwfilter_vec_splat(-2.0 * cw / a0);
+    self->flt_biquad.bq_a2 = sfwfilter_vec_splat((1.0 - alpha) / a0);
+
+EXIT:
+    return self;
+}
+
+/** Create exponential moving average low-pass filter
+ *
+ * @param alpha  smoothing factor in range (0, 1]; smaller values
+ *               mean heavier smoothing
+ */
+SfwFilter *
+sfwfilter_new_ema(float alpha)
+{
+    SfwFilter *self = NULL;
+    if( !(alpha > 0.0f && alpha <= 1.0f) ) {
+        sfwlog_warning("invalid ema alpha: %g", alpha);
+    }
+    else {
+        self = sfwfilter_create(SFW_FILTER_EMA);
+        self->flt_alpha = sfwfilter_vec_splat(alpha);
+    }
+    return self;
+}
+
+/** Create second order low-pass filter
+ *
+ * @param cutoff_hz  cutoff frequency, below rate_hz / 2
+ * @param rate_hz    expected sample rate
+ * @param q          quality factor, or zero for Butterworth response
+ */
+SfwFilter *
+sfwfilter_new_lowpass(double cutoff_hz, double rate_hz, double q)
+{
+    return sfwfilter_new_biquad(SFW_FILTER_LOWPASS, cutoff_hz, rate_hz, q);
+}
+
+/** Create second order high-pass filter
+ *
+ * @param cutoff_hz  cutoff frequency, below rate_hz / 2
+ * @param rate_hz    expected sample rate
+ * @param q          quality factor, or zero for Butterworth response
+ */
+SfwFilter *
+sfwfilter_new_highpass(double cutoff_hz, double rate_hz, double q)
+{
+    return sfwfilter_new_biquad(SFW_FILTER_HIGHPASS, cutoff_hz, rate_hz, q);
+}
+
+SfwFilter *
+sfwfilter_new_moving_average(size_t window)
+{
+    SfwFilter *self = NULL;
+    if( window < 1 || window > SFWFILTER_WINDOW_MAX ) {
+        sfwlog_warning("invalid moving average window: %zu", window);
+    }
+    else {
+        self = sfwfilter_create(SFW_FILTER_MOVING_AVERAGE);
+        self->flt_window.win_size = window;
+    }
+    return self;
+}
+
+SfwFilter *
+sfwfilter_new_median(size_t window)
+{
+    SfwFilter *self = NULL;
+    if( window < 1 || window > SFWFILTER_WINDOW_MAX ) {
+        sfwlog_warning("invalid median window: %zu", window);
+    }
+    else {
+        self = sfwfilter_create(SFW_FILTER_MEDIAN);
+        self->flt_window.win_size = window;
+    }
+    return self;
+}
+
+/** Create gravity removal filter
+ *
+ * Gravity is estimated with exponential moving average low-pass
+ * filter and subtracted from the input, leaving linear acceleration.
+ *
+ * @param alpha  gravity tracking factor in range (0, 1]; typically
+ *               small value such as 0.1
+ */
+SfwFilter *
+sfwfilter_new_gravity_removal(float alpha)
+{
+    SfwFilter *self = NULL;
+    if( !(alpha > 0.0f && alpha <= 1.0f) ) {
+        sfwlog_warning("invalid gravity alpha: %g", alpha);
+    }
+    else {
+        self = sfwfilter_create(SFW_FILTER_GRAVITY_REMOVAL);
+        self->flt_alpha = sfwfilter_vec_splat(alpha);
+    }
+    return self;
+}
+
+void
+sfwfilter_delete(SfwFilter *self)
+{
+    g_free(self);
+}
+
+void
+sfwfilter_delete_at(SfwFilter **pself)
+{
+    sfwfilter_delete(*pself), *pself = NULL;
+}
+
+void
+sfwfilter_delete_cb(gpointer self)
+{
+    sfwfilter_delete(self);
+}
+
+SfwFilterType
+sfwfilter_type(const SfwFilter *self)
+{
+    return self->flt_type;
+}
+
+const char *
+sfwfilter_name(const SfwFilter *self)
+{
+    static const char * const lut[] = {
+        [SFW_FILTER_EMA]             = "ema",
+        [SFW_FILTER_LOWPASS]         = "lowpass",
+        [SFW_FILTER_HIGHPASS]        = "highpass",
+        [SFW_FILTER_MOVING_AVERAGE]  = "moving-average",
+        [SFW_FILTER_MEDIAN]          = "median",
+        [SFW_FILTER_GRAVITY_REMOVAL] = "gravity-removal",
+    };
+    return self ? lut[self->flt_type] : "null";
+}
+
+/** Forget filter history
+ *
+ * The next processed sample is treated as the first one.
+ */
+void
+sfwfilter_reset(SfwFilter *self)
+{
+    if( self ) {
+        self->flt_primed            = false;
+        self->flt_state             = sfwfilter_vec_splat(0.0f);
+        self->flt_biquad.bq_z1      = sfwfilter_vec_splat(0.0f);
+        self->flt_biquad.bq_z2      = sfwfilter_vec_splat(0.0f);
+        self->flt_window.win_sum    = sfwfilter_vec_splat(0.0f);
+        self->flt_window.win_pos    = 0;
+        self->flt_window.win_fill   = 0;
+    }
+}
+
+/** Filter an array of xyz samples in place
+ */
+void
+sfwfilter_process(SfwFilter *self, SfwSample *samples, size_t count)
+{
+    if( !self )
+        goto EXIT;
+
+    switch( self->flt_type ) {
+    case SFW_FILTER_EMA:
+        sfwfilter_process_ema(self, samples, count);
+        break;
+    case SFW_FILTER_LOWPASS:
+    case SFW_FILTER_HIGHPASS:
+        sfwfilter_process_biquad(self, samples, count);
+        break;
+    case SFW_FILTER_MOVING_AVERAGE:
+        sfwfilter_process_moving_average(self, samples, count);
+        break;
+    case SFW_FILTER_MEDIAN:
+        sfwfilter_process_median(self, samples, count);
+        break;
+    case SFW_FILTER_GRAVITY_REMOVAL:
+        sfwfilter_process_gravity(self, samples, count);
+        break;
+    }
+
+EXIT:
+    return;
+}
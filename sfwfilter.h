@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef SFWFILTER_H_
+# define SFWFILTER_H_
+
+# include "sfwtypes.h"
+
+G_BEGIN_DECLS
+
+# pragma GCC visibility push(default)
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Maximum window size for moving average and median filters */
+# define SFWFILTER_WINDOW_MAX 64
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+/** Filter stage types
+ */
+typedef enum SfwFilterType
+{
+    SFW_FILTER_EMA,
+    SFW_FILTER_LOWPASS,
+    SFW_FILTER_HIGHPASS,
+    SFW_FILTER_MOVING_AVERAGE,
+    SFW_FILTER_MEDIAN,
+    SFW_FILTER_GRAVITY_REMOVAL,
+} SfwFilterType;
+
+/** Filter stage operating on xyz sample data
+ *
+ * All stages process x, y and z channels independently, in place.
+ * Timestamps are left untouched.
+ */
+typedef struct SfwFilter SfwFilter;
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWFILTER
+ * ------------------------------------------------------------------------- */
+
+SfwFilter     *sfwfilter_new_ema            (float alpha);
+SfwFilter     *sfwfilter_new_lowpass        (double cutoff_hz, double rate_hz, double q);
+SfwFilter     *sfwfilter_new_highpass       (double cutoff_hz, double rate_hz, double q);
+SfwFilter     *sfwfilter_new_moving_average (size_t window);
+SfwFilter     *sfwfilter_new_median         (size_t window);
+SfwFilter     *sfwfilter_new_gravity_removal(float alpha);
+void           sfwfilter_delete             (SfwFilter *self);
+void           sfwfilter_delete_at          (SfwFilter **pself);
+void           sfwfilter_delete_cb          (gpointer self);
+SfwFilterType  sfwfilter_type               (const SfwFilter *self);
+const char    *sfwfilter_name               (const SfwFilter *self);
+void           sfwfilter_reset              (SfwFilter *self);
+void           sfwfilter_process            (SfwFilter *self, SfwSample *samples, size_t count);
+
+# pragma GCC visibility pop
+
+G_END_DECLS
+
+#endif /* SFWFILTER_H_ */
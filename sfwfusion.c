@@ -0,0 +1,789 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "sfwfusion.h"
+
+#include "sfwlogging.h"
+
+#include <math.h>
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Maximum number of gyroscope readings held for alignment */
+#define SFWFUSION_QUEUE_MAX 16
+
+/** Maximum time gyroscope readings are held waiting for accelerometer [us] */
+#define SFWFUSION_SKEW_MAX 50000
+
+/** Maximum age of magnetometer reading that is still used [us] */
+#define SFWFUSION_MAG_AGE_MAX 1000000
+
+/** Gyroscope gap after which estimation is restarted [us] */
+#define SFWFUSION_GAP_MAX 500000
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+typedef enum SfwFusionRole
+{
+    SFWFUSION_ROLE_ACCELEROMETER,
+    SFWFUSION_ROLE_GYROSCOPE,
+    SFWFUSION_ROLE_MAGNETOMETER,
+    SFWFUSION_ROLE_COUNT,
+} SfwFusionRole;
+
+typedef struct SfwFusionInput
+{
+    uint64_t fi_timestamp;
+    double   fi_v[3];
+} SfwFusionInput;
+
+struct SfwFusion
+{
+    SfwFusionAlgorithm  fus_algorithm;
+    double              fus_gain;
+    double              fus_gain_i;
+
+    SfwFusionHandler    fus_handler;
+    gpointer            fus_aptr;
+
+    SfwSensor          *fus_sensor[SFWFUSION_ROLE_COUNT];
+    guint               fus_sensor_id[SFWFUSION_ROLE_COUNT];
+
+    /* Estimation state */
+    bool                fus_initialized;
+    uint64_t            fus_time;
+    double              fus_q[4];
+    double              fus_integral[3];
+
+    /* Accelerometer: previous and latest reading */
+    SfwFusionInput      fus_accel[2];
+    size_t              fus_accel_count;
+
+    SfwFusionInput      fus_mag;
+    bool                fus_mag_valid;
+
+    /* Gyroscope readings waiting for accelerometer data */
+    SfwFusionInput      fus_gyro[SFWFUSION_QUEUE_MAX];
+    size_t              fus_gyro_head;
+    size_t              fus_gyro_count;
+
+    SfwOrientation      fus_orientation;
+};
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWFUSION_MATH
+ * ------------------------------------------------------------------------- */
+
+static bool sfwfusion_normalize   (double *v, size_t n);
+static void sfwfusion_cross       (const double *a, const double *b, double *out);
+static void sfwfusion_multiply    (const double *p, const double *q, double *out);
+static void sfwfusion_rotate      (const double *q, const double *v, double *out);
+static void sfwfusion_up          (const double *q, double *out);
+static void sfwfusion_integrate   (double *q, const double *g, double dt);
+static void sfwfusion_from_vectors(double *q, const double *a, const double *m);
+
+/* ------------------------------------------------------------------------- *
+ * SFWFUSION_ALGORITHMS
+ * ------------------------------------------------------------------------- */
+
+static void sfwfusion_update_complementary(SfwFusion *self, const double *g, const double *a, const double *m, double dt);
+static void sfwfusion_update_madgwick     (SfwFusion *self, const double *g, const double *a, const double *m, double dt);
+static void sfwfusion_update_mahony       (SfwFusion *self, const double *g, const double *a, const double *m, double dt);
+
+/* ------------------------------------------------------------------------- *
+ * SFWFUSION
+ * ------------------------------------------------------------------------- */
+
+static bool            sfwfusion_accel_at   (const SfwFusion *self, uint64_t t, double *out);
+static void            sfwfusion_publish    (SfwFusion *self, uint64_t t);
+static void            sfwfusion_step       (SfwFusion *self, const SfwFusionInput *gyro);
+static void            sfwfusion_flush      (SfwFusion *self);
+static void            sfwfusion_reading_cb (SfwSensor *sensor, const SfwReading *reading, gpointer aptr);
+SfwFusion             *sfwfusion_new        (SfwFusionAlgorithm algorithm);
+void                   sfwfusion_delete     (SfwFusion *self);
+void                   sfwfusion_delete_at  (SfwFusion **pself);
+void                   sfwfusion_set_gain   (SfwFusion *self, double gain, double gain_i);
+void                   sfwfusion_set_handler(SfwFusion *self, SfwFusionHandler handler, gpointer aptr);
+void                   sfwfusion_reset      (SfwFusion *self);
+bool                   sfwfusion_attach     (SfwFusion *self, SfwSensor *sensor);
+void                   sfwfusion_detach     (SfwFusion *self);
+void                   sfwfusion_add        (SfwFusion *self, const SfwReading *reading);
+const SfwOrientation  *sfwfusion_orientation(const SfwFusion *self);
+
+/* ========================================================================= *
+ * SFWFUSION_MATH
+ * ========================================================================= */
+
+static bool
+sfwfusion_normalize(double *v, size_t n)
+{
+    double sum = 0.0;
+    for( size_t i = 0; i < n; ++i )
+        sum += v[i] * v[i];
+    if( !(sum > 0.0) )
+        return false;
+    double inv = 1.0 / sqrt(sum);
+    for( size_t i = 0; i < n; ++i )
+        v[i] *= inv;
+    return true;
+}
+
+static void
+sfwfusion_cross(const double *a, const double *b, double *out)
+{
+    double x = a[1] * b[2] - a[2] * b[1];
+    double y = a[2] * b[0] - a[0] * b[2];
+    double z = a[0] * b[1] - a[1] * b[0];
+    out[0] = x, out[1] = y, out[2] = z;
+}
+
+/** Quaternion product p * q
+ */
+static void
+sfwfusion_multiply(const double *p, const double *q, double *out)
+{
+    double w = p[0] * q[0] - p[1] * q[1] - p[2] * q[2] - p[3] * q[3];
+    double x = p[0] * q[1] + p[1] * q[0] + p[2] * q[3] - p[3] * q[2];
+    double y = p[0] * q[2] - p[1] * q[3] + p[2] * q[0] + p[3] * q[1];
+    double z = p[0] * q[3] + p[1] * q[2] - p[2] * q[1] + p[3] * q[0];
+    out[0] = w, out[1] = x, out[2] = y, out[3] = z;
+}
+
+/** Rotate device frame vector to earth frame
+ */
+static void
+sfwfusion_rotate(const double *q, const double *v, double *out)
+{
+    double p[4] = { 0.0, v[0], v[1], v[2] };
+    double c[4] = { q[0], -q[1], -q[2], -q[3] };
+    sfwfusion_multiply(q, p, p);
+    sfwfusion_multiply(p, c, p);
+    out[0] = p[1], out[1] = p[2], out[2] = p[3];
+}
+
+/** Get earth frame up direction in device frame
+ */
+static void
+sfwfusion_up(const double *q, double *out)
+{
+    out[0] = 2.0 * (q[1] * q[3] - q[0] * q[2]);
+    out[1] = 2.0 * (q[0] * q[1] + q[2] * q[3]);
+    out[2] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+}
+
+/** Advance orientation by angular rate g [rad/s] over dt [s]
+ */
+static void
+sfwfusion_integrate(double *q, const double *g, double dt)
+{
+    double r[4] = { 0.0, g[0], g[1], g[2] };
+    double d[4];
+    sfwfusion_multiply(q, r, d);
+    for( size_t i = 0; i < 4; ++i )
+        q[i] += 0.5 * d[i] * dt;
+    sfwfusion_normalize(q, 4);
+}
+
+/** Evaluate orientation from gravity and magnetic field directions
+ *
+ * Without magnetic field, heading is chosen so that device x axis
+ * points towards earth frame x axis.
+ */
+static void
+sfwfusion_from_vectors(double *q, const double *a, const double *m)
+{
+    double up[3]    = { a[0], a[1], a[2] };
+    double ref[3]   = { 1.0, 0.0, 0.0 };
+    double west[3];
+    double north[3];
+
+    if( m )
+        ref[0] = m[0], ref[1] = m[1], ref[2] = m[2];
+    else if( fabs(up[0]) > 0.9 )
+        ref[0] = 0.0, ref[1] = 1.0;
+
+    sfwfusion_normalize(up, 3);
+    sfwfusion_cross(up, ref, west);
+    if( !sfwfusion_normalize(west, 3) ) {
+        q[0] = 1.0, q[1] = q[2] = q[3] = 0.0;
+        return;
+    }
+    sfwfusion_cross(west, up, north);
+
+    /* Rows of device to earth rotation matrix */
+    const double *r[3] = { north, west, up };
+    double tr = r[0][0] + r[1][1] + r[2][2];
+    if( tr > 0.0 ) {
+        double s = 2.0 * sqrt(tr + 1.0);
+        q[0] = 0.25 * s;
+        q[1] = (r[2][1] - r[1][2]) / s;
+        q[2] = (r[0][2] - r[2][0]) / s;
+        q[3] = (r[1][0] - r[0][1]) / s;
+    }
+    else if( r[0][0] > r[1][1] && r[0][0] > r[2][2] ) {
+        double s = 2.0 * sqrt(1.0 + r[0][0] - r[1][1] - r[2][2]);
+        q[0] = (r[2][1] - r[1][2]) / s;
+        q[1] = 0.25 * s;
+        q[2] = (r[0][1] + r[1][0]) / s;
+        q[3] = (r[0][2] + r[2][0]) / s;
+    }
+    else if( r[1][1] > r[2][2] ) {
+        double s = 2.0 * sqrt(1.0 + r[1][1] - r[0][0] - r[2][2]);
+        q[0] = (r[0][2] - r[2][0]) / s;
+        q[1] = (r[0][1] + r[1][0]) / s;
+        q[2] = 0.25 * s;
+        q[3] = (r[1][2] + r[2][1]) / s;
+    }
+    else {
+        double s = 2.0 * sqrt(1.0 + r[2][2] - r[0][0] - r[1][1]);
+        q[0] = (r[1][0] - r[0][1]) / s;
+        q[1] = (r[0][2] + r[2][0]) / s;
+        q[2] = (r[1][2] + r[2][1]) / s;
+        q[3] = 0.25 * s;
+    }
+    sfwfusion_normalize(q, 4);
+}
+
+/* ========================================================================= *
+ * SFWFUSION_ALGORITHMS
+ * ========================================================================= */
+
+/** Gyroscope integration with decoupled tilt and heading correction
+ *
+ * Tilt is pulled towards measured gravity, and heading is then
+ * corrected by rotating about the vertical axis only, so that
+ * magnetic disturbances do not affect tilt.
+ */
+static void
+sfwfusion_update_complementary(SfwFusion *self, const double *g,
+                               const double *a, const double *m, double dt)
+{
+    double *q    = self->fus_q;
+    double  frac = MIN(1.0, self->fus_gain * dt);
+
+    sfwfusion_integrate(q, g, dt);
+
+    if( a ) {
+        double up[3], axis[3];
+        sfwfusion_up(q, up);
+        sfwfusion_cross(a, up, axis);
+        double s = sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+        double c = a[0] * up[0] + a[1] * up[1] + a[2] * up[2];
+        if( s > 0.0 ) {
+            double half = 0.5 * frac * atan2(s, c);
+            double k    = sin(half) / s;
+            double d[4] = { cos(half), axis[0] * k, axis[1] * k, axis[2] * k };
+            sfwfusion_multiply(q, d, q);
+        }
+    }
+
+    if( a && m ) {
+        double h[3];
+        sfwfusion_rotate(q, m, h);
+        if( h[0] != 0.0 || h[1] != 0.0 ) {
+            double half = -0.5 * frac * atan2(h[1], h[0]);
+            double d[4] = { cos(half), 0.0, 0.0, sin(half) };
+            sfwfusion_multiply(d, q, q);
+        }
+    }
+
+    sfwfusion_normalize(q, 4);
+}
+
+/** Madgwick gradient descent orientation filter
+ */
+static void
+sfwfusion_update_madgwick(SfwFusion *self, const double *g,
+                          const double *a, const double *m, double dt)
+{
+    double *q = self->fus_q;
+    double  s[4] = { 0.0, 0.0, 0.0, 0.0 };
+
+    if( a ) {
+        /* Objective: estimated up direction vs measured gravity */
+        double f1 = 2.0 * (q[1] * q[3] - q[0] * q[2]) - a[0];
+        double f2 = 2.0 * (q[0] * q[1] + q[2] * q[3]) - a[1];
+        double f3 = 2.0 * (0.5 - q[1] * q[1] - q[2] * q[2]) - a[2];
+
+        s[0] += -2.0 * q[2] * f1 + 2.0 * q[1] * f2;
+        s[1] +=  2.0 * q[3] * f1 + 2.0 * q[0] * f2 - 4.0 * q[1] * f3;
+        s[2] += -2.0 * q[0] * f1 + 2.0 * q[3] * f2 - 4.0 * q[2] * f3;
+        s[3] +=  2.0 * q[1] * f1 + 2.0 * q[2] * f2;
+    }
+
+    if( a && m ) {
+        /* Reference field: horizontal and vertical components of the
+         * measured field in earth frame */
+        double h[3];
+        sfwfusion_rotate(q, m, h);
+        double bx = sqrt(h[0] * h[0] + h[1] * h[1]);
+        double bz = h[2];
+
+        double f4 = 2.0 * bx * (0.5 - q[2] * q[2] - q[3] * q[3])
+            + 2.0 * bz * (q[1] * q[3] - q[0] * q[2]) - m[0];
+        double f5 = 2.0 * bx * (q[1] * q[2] - q[0] * q[3])
+            + 2.0 * bz * (q[0] * q[1] + q[2] * q[3]) - m[1];
+        double f6 = 2.0 * bx * (q[0] * q[2] + q[1] * q[3])
+            + 2.0 * bz * (0.5 - q[1] * q[1] - q[2] * q[2]) - m[2];
+
+        s[0] += -2.0 * bz * q[2] * f4
+            + (-2.0 * bx * q[3] + 2.0 * bz * q[1]) * f5
+            + 2.0 * bx * q[2] * f6;
+        s[1] += 2.0 * bz * q[3] * f4
+            + (2.0 * bx * q[2] + 2.0 * bz * q[0]) * f5
+            + (2.0 * bx * q[3] - 4.0 * bz * q[1]) * f6;
+        s[2] += (-4.0 * bx * q[2] - 2.0 * bz * q[0]) * f4
+            + (2.0 * bx * q[1] + 2.0 * bz * q[3]) * f5
+            + (2.0 * bx * q[0] - 4.0 * bz * q[2]) * f6;
+        s[3] += (-4.0 * bx * q[3] + 2.0 * bz * q[1]) * f4
+            + (-2.0 * bx * q[0] + 2.0 * bz * q[2]) * f5
+            + 2.0 * bx * q[1] * f6;
+    }
+
+    sfwfusion_integrate(q, g, dt);
+
+    if( sfwfusion_normalize(s, 4) ) {
+        for( size_t i = 0; i < 4; ++i )
+            q[i] -= self->fus_gain * s[i] * dt;
+        sfwfusion_normalize(q, 4);
+    }
+}
+
+/** Mahony nonlinear complementary filter
+ */
+static void
+sfwfusion_update_mahony(SfwFusion *self, const double *g,
+                        const double *a, const double *m, double dt)
+{
+    double *q    = self->fus_q;
+    double  e[3] = { 0.0, 0.0, 0.0 };
+    double  w[3] = { g[0], g[1], g[2] };
+
+    if( a ) {
+        double up[3];
+        sfwfusion_up(q, up);
+        sfwfusion_cross(a, up, e);
+    }
+
+    if( a && m ) {
+        /* Estimated field direction in device frame */
+        double h[3], b[3], v[3], c[4] = { q[0], -q[1], -q[2], -q[3] };
+        sfwfusion_rotate(q, m, h);
+        b[0] = sqrt(h[0] * h[0] + h[1] * h[1]), b[1] = 0.0, b[2] = h[2];
+        sfwfusion_rotate(c, b, v);
+        double em[3];
+        sfwfusion_cross(m, v, em);
+        for( size_t i = 0; i < 3; ++i )
+            e[i] += em[i];
+    }
+
+    if( self->fus_gain_i > 0.0 ) {
+        for( size_t i = 0; i < 3; ++i ) {
+            self->fus_integral[i] += self->fus_gain_i * e[i] * dt;
+            w[i] += self->fus_integral[i];
+        }
+    }
+    for( size_t i = 0; i < 3; ++i )
+        w[i] += self->fus_gain * e[i];
+
+    sfwfusion_integrate(q, w, dt);
+}
+
+/* ========================================================================= *
+ * SFWFUSION
+ * ========================================================================= */
+
+/** Get accelerometer data interpolated to given time
+ */
+static bool
+sfwfusion_accel_at(const SfwFusion *self, uint64_t t, double *out)
+{
+    if( self->fus_accel_count == 0 )
+        return false;
+
+    const SfwFusionInput *prev = &self->fus_accel[0];
+    const SfwFusionInput *last = &self->fus_accel[1];
+
+    if( self->fus_accel_count < 2 || t >= last->fi_timestamp ) {
+        memcpy(out, last->fi_v, sizeof last->fi_v);
+    }
+    else if( t <= prev->fi_timestamp ) {
+        memcpy(out, prev->fi_v, sizeof prev->fi_v);
+    }
+    else {
+        double frac = (double)(t - prev->fi_timestamp) /
+            (last->fi_timestamp - prev->fi_timestamp);
+        for( size_t i = 0; i < 3; ++i )
+            out[i] = prev->fi_v[i] + frac * (last->fi_v[i] - prev->fi_v[i]);
+    }
+    return sfwfusion_normalize(out, 3);
+}
+
+static void
+sfwfusion_publish(SfwFusion *self, uint64_t t)
+{
+    const double   *q   = self->fus_q;
+    SfwOrientation *ori = &self->fus_orientation;
+
+    double sp = 2.0 * (q[0] * q[2] - q[3] * q[1]);
+    sp = CLAMP(sp, -1.0, 1.0);
+
+    ori->timestamp = t;
+    ori->w = (float)q[0];
+    ori->x = (float)q[1];
+    ori->y = (float)q[2];
+    ori->z = (float)q[3];
+    ori->roll  = (float)(atan2(2.0 * (q[0] * q[1] + q[2] * q[3]),
+                               1.0 - 2.0 * (q[1] * q[1] + q[2] * q[2])) * 180.0 / M_PI);
+    ori->pitch = (float)(asin(sp) * 180.0 / M_PI);
+    ori->yaw   = (float)(atan2(2.0 * (q[0] * q[3] + q[1] * q[2]),
+                               1.0 - 2.0 * (q[2] * q[2] + q[3] * q[3])) * 180.0 / M_PI);
+
+    if( self->fus_handler )
+        self->fus_handler(self, ori, self->fus_aptr);
+}
+
+static void
+sfwfusion_step(SfwFusion *self, const SfwFusionInput *gyro)
+{
+    double  accel[3];
+    double *a = sfwfusion_accel_at(self, gyro->fi_timestamp, accel) ? accel : NULL;
+
+    double  mag[3];
+    double *m = NULL;
+    if( self->fus_mag_valid &&
+        gyro->fi_timestamp < self->fus_mag.fi_timestamp + SFWFUSION_MAG_AGE_MAX ) {
+        memcpy(mag, self->fus_mag.fi_v, sizeof mag);
+        if( sfwfusion_normalize(mag, 3) )
+            m = mag;
+    }
+
+    if( self->fus_initialized &&
+        (gyro->fi_timestamp <= self->fus_time ||
+         gyro->fi_timestamp - self->fus_time > SFWFUSION_GAP_MAX) ) {
+        sfwlog_debug("gyroscope discontinuity; restarting estimation");
+        self->fus_initialized = false;
+    }
+
+    if( !self->fus_initialized ) {
+        /* Start from absolute orientation if available */
+        if( !a )
+            return;
+        sfwfusion_from_vectors(self->fus_q, a, m);
+        memset(self->fus_integral, 0, sizeof self->fus_integral);
+        self->fus_initialized = true;
+    }
+    else {
+        double dt = (gyro->fi_timestamp - self->fus_time) * 1e-6;
+        switch( self->fus_algorithm ) {
+        case SFW_FUSION_MADGWICK:
+            sfwfusion_update_madgwick(self, gyro->fi_v, a, m, dt);
+            break;
+        case SFW_FUSION_MAHONY:
+            sfwfusion_update_mahony(self, gyro->fi_v, a, m, dt);
+            break;
+        default:
+            sfwfusion_update_complementary(self, gyro->fi_v, a, m, dt);
+            break;
+        }
+    }
+
+    self->fus_time = gyro->fi_timestamp;
+    sfwfusion_publish(self, gyro->fi_timestamp);
+}
+
+/** Process held gyroscope readings that can be aligned
+ */
+static void
+sfwfusion_flush(SfwFusion *self)
+{
+    while( self->fus_gyro_count > 0 ) {
+        const SfwFusionInput *gyro = &self->fus_gyro[self->fus_gyro_head];
+        const SfwFusionInput *last = &self->fus_gyro[(self->fus_gyro_head +
+                                                      self->fus_gyro_count - 1) %
+                                                     SFWFUSION_QUEUE_MAX];
+
+        bool aligned = (self->fus_accel_count > 0 &&
+                        self->fus_accel[1].fi_timestamp >= gyro->fi_timestamp);
+        bool overdue = (self->fus_gyro_count == SFWFUSION_QUEUE_MAX ||
+                        last->fi_timestamp - gyro->fi_timestamp >= SFWFUSION_SKEW_MAX);
+        if( !aligned && !overdue )
+            break;
+
+        SfwFusionInput input = *gyro;
+        self->fus_gyro_head = (self->fus_gyro_head + 1) % SFWFUSION_QUEUE_MAX;
+        self->fus_gyro_count--;
+        sfwfusion_step(self, &input);
+    }
+}
+
+static void
+sfwfusion_reading_cb(SfwSensor *sensor, const SfwReading *reading,
+                     gpointer aptr)
+{
+    (void)sensor;
+    sfwfusion_add(aptr, reading);
+}
+
+/** Create orientation estimator
+ *
+ * Gains are initialized to defaults suitable for the algorithm.
+ */
+SfwFusion *
+sfwfusion_new(SfwFusionAlgorithm algorithm)
+{
+    SfwFusion *self = g_new0(SfwFusion, 1);
+
+    self->fus_algorithm = algorithm;
+    switch( algorithm ) {
+    case SFW_FUSION_MADGWICK:
+        self->fus_gain = 0.1;
+        break;
+    case SFW_FUSION_MAHONY:
+        self->fus_gain = 1.0;
+        break;
+    default:
+        self->fus_algorithm = SFW_FUSION_COMPLEMENTARY;
+        self->fus_gain = 0.5;
+        break;
+    }
+    sfwfusion_reset(self);
+
+    return self;
+}
+
+void
+sfwfusion_delete(SfwFusion *self)
+{
+    if( self ) {
+        sfwfusion_detach(self);
+        g_free(self);
+    }
+}
+
+void
+sfwfusion_delete_at(SfwFusion **pself)
+{
+    sfwfusion_delete(*pself), *pself = NULL;
+}
+
+/** Set correction gains
+ *
+ * @param gain    correction rate for complementary filter, beta for
+ *                Madgwick, or proportional gain for Mahony filter
+ * @param gain_i  integral gain for Mahony filter, otherwise unused
+ */
+void
+sfwfusion_set_gain(SfwFusion *self, double gain, double gain_i)
+{
+    if( self ) {
+        self->fus_gain   = MAX(gain, 0.0);
+        self->fus_gain_i = MAX(gain_i, 0.0);
+    }
+}
+
+void
+sfwfusion_set_handler(SfwFusion *self, SfwFusionHandler handler, gpointer aptr)
+{
+    if( self ) {
+        self->fus_handler = handler;
+        self->fus_aptr    = aptr;
+    }
+}
+
+/** Discard estimation state and held readings
+ */
+void
+sfwfusion_reset(SfwFusion *self)
+{
+    if( self ) {
+        self->fus_initialized = false;
+        self->fus_time        = 0;
+        self->fus_q[0]        = 1.0;
+        self->fus_q[1]        = self->fus_q[2] = self->fus_q[3] = 0.0;
+        self->fus_accel_count = 0;
+        self->fus_mag_valid   = false;
+        self->fus_gyro_head   = 0;
+        self->fus_gyro_count  = 0;
+        memset(self->fus_integral, 0, sizeof self->fus_integral);
+        memset(&self->fus_orientation, 0, sizeof self->fus_orientation);
+        self->fus_orientation.w = 1.0f;
+    }
+}
+
+/** Feed readings from sensor to estimator
+ *
+ * Accelerometer, gyroscope and magnetometer sensors are accepted,
+ * one of each. Attaching another sensor of the same type replaces
+ * the previous one.
+ *
+ * @return true if sensor was attached, false otherwise
+ */
+bool
+sfwfusion_attach(SfwFusion *self, SfwSensor *sensor)
+{
+    bool          ack  = false;
+    SfwFusionRole role = SFWFUSION_ROLE_COUNT;
+
+    if( !self || !sensor )
+        goto EXIT;
+
+    switch( sfwreading_sensor_id(sfwsensor_reading(sensor)) ) {
+    case SFW_SENSOR_ID_ACCELEROMETER:
+        role = SFWFUSION_ROLE_ACCELEROMETER;
+        break;
+    case SFW_SENSOR_ID_GYROSCOPE:
+        role = SFWFUSION_ROLE_GYROSCOPE;
+        break;
+    case SFW_SENSOR_ID_MAGNETOMETER:
+        role = SFWFUSION_ROLE_MAGNETOMETER;
+        break;
+    default:
+        sfwlog_warning("%s: not applicable for fusion", sfwsensor_name(sensor));
+        goto EXIT;
+    }
+
+    if( self->fus_sensor[role] ) {
+        sfwsensor_remove_reading_callback(self->fus_sensor[role],
+                                          self->fus_sensor_id[role]);
+        self->fus_sensor_id[role] = 0;
+        sfwsensor_unref_at(&self->fus_sensor[role]);
+    }
+
+    self->fus_sensor_id[role] =
+        sfwsensor_add_reading_callback(sensor, sfwfusion_reading_cb, self);
+    if( !self->fus_sensor_id[role] )
+        goto EXIT;
+    self->fus_sensor[role] = sfwsensor_ref(sensor);
+    ack = true;
+
+EXIT:
+    return ack;
+}
+
+/** Stop feeding readings from all attached sensors
+ */
+void
+sfwfusion_detach(SfwFusion *self)
+{
+    if( self ) {
+        for( size_t role = 0; role < SFWFUSION_ROLE_COUNT; ++role ) {
+            if( !self->fus_sensor[role] )
+                continue;
+            sfwsensor_remove_reading_callback(self->fus_sensor[role],
+                                              self->fus_sensor_id[role]);
+            self->fus_sensor_id[role] = 0;
+            sfwsensor_unref_at(&self->fus_sensor[role]);
+        }
+    }
+}
+
+/** Feed one reading to estimator
+ *
+ * Can be used instead of sfwfusion_attach(), e.g. with readings from
+ * replayed recordings.
+ */
+void
+sfwfusion_add(SfwFusion *self, const SfwReading *reading)
+{
+    if( !self || !reading )
+        goto EXIT;
+
+    const SfwSample *sample = &reading->sample;
+    SfwFusionInput   input  = { .fi_timestamp = sample->timestamp };
+
+    switch( reading->sensor_id ) {
+    case SFW_SENSOR_ID_ACCELEROMETER:
+        input.fi_v[0] = sample->xyz.x;
+        input.fi_v[1] = sample->xyz.y;
+        input.fi_v[2] = sample->xyz.z;
+        /* Time going backwards invalidates interpolation history */
+        if( self->fus_accel_count > 0 &&
+            input.fi_timestamp < self->fus_accel[1].fi_timestamp )
+            self->fus_accel_count = 0;
+        if( self->fus_accel_count > 0 &&
+            input.fi_timestamp > self->fus_accel[1].fi_timestamp )
+            self->fus_accel[0] = self->fus_accel[1], self->fus_accel_count = 2;
+        else if( self->fus_accel_count == 0 )
+            self->fus_accel[0] = input, self->fus_accel_count = 1;
+        self->fus_accel[1] = input;
+        break;
+
+    case SFW_SENSOR_ID_GYROSCOPE:
+        /* Normalized gyroscope data is in degrees per second */
+        input.fi_v[0] = sample->xyz.x * (M_PI / 180.0);
+        input.fi_v[1] = sample->xyz.y * (M_PI / 180.0);
+        input.fi_v[2] = sample->xyz.z * (M_PI / 180.0);
+        if( self->fus_gyro_count == SFWFUSION_QUEUE_MAX )
+            sfwfusion_flush(self);
+        self->fus_gyro[(self->fus_gyro_head + self->fus_gyro_count++) %
+                       SFWFUSION_QUEUE_MAX] = input;
+        break;
+
+    case SFW_SENSOR_ID_MAGNETOMETER:
+        input.fi_v[0] = sample->magnetometer.x;
+        input.fi_v[1] = sample->magnetometer.y;
+        input.fi_v[2] = sample->magnetometer.z;
+        self->fus_mag       = input;
+        self->fus_mag_valid = true;
+        break;
+
+    default:
+        goto EXIT;
+    }
+
+    sfwfusion_flush(self);
+
+EXIT:
+    return;
+}
+
+/** Get the latest orientation estimate
+ */
+const SfwOrientation *
+sfwfusion_orientation(const SfwFusion *self)
+{
+    return self ? &self->fus_orientation : NULL;
+}
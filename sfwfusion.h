@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef SFWFUSION_H_
+# define SFWFUSION_H_
+
+# include "sfwsensor.h"
+
+G_BEGIN_DECLS
+
+# pragma GCC visibility push(default)
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+/** Orientation estimation algorithms
+ */
+typedef enum SfwFusionAlgorithm
+{
+    /** Gyroscope integration with proportional tilt and heading
+     *  correction; gain is the correction rate [1/s] */
+    SFW_FUSION_COMPLEMENTARY,
+
+    /** Madgwick gradient descent filter; gain is beta [rad/s] */
+    SFW_FUSION_MADGWICK,
+
+    /** Mahony nonlinear complementary filter; gains are Kp and Ki */
+    SFW_FUSION_MAHONY,
+} SfwFusionAlgorithm;
+
+/** Estimated device orientation
+ *
+ * The quaternion rotates vectors from device frame to earth frame,
+ * where z points up and x towards magnetic north, or towards the
+ * initial heading when magnetometer is not used.
+ */
+typedef struct SfwOrientation
+{
+    /** Timestamp of the gyroscope sample, microseconds, monotonic */
+    uint64_t timestamp;
+
+    /** Unit quaternion, scalar part first */
+    float    w, x, y, z;
+
+    /** Euler angles in degrees, yaw-pitch-roll (ZYX) order */
+    float    roll, pitch, yaw;
+} SfwOrientation;
+
+/** Local orientation estimation from accelerometer, gyroscope
+ *  and optionally magnetometer readings
+ *
+ * Gyroscope readings drive the estimation. Each is held until an
+ * accelerometer reading at the same time or later is available,
+ * and accelerometer data is interpolated to the gyroscope timestamp.
+ * Held readings are processed with the latest accelerometer data if
+ * accelerometer lags too much behind.
+ */
+typedef struct SfwFusion SfwFusion;
+
+/** Callback for receiving orientation updates
+ */
+typedef void (*SfwFusionHandler)(SfwFusion *fusion, const SfwOrientation *orientation, gpointer aptr);
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWFUSION
+ * ------------------------------------------------------------------------- */
+
+SfwFusion            *sfwfusion_new        (SfwFusionAlgorithm algorithm);
+void                  sfwfusion_delete     (SfwFusion *self);
+void                  sfwfusion_delete_at  (SfwFusion **pself);
+void                  sfwfusion_set_gain   (SfwFusion *self, double gain, double gain_i);
+void                  sfwfusion_set_handler(SfwFusion *self, SfwFusionHandler handler, gpointer aptr);
+void                  sfwfusion_reset      (SfwFusion *self);
+bool                  sfwfusion_attach     (SfwFusion *self, SfwSensor *sensor);
+void                  sfwfusion_detach     (SfwFusion *self);
+void                  sfwfusion_add        (SfwFusion *self, const SfwReading *reading);
+const SfwOrientation *sfwfusion_orientation(const SfwFusion *self);
+
+# pragma GCC visibility pop
+
+G_END_DECLS
+
+#endif /* SFWFUSION_H_ */
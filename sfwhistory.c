@@ -0,0 +1,289 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "sfwhistory.h"
+
+#include <string.h>
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+struct SfwHistory
+{
+    /** Ring buffer of samples */
+    SfwSample *hst_samples;
+
+    /** Number of slots in hst_samples */
+    size_t     hst_capacity;
+
+    /** Slot of the oldest stored sample */
+    size_t     hst_head;
+
+    /** Number of stored samples */
+    size_t     hst_count;
+};
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWHISTORY
+ * ------------------------------------------------------------------------- */
+
+static inline const SfwSample *sfwhistory_at         (const SfwHistory *self, size_t i);
+static size_t                  sfwhistory_lower_bound(const SfwHistory *self, uint64_t t);
+static size_t                  sfwhistory_range      (const SfwHistory *self, uint64_t t_begin, uint64_t t_end, size_t max, size_t *pslot);
+SfwHistory                    *sfwhistory_open       (size_t capacity);
+void                           sfwhistory_close      (SfwHistory *self);
+void                           sfwhistory_close_at   (SfwHistory **pself);
+void                           sfwhistory_clear      (SfwHistory *self);
+void                           sfwhistory_add        (SfwHistory *self, const SfwSample *sample);
+size_t                         sfwhistory_count      (const SfwHistory *self);
+size_t                         sfwhistory_capacity   (const SfwHistory *self);
+size_t                         sfwhistory_query      (const SfwHistory *self, uint64_t t_begin, uint64_t t_end, SfwSample *out, size_t max);
+size_t                         sfwhistory_query_xyz  (const SfwHistory *self, uint64_t t_begin, uint64_t t_end, uint64_t *t, float *x, float *y, float *z, size_t max);
+bool                           sfwhistory_nearest    (const SfwHistory *self, uint64_t t, SfwSample *out);
+
+/* ========================================================================= *
+ * SFWHISTORY
+ * ========================================================================= */
+
+/** Access i'th sample, counting from the oldest one
+ */
+static inline const SfwSample *
+sfwhistory_at(const SfwHistory *self, size_t i)
+{
+    i += self->hst_head;
+    if( i >= self->hst_capacity )
+        i -= self->hst_capacity;
+    return &self->hst_samples[i];
+}
+
+/** Locate the first sample with timestamp >= t
+ *
+ * @return sample index, or count if there are no such samples
+ */
+static size_t
+sfwhistory_lower_bound(const SfwHistory *self, uint64_t t)
+{
+    size_t lo = 0;
+    size_t hi = self->hst_count;
+    while( lo < hi ) {
+        size_t mid = lo + (hi - lo) / 2;
+        if( sfwhistory_at(self, mid)->timestamp < t )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/** Locate samples with t_begin <= timestamp <= t_end
+ *
+ * @param pslot  where to store ring buffer slot of the first sample
+ *
+ * @return number of matching samples, at most max
+ */
+static size_t
+sfwhistory_range(const SfwHistory *self, uint64_t t_begin, uint64_t t_end,
+                 size_t max, size_t *pslot)
+{
+    if( !self || t_begin > t_end )
+        return 0;
+
+    size_t beg = sfwhistory_lower_bound(self, t_begin);
+    size_t end = (t_end == UINT64_MAX) ? self->hst_count :
+        sfwhistory_lower_bound(self, t_end + 1);
+
+    size_t slot = self->hst_head + beg;
+    if( slot >= self->hst_capacity )
+        slot -= self->hst_capacity;
+    *pslot = slot;
+
+    return MIN(end - beg, max);
+}
+
+SfwHistory *
+sfwhistory_open(size_t capacity)
+{
+    SfwHistory *self = NULL;
+    if( capacity > 0 ) {
+        self = g_new0(SfwHistory, 1);
+        self->hst_samples  = g_new(SfwSample, capacity);
+        self->hst_capacity = capacity;
+        self->hst_head     = 0;
+        self->hst_count    = 0;
+    }
+    return self;
+}
+
+void
+sfwhistory_close(SfwHistory *self)
+{
+    if( self ) {
+        g_free(self->hst_samples);
+        g_free(self);
+    }
+}
+
+void
+sfwhistory_close_at(SfwHistory **pself)
+{
+    sfwhistory_close(*pself), *pself = NULL;
+}
+
+void
+sfwhistory_clear(SfwHistory *self)
+{
+    if( self )
+        self->hst_head = self->hst_count = 0;
+}
+
+void
+sfwhistory_add(SfwHistory *self, const SfwSample *sample)
+{
+    if( !self )
+        goto EXIT;
+
+    /* Binary search requires monotonic timestamps */
+    if( self->hst_count > 0 &&
+        sfwhistory_at(self, self->hst_count - 1)->timestamp > sample->timestamp )
+        sfwhistory_clear(self);
+
+    if( self->hst_count < self->hst_capacity ) {
+        size_t slot = self->hst_head + self->hst_count++;
+        if( slot >= self->hst_capacity )
+            slot -= self->hst_capacity;
+        self->hst_samples[slot] = *sample;
+    }
+    else {
+        self->hst_samples[self->hst_head] = *sample;
+        if( ++self->hst_head == self->hst_capacity )
+            self->hst_head = 0;
+    }
+
+EXIT:
+    return;
+}
+
+size_t
+sfwhistory_count(const SfwHistory *self)
+{
+    return self ? self->hst_count : 0;
+}
+
+size_t
+sfwhistory_capacity(const SfwHistory *self)
+{
+    return self ? self->hst_capacity : 0;
+}
+
+/** Copy samples with t_begin <= timestamp <= t_end
+ *
+ * Samples are stored in oldest-first order. If there are more than max
+ * matching samples, the oldest ones are returned.
+ *
+ * @return number of samples stored to out
+ */
+size_t
+sfwhistory_query(const SfwHistory *self, uint64_t t_begin, uint64_t t_end,
+                 SfwSample *out, size_t max)
+{
+    size_t slot = 0;
+    size_t cnt  = sfwhistory_range(self, t_begin, t_end, max, &slot);
+
+    if( cnt > 0 ) {
+        /* Copy in at most two contiguous chunks */
+        size_t now = MIN(cnt, self->hst_capacity - slot);
+        memcpy(out, self->hst_samples + slot, now * sizeof *out);
+        memcpy(out + now, self->hst_samples, (cnt - now) * sizeof *out);
+    }
+    return cnt;
+}
+
+/** Copy xyz samples with t_begin <= timestamp <= t_end as separate arrays
+ *
+ * Like sfwhistory_query(), but stores timestamps and channel values
+ * into separate caller provided arrays, see sfwsample_xyz_to_soa().
+ * The history must be holding samples from a xyz sensor.
+ *
+ * @return number of samples stored to output arrays
+ */
+size_t
+sfwhistory_query_xyz(const SfwHistory *self, uint64_t t_begin, uint64_t t_end,
+                     uint64_t *t, float *x, float *y, float *z, size_t max)
+{
+    size_t slot = 0;
+    size_t cnt  = sfwhistory_range(self, t_begin, t_end, max, &slot);
+
+    if( cnt > 0 ) {
+        size_t now = MIN(cnt, self->hst_capacity - slot);
+        sfwsample_xyz_to_soa(self->hst_samples + slot, now, t, x, y, z);
+        if( cnt > now )
+            sfwsample_xyz_to_soa(self->hst_samples, cnt - now,
+                                 t ? t + now : NULL, x ? x + now : NULL,
+                                 y ? y + now : NULL, z ? z + now : NULL);
+    }
+    return cnt;
+}
+
+/** Copy sample that has timestamp closest to t
+ *
+ * If two samples are equally close, the older one is chosen.
+ *
+ * @return true if sample was stored to out, false if history is empty
+ */
+bool
+sfwhistory_nearest(const SfwHistory *self, uint64_t t, SfwSample *out)
+{
+    if( !self || self->hst_count < 1 )
+        return false;
+
+    size_t i = sfwhistory_lower_bound(self, t);
+    if( i == self->hst_count )
+        --i;
+    else if( i > 0 ) {
+        uint64_t after  = sfwhistory_at(self, i)->timestamp - t;
+        uint64_t before = t - sfwhistory_at(self, i - 1)->timestamp;
+        if( before <= after )
+            --i;
+    }
+    *out = *sfwhistory_at(self, i);
+    return true;
+}
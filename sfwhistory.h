@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef SFWHISTORY_H_
+# define SFWHISTORY_H_
+
+# include "sfwtypes.h"
+
+G_BEGIN_DECLS
+
+# pragma GCC visibility push(default)
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+/** Bounded, time ordered sample history
+ *
+ * Holds the most recent samples in a ring buffer. Samples are expected
+ * to arrive in timestamp order; if time goes backwards (e.g. when a
+ * replay is rewound) previously stored samples are discarded.
+ */
+typedef struct SfwHistory SfwHistory;
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWHISTORY
+ * ------------------------------------------------------------------------- */
+
+SfwHistory *sfwhistory_open     (size_t capacity);
+void        sfwhistory_close    (SfwHistory *self);
+void        sfwhistory_close_at (SfwHistory **pself);
+void        sfwhistory_clear    (SfwHistory *self);
+void        sfwhistory_add      (SfwHistory *self, const SfwSample *sample);
+size_t      sfwhistory_count    (const SfwHistory *self);
+size_t      sfwhistory_capacity (const SfwHistory *self);
+size_t      sfwhistory_query    (const SfwHistory *self, uint64_t t_begin, uint64_t t_end, SfwSample *out, size_t max);
+size_t      sfwhistory_query_xyz(const SfwHistory *self, uint64_t t_begin, uint64_t t_end, uint64_t *t, float *x, float *y, float *z, size_t max);
+bool        sfwhistory_nearest  (const SfwHistory *self, uint64_t t, SfwSample *out);
+
+# pragma GCC visibility pop
+
+G_END_DECLS
+
+#endif /* SFWHISTORY_H_ */
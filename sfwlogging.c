@@ -41,6 +41,46 @@
 #include <inttypes.h>
 #include <fnmatch.h>
 
+#include <glib-unix.h>
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Maximum length of formatted message text */
+#define SFWLOG_MESSAGE_MAX 512
+
+/** Number of message slots in asynchronous queue, power of two */
+#define SFWLOG_QUEUE_SIZE 256
+
+/** Size of output batch buffer used by writer thread */
+#define SFWLOG_BATCH_SIZE (16 * 1024)
+
+/** Maximum time writer thread sleeps without being woken up [us] */
+#define SFWLOG_WRITER_IDLE_MAX (100 * 1000)
+
+/** Space for captured arguments in a flight recorder record */
+#define SFWLOG_RECORD_ARGS_MAX 80
+
+/** Highest level subject to rate limiting and repeat folding */
+#define SFWLOG_LIMIT_MAXLEV SFWLOG_INFO
+
+/** Default number of messages a call site can emit in a burst */
+#define SFWLOG_LIMIT_BURST 10
+
+/** Default time it takes to earn one more message [ms] */
+#define SFWLOG_LIMIT_INTERVAL 1000
+
+/** Interval for reporting folded repeats of the same message [ms] */
+#define SFWLOG_REPEAT_INTERVAL (30 * 1000)
+
+/** Time without repeats after which folded repeats are reported
+ *  when any call site emits a message [ms] */
+#define SFWLOG_REPEAT_QUIET (5 * 1000)
+
+/** Maximum number of call sites flushed per emitted message */
+#define SFWLOG_REPEAT_FLUSH_MAX 8
+
 /* ========================================================================= *
  * Types
  * ========================================================================= */
@@ -51,6 +91,76 @@ enum {
     EMIT_DISABLED,
 };
 
+/** Preformatted message waiting in asynchronous queue
+ *
+ * File and function names are string literals from the call site
+ * and can be referred to without copying.
+ */
+typedef struct SfwLogMessage
+{
+    uint64_t    msg_sequence;
+    uint64_t    msg_tick;
+    const char *msg_file;
+    const char *msg_func;
+    int         msg_line;
+    int         msg_level;
+    char        msg_text[SFWLOG_MESSAGE_MAX];
+} SfwLogMessage;
+
+/** Flight recorder entry
+ *
+ * Holds format string and raw argument values, formatting is
+ * done only when the recorder contents are dumped.
+ */
+typedef struct SfwLogRecord
+{
+    uint64_t    rec_sequence;
+    uint64_t    rec_tick;
+    const char *rec_file;
+    const char *rec_func;
+    const char *rec_fmt;
+    int32_t     rec_line;
+    uint8_t     rec_level;
+    uint8_t     rec_truncated;
+    uint16_t    rec_used;
+    uint8_t     rec_args[SFWLOG_RECORD_ARGS_MAX];
+} SfwLogRecord;
+
+/** Flight recorder ring, published as a whole
+ */
+typedef struct SfwLogFlightRing
+{
+    size_t       fr_size;
+    SfwLogRecord fr_records[];
+} SfwLogFlightRing;
+
+/** Argument types of printf conversions */
+typedef enum SfwLogArg
+{
+    SFWLOG_ARG_NONE,
+    SFWLOG_ARG_INT,
+    SFWLOG_ARG_UINT,
+    SFWLOG_ARG_DOUBLE,
+    SFWLOG_ARG_STRING,
+    SFWLOG_ARG_POINTER,
+    SFWLOG_ARG_SKIP,
+    SFWLOG_ARG_ERRNO,
+    SFWLOG_ARG_INVALID,
+} SfwLogArg;
+
+/** Parsed printf conversion specification */
+typedef struct SfwLogSpec
+{
+    char      spec_flags[8];
+    char      spec_width[8];
+    char      spec_precision[8];
+    bool      spec_width_arg;
+    bool      spec_precision_arg;
+    char      spec_length[3];
+    char      spec_conversion;
+    SfwLogArg spec_arg;
+} SfwLogSpec;
+
 /* ========================================================================= *
  * Prototypes
  * ========================================================================= */
@@ -60,7 +170,8 @@ enum {
  * ------------------------------------------------------------------------- */
 
 static uint64_t    sfwlog_tick            (void);
-static char       *sfwlog_timestamp       (char *buff, size_t size);
+static char       *sfwlog_timestamp       (char *buff, size_t size, uint64_t t);
+static int         sfwlog_format_line     (char *buff, size_t size, const char *file, int line, const char *func, int level, uint64_t tick, const char *msg);
 static size_t      sfwlog_common_chars    (const char *s1, const char *s2);
 static int         sfwlog_normalize_level (int level);
 static int         sfwlog_syslog_level    (int level);
@@ -81,8 +192,53 @@ void               sfwlog_remove_pattern  (const char *pattern);
 void               sfwlog_clear_patterns  (void);
 int                sfwlog_level_from_name (const char *name);
 const char        *sfwlog_level_name      (int level);
+static bool        sfwlog_p_unlocked      (const char *file, const char *func, int level);
 bool               sfwlog_p_              (const char *file, const char *func, int level);
+static void        sfwlog_output          (const char *file, int line, const char *func, int level, uint64_t tick, const char *msg);
+static void        sfwlog_emit_va         (SfwLoggingState *state, const char *file, int line, const char *func, int level, const char *fmt, va_list va);
 void               sfwlog_emit_           (const char *file, int line, const char *func, int level, const char *fmt, ...) __attribute__((format(printf, 5, 6)));
+void               sfwlog_emit_at_        (SfwLoggingState *state, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+/* ------------------------------------------------------------------------- *
+ * LOGGING_ASYNC
+ * ------------------------------------------------------------------------- */
+
+static bool     sfwlog_async_push  (const char *file, int line, const char *func, int level, uint64_t tick, const char *msg);
+static bool     sfwlog_async_pop   (SfwLogMessage *msg);
+static void     sfwlog_async_write (const SfwLogMessage *msg, char *batch, size_t *used);
+static size_t   sfwlog_async_drain (void);
+static gpointer sfwlog_async_thread(gpointer aptr);
+bool            sfwlog_get_async   (void);
+void            sfwlog_set_async   (bool enabled);
+
+/* ------------------------------------------------------------------------- *
+ * LOGGING_FLIGHT_RECORDER
+ * ------------------------------------------------------------------------- */
+
+static const char *sfwlog_parse_spec         (const char *pos, SfwLogSpec *spec);
+static bool        sfwlog_record_put         (SfwLogRecord *rec, const void *data, size_t size);
+static bool        sfwlog_record_get         (const SfwLogRecord *rec, size_t *pos, void *data, size_t size);
+static void        sfwlog_record_capture     (SfwLogRecord *rec, int saved_errno, va_list va);
+static size_t      sfwlog_record_format      (const SfwLogRecord *rec, char *buff, size_t size);
+static void        sfwlog_record_output      (const char *file, int line, const char *func, int level, uint64_t tick, const char *text);
+static SfwLogFlightRing *sfwlog_flight_acquire(unsigned *epoch);
+static void        sfwlog_flight_release     (unsigned epoch);
+static void        sfwlog_record_va          (const char *file, int line, const char *func, int level, int saved_errno, const char *fmt, va_list va);
+void               sfwlog_record_            (const SfwLoggingState *state, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+void               sfwlog_set_flight_recorder (size_t records);
+size_t             sfwlog_flight_recorder_size(void);
+void               sfwlog_dump_flight_recorder(void);
+static gboolean    sfwlog_dump_on_signal_cb  (gpointer aptr);
+guint              sfwlog_dump_on_signal     (int signo);
+
+/* ------------------------------------------------------------------------- *
+ * LOGGING_LIMIT
+ * ------------------------------------------------------------------------- */
+
+static uint32_t sfwlog_limit_hash (const char *msg);
+static bool     sfwlog_limit_check(SfwLoggingState *state, uint64_t tick, const char *msg, char *note, size_t size);
+static void     sfwlog_limit_flush(uint64_t tick);
+void            sfwlog_set_rate_limit(unsigned burst, unsigned interval_ms);
 
 /* ------------------------------------------------------------------------- *
  * LOGGING_STATE
@@ -98,7 +254,46 @@ static int         sfwlog_target       = SFWLOG_TO_STDERR;
 static int         sfwlog_level        = SFWLOG_DEFLEV;
 static GHashTable *sfwlog_pattern_hash = NULL;
 static GSList     *sfwlog_pattern_list = NULL;
-static int         sfwlog_generation   = 1;
+int                sfwlog_generation_  = 1;
+
+/* Protects verbosity, patterns and the pattern match cache, and
+ * serializes evaluation of SfwLoggingState instances */
+static GMutex      sfwlog_pattern_mutex;
+
+/** Per-thread buffer for formatting message text */
+static __thread char sfwlog_buffer[SFWLOG_MESSAGE_MAX];
+
+/* Asynchronous queue, see sfwlog_set_async(). The slot array is
+ * allocated once and retained, so that producers racing with
+ * disabling never touch released memory. */
+static bool           sfwlog_async_enabled  = false;
+static SfwLogMessage *sfwlog_queue          = NULL;
+static uint64_t       sfwlog_queue_head     = 0;
+static uint64_t       sfwlog_queue_tail     = 0;
+static uint64_t       sfwlog_queue_dropped  = 0;
+static GThread       *sfwlog_writer         = NULL;
+static GMutex         sfwlog_writer_mutex;
+static GCond          sfwlog_writer_cond;
+static bool           sfwlog_writer_idle    = false;
+static bool           sfwlog_writer_stop    = false;
+
+/* Flight recorder ring, see sfwlog_set_flight_recorder(). Threads
+ * using the ring are counted per epoch parity, so that a replaced
+ * ring can be freed once users from the previous epoch are gone. */
+static SfwLogFlightRing *sfwlog_flight_ring  = NULL;
+static unsigned       sfwlog_flight_epoch   = 0;
+static unsigned       sfwlog_flight_users[2];
+static GMutex         sfwlog_flight_mutex;
+static uint64_t       sfwlog_flight_next    = 0;
+static uint64_t       sfwlog_flight_dumped  = 0;
+
+/* Per call site rate limiting, see sfwlog_set_rate_limit() */
+static unsigned       sfwlog_limit_burst    = SFWLOG_LIMIT_BURST;
+static unsigned       sfwlog_limit_interval = SFWLOG_LIMIT_INTERVAL;
+static GMutex         sfwlog_limit_mutex;
+
+/* Call sites with folded repeats not yet reported */
+static SfwLoggingState *sfwlog_repeat_pending = NULL;
 
 static const struct {
     const char *name;
@@ -133,21 +328,49 @@ sfwlog_tick(void)
         t1 += ts.tv_nsec / 1000000;
     }
 
-    if( t0 == 0 )
-        t0 = t1;
+    /* Origin is set by whichever thread gets here first */
+    int64_t origin = __atomic_load_n(&t0, __ATOMIC_ACQUIRE);
+    if( origin == 0 ) {
+        if( !__atomic_compare_exchange_n(&t0, &origin, t1, false,
+                                         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) )
+            t1 = t1 < origin ? origin : t1;
+        else
+            origin = t1;
+    }
 
-    return (uint64_t)(t1 - t0);
+    return (uint64_t)(t1 - origin);
 }
 
 static char *
-sfwlog_timestamp(char *buff, size_t size)
+sfwlog_timestamp(char *buff, size_t size, uint64_t t)
 {
-    uint64_t t  = sfwlog_tick();
     unsigned ms = (unsigned)(t % 1000); t /= 1000;
     snprintf(buff, size, "%04" PRIu64 ".%03u", t, ms);
     return buff;
 }
 
+/** Format stderr log line
+ *
+ * @return length of line, as with snprintf()
+ */
+static int
+sfwlog_format_line(char *buff, size_t size, const char *file, int line,
+                   const char *func, int level, uint64_t tick,
+                   const char *msg)
+{
+    char  timestamp[32];
+    char  context[128];
+
+    sfwlog_timestamp(timestamp, sizeof timestamp, tick);
+    snprintf(context, sizeof context, "%s:%d:", file, line);
+    return snprintf(buff, size, "%-21s %s %s: %s%s\n",
+                    context,
+                    timestamp,
+                    func,
+                    sfwlog_level_tag(level),
+                    msg);
+}
+
 static size_t sfwlog_common_chars(const char *s1, const char *s2)
 {
     size_t n = 0;
@@ -279,10 +502,14 @@ sfwlog_store_to_hash(const gchar *key, gint emit)
                          GINT_TO_POINTER(emit));
 }
 
+/** Invalidate cached call site states
+ *
+ * Caller must hold sfwlog_pattern_mutex.
+ */
 static void sfwlog_generation_bump(void)
 {
     /* Invalidate all cached SfwLoggingState instances */
-    ++sfwlog_generation;
+    __atomic_add_fetch(&sfwlog_generation_, 1, __ATOMIC_RELEASE);
 
     /* Flush pattern match cache */
     if( sfwlog_pattern_hash ) {
@@ -301,10 +528,12 @@ void
 sfwlog_set_verbosity(int level)
 {
     level = sfwlog_normalize_level(level);
+    g_mutex_lock(&sfwlog_pattern_mutex);
     if( sfwlog_level != level ) {
         sfwlog_level = level;
         sfwlog_generation_bump();
     }
+    g_mutex_unlock(&sfwlog_pattern_mutex);
 }
 
 void
@@ -326,31 +555,37 @@ sfwlog_set_target(int target)
 void
 sfwlog_add_pattern(const char *pattern)
 {
+    g_mutex_lock(&sfwlog_pattern_mutex);
     if( pattern && !sfwlog_lookup_pattern(pattern) ) {
         sfwlog_pattern_list = g_slist_prepend(sfwlog_pattern_list,
                                               g_strdup(pattern));
         sfwlog_generation_bump();
     }
+    g_mutex_unlock(&sfwlog_pattern_mutex);
 }
 
 void
 sfwlog_remove_pattern(const char *pattern)
 {
+    g_mutex_lock(&sfwlog_pattern_mutex);
     gchar *cached = sfwlog_lookup_pattern(pattern);
     if( cached ) {
         sfwlog_pattern_list = g_slist_remove(sfwlog_pattern_list, cached);
         g_free(cached);
         sfwlog_generation_bump();
     }
+    g_mutex_unlock(&sfwlog_pattern_mutex);
 }
 
 void
 sfwlog_clear_patterns(void)
 {
+    g_mutex_lock(&sfwlog_pattern_mutex);
     if( sfwlog_pattern_list ) {
         g_slist_free_full(g_steal_pointer(&sfwlog_pattern_list), g_free);
         sfwlog_generation_bump();
     }
+    g_mutex_unlock(&sfwlog_pattern_mutex);
 }
 
 int
@@ -383,11 +618,13 @@ sfwlog_level_name(int level)
     return name;
 }
 
-bool
-sfwlog_p_(const char *file, const char *func, int level)
+/** Check whether call site is enabled
+ *
+ * Caller must hold sfwlog_pattern_mutex.
+ */
+static bool
+sfwlog_p_unlocked(const char *file, const char *func, int level)
 {
-    /* Logging must not change errno */
-    int  saved = errno;
     gint state = EMIT_DISABLED;
     if( level <= sfwlog_level ) {
         state = EMIT_ENABLED;
@@ -403,50 +640,1087 @@ sfwlog_p_(const char *file, const char *func, int level)
         }
         g_free(key);
     }
-    errno = saved;
     return state == EMIT_ENABLED;
 }
 
+bool
+sfwlog_p_(const char *file, const char *func, int level)
+{
+    /* Logging must not change errno */
+    int saved = errno;
+    g_mutex_lock(&sfwlog_pattern_mutex);
+    bool enabled = sfwlog_p_unlocked(file, func, level);
+    g_mutex_unlock(&sfwlog_pattern_mutex);
+    errno = saved;
+    return enabled;
+}
+
+/** Write formatted message to log target
+ */
+static void
+sfwlog_output(const char *file, int line, const char *func, int level,
+              uint64_t tick, const char *msg)
+{
+    if( sfwlog_async_push(file, line, func, level, tick, msg) )
+        return;
+
+    switch( sfwlog_target ) {
+    default:
+    case SFWLOG_TO_STDERR:
+        {
+            /* Lines that do not fit the stack buffer are rare enough
+             * to be formatted twice */
+            char  buff[SFWLOG_MESSAGE_MAX + 256];
+            char *text = buff;
+            int   size = sfwlog_format_line(buff, sizeof buff, file, line,
+                                            func, level, tick, msg);
+            if( size >= (int)sizeof buff && (text = malloc(size + 1)) )
+                sfwlog_format_line(text, size + 1, file, line,
+                                   func, level, tick, msg);
+            fputs(text ?: buff, stderr);
+            fflush(stderr);
+            if( text != buff )
+                free(text);
+        }
+        break;
+    case SFWLOG_TO_SYSLOG:
+        syslog(sfwlog_syslog_level(level), "%s", msg);
+        break;
+    }
+}
+
+static void
+sfwlog_emit_va(SfwLoggingState *state, const char *file, int line,
+               const char *func, int level, const char *fmt, va_list va)
+{
+    /* Logging must not change errno */
+    int      saved = errno;
+    uint64_t tick  = sfwlog_tick();
+    char    *msg   = sfwlog_buffer;
+    char    *tmp   = NULL;
+    char     note[128];
+    va_list  va2;
+
+    /* Format to per-thread buffer; only messages that do not fit
+     * in it are allocated, and only when logging synchronously */
+    va_copy(va2, va);
+    int len = vsnprintf(sfwlog_buffer, sizeof sfwlog_buffer, fmt, va2);
+    va_end(va2);
+    if( len < 0 ) {
+        msg = (char *)fmt;
+    }
+    else if( (size_t)len >= sizeof sfwlog_buffer && !sfwlog_get_async() ) {
+        va_copy(va2, va);
+        if( vasprintf(&tmp, fmt, va2) != -1 )
+            msg = tmp;
+        va_end(va2);
+    }
+    if( msg != fmt )
+        sfwlog_strip(msg);
+
+    /* Flight recorder gets everything, limiting applies to output */
+    if( __atomic_load_n(&sfwlog_flight_ring, __ATOMIC_ACQUIRE) ) {
+        va_copy(va2, va);
+        sfwlog_record_va(file, line, func, level, saved, fmt, va2);
+        va_end(va2);
+    }
+
+    if( state && !sfwlog_limit_check(state, tick, msg, note, sizeof note) ) {
+        if( *note )
+            sfwlog_output(file, line, func, level, tick, note);
+        goto EXIT;
+    }
+    if( state && *note )
+        sfwlog_output(file, line, func, level, tick, note);
+
+    sfwlog_output(file, line, func, level, tick, msg);
+
+EXIT:
+    sfwlog_limit_flush(tick);
+    free(tmp);
+    errno = saved;
+}
+
+/** Emit message without call site state
+ *
+ * Not subject to rate limiting or repeat folding.
+ */
 void
 sfwlog_emit_(const char *file, int line, const char *func, int level,
              const char *fmt, ...)
 {
-    /* Logging must not change errno */
-    int saved = errno;
-    char *msg = NULL;
     va_list va;
     va_start(va, fmt);
-    if( vasprintf(&msg, fmt, va) == -1 )
-        msg = NULL;
-    else
-        sfwlog_strip(msg);
+    sfwlog_emit_va(NULL, file, line, func, level, fmt, va);
     va_end(va);
+}
 
-    char  timestamp[32];
-    char  context[128];
+/** Emit message from sfwlog_emit() call site
+ */
+void
+sfwlog_emit_at_(SfwLoggingState *state, const char *fmt, ...)
+{
+    va_list va;
+    va_start(va, fmt);
+    sfwlog_emit_va(state, state->file, state->line, state->func,
+                   state->level, fmt, va);
+    va_end(va);
+}
 
-    switch( sfwlog_target ) {
-    default:
-    case SFWLOG_TO_STDERR:
-        sfwlog_timestamp(timestamp, sizeof timestamp);
-        snprintf(context, sizeof context, "%s:%d:", file, line);
-        fprintf(stderr, "%-21s %s %s: %s%s\n",
-                context,
-                timestamp,
-                func,
-                sfwlog_level_tag(level),
-                msg ?: fmt);
+/* ========================================================================= *
+ * LOGGING_ASYNC
+ * ========================================================================= */
+
+/** Enqueue message for writer thread
+ *
+ * Bounded lock-free multi-producer / single-consumer queue: producers
+ * claim slots by advancing tail, and each slot carries a sequence
+ * number telling whether it is free, or filled and ready to be read.
+ *
+ * @return true if message was queued or dropped, false if
+ *         asynchronous logging is not enabled
+ */
+static bool
+sfwlog_async_push(const char *file, int line, const char *func, int level,
+                  uint64_t tick, const char *msg)
+{
+    if( !__atomic_load_n(&sfwlog_async_enabled, __ATOMIC_ACQUIRE) )
+        return false;
+
+    SfwLogMessage *queue = sfwlog_queue;
+    SfwLogMessage *slot = NULL;
+    uint64_t       pos  = __atomic_load_n(&sfwlog_queue_tail, __ATOMIC_RELAXED);
+    for( ;; ) {
+        slot = &queue[pos & (SFWLOG_QUEUE_SIZE - 1)];
+        uint64_t seq = __atomic_load_n(&slot->msg_sequence, __ATOMIC_ACQUIRE);
+        int64_t  dif = (int64_t)(seq - pos);
+        if( dif == 0 ) {
+            if( __atomic_compare_exchange_n(&sfwlog_queue_tail, &pos, pos + 1,
+                                            true, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED) )
+                break;
+        }
+        else if( dif < 0 ) {
+            /* Queue full: never block the caller */
+            __atomic_add_fetch(&sfwlog_queue_dropped, 1, __ATOMIC_RELAXED);
+            return true;
+        }
+        else {
+            pos = __atomic_load_n(&sfwlog_queue_tail, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot->msg_tick  = tick;
+    slot->msg_file  = file;
+    slot->msg_func  = func;
+    slot->msg_line  = line;
+    slot->msg_level = level;
+    snprintf(slot->msg_text, sizeof slot->msg_text, "%s", msg);
+    __atomic_store_n(&slot->msg_sequence, pos + 1, __ATOMIC_RELEASE);
+
+    /* Wake up writer only if it has gone idle */
+    if( __atomic_exchange_n(&sfwlog_writer_idle, false, __ATOMIC_SEQ_CST) ) {
+        g_mutex_lock(&sfwlog_writer_mutex);
+        g_cond_signal(&sfwlog_writer_cond);
+        g_mutex_unlock(&sfwlog_writer_mutex);
+    }
+    return true;
+}
+
+/** Dequeue message; called from writer thread, or after joining it
+ */
+static bool
+sfwlog_async_pop(SfwLogMessage *msg)
+{
+    uint64_t       pos  = sfwlog_queue_head;
+    SfwLogMessage *slot = &sfwlog_queue[pos & (SFWLOG_QUEUE_SIZE - 1)];
+    uint64_t       seq  = __atomic_load_n(&slot->msg_sequence, __ATOMIC_ACQUIRE);
+
+    if( seq != pos + 1 )
+        return false;
+
+    *msg = *slot;
+    __atomic_store_n(&slot->msg_sequence, pos + SFWLOG_QUEUE_SIZE,
+                     __ATOMIC_RELEASE);
+    sfwlog_queue_head = pos + 1;
+    return true;
+}
+
+static void
+sfwlog_async_write(const SfwLogMessage *msg, char *batch, size_t *used)
+{
+    if( sfwlog_target == SFWLOG_TO_SYSLOG ) {
+        syslog(sfwlog_syslog_level(msg->msg_level), "%s", msg->msg_text);
+        return;
+    }
+
+    for( int retry = 0; retry < 2; ++retry ) {
+        size_t avail = SFWLOG_BATCH_SIZE - *used;
+        int    len   = sfwlog_format_line(batch + *used, avail,
+                                          msg->msg_file, msg->msg_line,
+                                          msg->msg_func, msg->msg_level,
+                                          msg->msg_tick, msg->msg_text);
+        if( len >= 0 && (size_t)len < avail ) {
+            *used += len;
+            break;
+        }
+        /* Batch full: write out and retry */
+        fwrite(batch, 1, *used, stderr);
+        *used = 0;
+    }
+}
+
+/** Write out all queued messages
+ *
+ * @return number of messages written
+ */
+static size_t
+sfwlog_async_drain(void)
+{
+    static char   batch[SFWLOG_BATCH_SIZE];
+    size_t        used  = 0;
+    size_t        count = 0;
+    SfwLogMessage msg;
+
+    uint64_t dropped = __atomic_exchange_n(&sfwlog_queue_dropped, 0,
+                                           __ATOMIC_RELAXED);
+    if( dropped ) {
+        msg.msg_tick  = sfwlog_tick();
+        msg.msg_file  = __FILE__;
+        msg.msg_func  = __func__;
+        msg.msg_line  = __LINE__;
+        msg.msg_level = SFWLOG_WARNING;
+        snprintf(msg.msg_text, sizeof msg.msg_text,
+                 "%" PRIu64 " log messages dropped", dropped);
+        sfwlog_async_write(&msg, batch, &used);
+    }
+
+    while( sfwlog_async_pop(&msg) ) {
+        sfwlog_async_write(&msg, batch, &used);
+        ++count;
+    }
+
+    if( used > 0 ) {
+        fwrite(batch, 1, used, stderr);
         fflush(stderr);
+    }
+    return count;
+}
+
+static gpointer
+sfwlog_async_thread(gpointer aptr)
+{
+    (void)aptr;
+
+    for( ;; ) {
+        if( sfwlog_async_drain() > 0 )
+            continue;
+
+        g_mutex_lock(&sfwlog_writer_mutex);
+        if( sfwlog_writer_stop ) {
+            g_mutex_unlock(&sfwlog_writer_mutex);
+            break;
+        }
+        __atomic_store_n(&sfwlog_writer_idle, true, __ATOMIC_SEQ_CST);
+        /* Recheck after going idle, to avoid missing wakeups */
+        uint64_t pos  = sfwlog_queue_head;
+        uint64_t seq  = __atomic_load_n(&sfwlog_queue[pos & (SFWLOG_QUEUE_SIZE - 1)].msg_sequence,
+                                        __ATOMIC_SEQ_CST);
+        if( seq != pos + 1 )
+            g_cond_wait_until(&sfwlog_writer_cond, &sfwlog_writer_mutex,
+                              g_get_monotonic_time() + SFWLOG_WRITER_IDLE_MAX);
+        __atomic_store_n(&sfwlog_writer_idle, false, __ATOMIC_SEQ_CST);
+        g_mutex_unlock(&sfwlog_writer_mutex);
+    }
+
+    /* Messages queued before stop request */
+    sfwlog_async_drain();
+    return NULL;
+}
+
+bool
+sfwlog_get_async(void)
+{
+    return __atomic_load_n(&sfwlog_async_enabled, __ATOMIC_ACQUIRE);
+}
+
+/** Enable / disable asynchronous logging
+ *
+ * When enabled, messages are formatted on the calling thread and
+ * passed to a writer thread for output, so that logging does not
+ * block the caller on I/O. If the writer cannot keep up, messages
+ * are dropped and the number of dropped messages is logged.
+ *
+ * Disabling waits until queued messages have been written. This
+ * should be done before process exit to avoid losing messages.
+ */
+void
+sfwlog_set_async(bool enabled)
+{
+    if( enabled == (sfwlog_writer != NULL) )
+        goto EXIT;
+
+    if( enabled ) {
+        if( !sfwlog_queue ) {
+            sfwlog_queue = g_new0(SfwLogMessage, SFWLOG_QUEUE_SIZE);
+            for( uint64_t i = 0; i < SFWLOG_QUEUE_SIZE; ++i )
+                sfwlog_queue[i].msg_sequence = i;
+        }
+        sfwlog_writer_stop = false;
+        __atomic_store_n(&sfwlog_async_enabled, true, __ATOMIC_RELEASE);
+        sfwlog_writer = g_thread_new("sfwlog", sfwlog_async_thread, NULL);
+    }
+    else {
+        /* New messages are logged synchronously from here on */
+        __atomic_store_n(&sfwlog_async_enabled, false, __ATOMIC_RELEASE);
+        g_mutex_lock(&sfwlog_writer_mutex);
+        sfwlog_writer_stop = true;
+        g_cond_signal(&sfwlog_writer_cond);
+        g_mutex_unlock(&sfwlog_writer_mutex);
+        g_thread_join(sfwlog_writer), sfwlog_writer = NULL;
+
+        /* Producers that passed the enabled check just before it was
+         * cleared can queue messages after the writer has exited;
+         * write them out here, waiting for claimed slots to fill */
+        for( ;; ) {
+            sfwlog_async_drain();
+            if( sfwlog_queue_head == __atomic_load_n(&sfwlog_queue_tail,
+                                                     __ATOMIC_ACQUIRE) )
+                break;
+            g_usleep(100);
+        }
+    }
+
+EXIT:
+    return;
+}
+
+/* ========================================================================= *
+ * LOGGING_FLIGHT_RECORDER
+ * ========================================================================= */
+
+/** Parse printf conversion specification
+ *
+ * @param pos   position after the '%' character
+ * @param spec  where to store parsed specification
+ *
+ * @return position after the conversion specification
+ */
+static const char *
+sfwlog_parse_spec(const char *pos, SfwLogSpec *spec)
+{
+    size_t n;
+
+    memset(spec, 0, sizeof *spec);
+
+    for( n = 0; *pos && strchr("-+ #0'", *pos); ++pos )
+        if( n < sizeof spec->spec_flags - 1 )
+            spec->spec_flags[n++] = *pos;
+
+    if( *pos == '*' )
+        spec->spec_width_arg = true, ++pos;
+    for( n = 0; g_ascii_isdigit(*pos); ++pos )
+        if( n < sizeof spec->spec_width - 1 )
+            spec->spec_width[n++] = *pos;
+
+    if( *pos == '.' ) {
+        spec->spec_precision[0] = *pos++;
+        if( *pos == '*' )
+            spec->spec_precision_arg = true, ++pos;
+        for( n = 1; g_ascii_isdigit(*pos); ++pos )
+            if( n < sizeof spec->spec_precision - 1 )
+                spec->spec_precision[n++] = *pos;
+    }
+
+    for( n = 0; *pos && strchr("hlLqjzt", *pos); ++pos )
+        if( n < sizeof spec->spec_length - 1 )
+            spec->spec_length[n++] = *pos;
+
+    spec->spec_conversion = *pos;
+    switch( *pos ) {
+    case 'd': case 'i': case 'c':
+        spec->spec_arg = SFWLOG_ARG_INT;
         break;
-    case SFWLOG_TO_SYSLOG:
-        syslog(sfwlog_syslog_level(level), "%s", msg ?: fmt);
+    case 'u': case 'o': case 'x': case 'X':
+        spec->spec_arg = SFWLOG_ARG_UINT;
+        break;
+    case 'e': case 'E': case 'f': case 'F':
+    case 'g': case 'G': case 'a': case 'A':
+        spec->spec_arg = SFWLOG_ARG_DOUBLE;
+        break;
+    case 's':
+        spec->spec_arg = SFWLOG_ARG_STRING;
+        break;
+    case 'p':
+        spec->spec_arg = SFWLOG_ARG_POINTER;
+        break;
+    case 'n':
+        spec->spec_arg = SFWLOG_ARG_SKIP;
+        break;
+    case 'm':
+        spec->spec_arg = SFWLOG_ARG_ERRNO;
         break;
+    case '%':
+        spec->spec_arg = SFWLOG_ARG_NONE;
+        break;
+    default:
+        spec->spec_arg = SFWLOG_ARG_INVALID;
+        return pos;
+    }
+    return pos + 1;
+}
+
+static bool
+sfwlog_record_put(SfwLogRecord *rec, const void *data, size_t size)
+{
+    if( rec->rec_used + size > sizeof rec->rec_args )
+        return false;
+    memcpy(rec->rec_args + rec->rec_used, data, size);
+    rec->rec_used += size;
+    return true;
+}
+
+static bool
+sfwlog_record_get(const SfwLogRecord *rec, size_t *pos, void *data, size_t size)
+{
+    if( *pos + size > rec->rec_used )
+        return false;
+    memcpy(data, rec->rec_args + *pos, size);
+    *pos += size;
+    return true;
+}
+
+/** Copy raw argument values to record, as described by format string
+ *
+ * @param saved_errno  errno at logging call site, for %m conversions
+ */
+static void
+sfwlog_record_capture(SfwLogRecord *rec, int saved_errno, va_list va)
+{
+    SfwLogSpec spec;
+
+    for( const char *pos = rec->rec_fmt; (pos = strchr(pos, '%')); ) {
+        pos = sfwlog_parse_spec(pos + 1, &spec);
+
+        if( spec.spec_width_arg ) {
+            int64_t val = va_arg(va, int);
+            if( !sfwlog_record_put(rec, &val, sizeof val) )
+                goto TRUNCATED;
+        }
+        if( spec.spec_precision_arg ) {
+            int64_t val = va_arg(va, int);
+            if( !sfwlog_record_put(rec, &val, sizeof val) )
+                goto TRUNCATED;
+        }
+
+        const char *len = spec.spec_length;
+        bool        ok  = true;
+        switch( spec.spec_arg ) {
+        case SFWLOG_ARG_NONE:
+            break;
+        case SFWLOG_ARG_INT:
+            {
+                int64_t val;
+                if( !strcmp(len, "ll") || !strcmp(len, "q") )
+                    val = va_arg(va, long long);
+                else if( !strcmp(len, "l") )
+                    val = va_arg(va, long);
+                else if( !strcmp(len, "j") )
+                    val = va_arg(va, intmax_t);
+                else if( !strcmp(len, "z") )
+                    val = va_arg(va, ssize_t);
+                else if( !strcmp(len, "t") )
+                    val = va_arg(va, ptrdiff_t);
+                else
+                    val = va_arg(va, int);
+                ok = sfwlog_record_put(rec, &val, sizeof val);
+            }
+            break;
+        case SFWLOG_ARG_UINT:
+            {
+                uint64_t val;
+                if( !strcmp(len, "ll") || !strcmp(len, "q") )
+                    val = va_arg(va, unsigned long long);
+                else if( !strcmp(len, "l") )
+                    val = va_arg(va, unsigned long);
+                else if( !strcmp(len, "j") )
+                    val = va_arg(va, uintmax_t);
+                else if( !strcmp(len, "z") )
+                    val = va_arg(va, size_t);
+                else if( !strcmp(len, "t") )
+                    val = va_arg(va, ptrdiff_t);
+                else
+                    val = va_arg(va, unsigned);
+                if( !strcmp(len, "hh") )
+                    val = (unsigned char)val;
+                else if( !strcmp(len, "h") )
+                    val = (unsigned short)val;
+                ok = sfwlog_record_put(rec, &val, sizeof val);
+            }
+            break;
+        case SFWLOG_ARG_DOUBLE:
+            {
+                double val;
+                if( !strcmp(len, "L") )
+                    val = (double)va_arg(va, long double);
+                else
+                    val = va_arg(va, double);
+                ok = sfwlog_record_put(rec, &val, sizeof val);
+            }
+            break;
+        case SFWLOG_ARG_STRING:
+        case SFWLOG_ARG_ERRNO:
+            {
+                /* Strings are stored as length prefixed, truncated
+                 * to fit in the remaining space. Error text is
+                 * stored as string, errno is not valid at dump time. */
+                const char *str   = ((spec.spec_arg == SFWLOG_ARG_ERRNO)
+                                     ? strerror(saved_errno)
+                                     : va_arg(va, const char *)) ?: "(null)";
+                size_t      avail = sizeof rec->rec_args - rec->rec_used;
+                uint8_t     slen  = (uint8_t)MIN(strlen(str), MIN(avail, 256u) - 1);
+                ok = (avail > 1 &&
+                      sfwlog_record_put(rec, &slen, 1) &&
+                      sfwlog_record_put(rec, str, slen));
+            }
+            break;
+        case SFWLOG_ARG_POINTER:
+            {
+                uint64_t val = (uintptr_t)va_arg(va, void *);
+                ok = sfwlog_record_put(rec, &val, sizeof val);
+            }
+            break;
+        case SFWLOG_ARG_SKIP:
+            (void)va_arg(va, void *);
+            break;
+        default:
+            ok = false;
+            break;
+        }
+        if( !ok )
+            goto TRUNCATED;
+    }
+    return;
+
+TRUNCATED:
+    rec->rec_truncated = true;
+}
+
+/** Format recorded message
+ *
+ * @return length of formatted text
+ */
+static size_t
+sfwlog_record_format(const SfwLogRecord *rec, char *buff, size_t size)
+{
+    size_t      used = 0;
+    size_t      arg  = 0;
+    const char *pos  = rec->rec_fmt;
+    SfwLogSpec  spec;
+
+    while( *pos && used < size - 1 ) {
+        const char *end = strchr(pos, '%') ?: pos + strlen(pos);
+        size_t      cnt = MIN((size_t)(end - pos), size - 1 - used);
+        memcpy(buff + used, pos, cnt);
+        used += cnt;
+        if( !*end || used >= size - 1 )
+            break;
+
+        pos = sfwlog_parse_spec(end + 1, &spec);
+        if( spec.spec_arg == SFWLOG_ARG_INVALID )
+            break;
+
+        /* Rebuild specification with width / precision arguments
+         * expanded and length modifier matching the stored value */
+        int64_t width = 0, precision = 0;
+        if( spec.spec_width_arg &&
+            !sfwlog_record_get(rec, &arg, &width, sizeof width) )
+            goto TRUNCATED;
+        if( spec.spec_precision_arg &&
+            !sfwlog_record_get(rec, &arg, &precision, sizeof precision) )
+            goto TRUNCATED;
+
+        char wbuf[16] = "", pbuf[16] = "", fmt[64];
+        if( spec.spec_width_arg )
+            snprintf(wbuf, sizeof wbuf, "%s%d", width < 0 ? "-" : "",
+                     (int)(width < 0 ? -width : width));
+        if( spec.spec_precision_arg && precision >= 0 )
+            snprintf(pbuf, sizeof pbuf, ".%d", (int)precision);
+        bool wide = ((spec.spec_arg == SFWLOG_ARG_INT ||
+                      spec.spec_arg == SFWLOG_ARG_UINT) &&
+                     spec.spec_conversion != 'c');
+        if( spec.spec_arg == SFWLOG_ARG_ERRNO )
+            spec.spec_conversion = 's';
+        snprintf(fmt, sizeof fmt, "%%%s%s%s%s%c",
+                 spec.spec_flags,
+                 spec.spec_width_arg ? wbuf : spec.spec_width,
+                 spec.spec_precision_arg ? pbuf : spec.spec_precision,
+                 wide ? "ll" : "",
+                 spec.spec_conversion);
+
+        char   *out   = buff + used;
+        size_t  avail = size - used;
+        int     len   = 0;
+        switch( spec.spec_arg ) {
+        case SFWLOG_ARG_NONE:
+            len = snprintf(out, avail, "%%");
+            break;
+        case SFWLOG_ARG_INT:
+        case SFWLOG_ARG_UINT:
+        case SFWLOG_ARG_POINTER:
+            {
+                uint64_t val;
+                if( !sfwlog_record_get(rec, &arg, &val, sizeof val) )
+                    goto TRUNCATED;
+                if( spec.spec_arg == SFWLOG_ARG_POINTER )
+                    len = snprintf(out, avail, fmt, (void *)(uintptr_t)val);
+                else if( !wide )
+                    len = snprintf(out, avail, fmt, (int)val);
+                else
+                    len = snprintf(out, avail, fmt, (long long)val);
+            }
+            break;
+        case SFWLOG_ARG_DOUBLE:
+            {
+                double val;
+                if( !sfwlog_record_get(rec, &arg, &val, sizeof val) )
+                    goto TRUNCATED;
+                len = snprintf(out, avail, fmt, val);
+            }
+            break;
+        case SFWLOG_ARG_STRING:
+        case SFWLOG_ARG_ERRNO:
+            {
+                uint8_t slen;
+                char    str[256];
+                if( !sfwlog_record_get(rec, &arg, &slen, 1) ||
+                    !sfwlog_record_get(rec, &arg, str, slen) )
+                    goto TRUNCATED;
+                str[slen] = 0;
+                len = snprintf(out, avail, fmt, str);
+            }
+            break;
+        default:
+            break;
+        }
+        used += MIN((size_t)MAX(len, 0), avail - 1);
+    }
+
+    if( rec->rec_truncated && arg >= rec->rec_used )
+        goto TRUNCATED;
+
+    buff[used] = 0;
+    return used;
+
+TRUNCATED:
+    buff[used] = 0;
+    used += snprintf(buff + used, size - used, "...");
+    return MIN(used, size - 1);
+}
+
+/** Write dumped message directly, bypassing recording and queueing
+ */
+static void
+sfwlog_record_output(const char *file, int line, const char *func, int level,
+                     uint64_t tick, const char *text)
+{
+    if( sfwlog_target == SFWLOG_TO_SYSLOG ) {
+        syslog(sfwlog_syslog_level(level), "[flight] %s", text);
+    }
+    else {
+        char buff[SFWLOG_MESSAGE_MAX + 256];
+        sfwlog_format_line(buff, sizeof buff, file, line, func, level,
+                           tick, text);
+        fputs(buff, stderr);
+    }
+}
+
+/** Start using flight recorder ring
+ *
+ * Must be paired with sfwlog_flight_release(), also when the
+ * returned ring is NULL.
+ */
+static SfwLogFlightRing *
+sfwlog_flight_acquire(unsigned *epoch)
+{
+    /* Registration counts only if the epoch did not change meanwhile,
+     * otherwise a ring replaced later might not wait for this user */
+    for( ;; ) {
+        unsigned now = __atomic_load_n(&sfwlog_flight_epoch, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&sfwlog_flight_users[now & 1], 1, __ATOMIC_SEQ_CST);
+        if( __atomic_load_n(&sfwlog_flight_epoch, __ATOMIC_SEQ_CST) == now ) {
+            *epoch = now & 1;
+            break;
+        }
+        __atomic_sub_fetch(&sfwlog_flight_users[now & 1], 1, __ATOMIC_SEQ_CST);
+    }
+    return __atomic_load_n(&sfwlog_flight_ring, __ATOMIC_SEQ_CST);
+}
+
+static void
+sfwlog_flight_release(unsigned epoch)
+{
+    __atomic_sub_fetch(&sfwlog_flight_users[epoch], 1, __ATOMIC_SEQ_CST);
+}
+
+static void
+sfwlog_record_va(const char *file, int line, const char *func, int level,
+                 int saved_errno, const char *fmt, va_list va)
+{
+    unsigned          epoch;
+    SfwLogFlightRing *ring = sfwlog_flight_acquire(&epoch);
+    if( !ring )
+        goto EXIT;
+
+    /* Claim the next slot, overwriting the oldest record. Sequence
+     * number is cleared while the record is incomplete. */
+    uint64_t      seq = __atomic_fetch_add(&sfwlog_flight_next, 1, __ATOMIC_RELAXED);
+    SfwLogRecord *rec = &ring->fr_records[seq & (ring->fr_size - 1)];
+    __atomic_store_n(&rec->rec_sequence, 0, __ATOMIC_RELEASE);
+
+    rec->rec_tick      = sfwlog_tick();
+    rec->rec_file      = file;
+    rec->rec_func      = func;
+    rec->rec_fmt       = fmt;
+    rec->rec_line      = line;
+    rec->rec_level     = (uint8_t)sfwlog_normalize_level(level);
+    rec->rec_truncated = false;
+    rec->rec_used      = 0;
+    sfwlog_record_capture(rec, saved_errno, va);
+
+    __atomic_store_n(&rec->rec_sequence, seq + 1, __ATOMIC_RELEASE);
+
+EXIT:
+    sfwlog_flight_release(epoch);
+}
+
+/** Store message to flight recorder without formatting it
+ *
+ * Used by sfwlog_emit() for messages below active verbosity.
+ */
+void
+sfwlog_record_(const SfwLoggingState *state, const char *fmt, ...)
+{
+    /* Logging must not change errno */
+    int     saved = errno;
+    va_list va;
+    va_start(va, fmt);
+    sfwlog_record_va(state->file, state->line, state->func, state->level,
+                     saved, fmt, va);
+    va_end(va);
+    errno = saved;
+}
+
+/** Enable / disable flight recorder
+ *
+ * When enabled, all messages from sfwlog_emit() call sites are
+ * stored to an in-memory ring buffer with raw arguments, regardless
+ * of verbosity. Recorded messages are formatted only when dumped,
+ * which happens automatically when a sensor, plugin, service or
+ * reporting object enters failed state.
+ *
+ * @param records  ring size, rounded up to power of two,
+ *                 or zero to disable
+ */
+void
+sfwlog_set_flight_recorder(size_t records)
+{
+    size_t size = 0;
+    if( records > 0 )
+        for( size = 1; size < records; size <<= 1 );
+
+    g_mutex_lock(&sfwlog_flight_mutex);
+
+    SfwLogFlightRing *prev = __atomic_load_n(&sfwlog_flight_ring, __ATOMIC_SEQ_CST);
+    if( size == (prev ? prev->fr_size : 0) )
+        goto UNLOCK;
+
+    SfwLogFlightRing *ring = NULL;
+    if( size ) {
+        ring = g_malloc0(sizeof *ring + size * sizeof *ring->fr_records);
+        ring->fr_size = size;
+    }
+    __atomic_store_n(&sfwlog_flight_ring, ring, __ATOMIC_SEQ_CST);
+    sfwlog_flight_dumped = __atomic_load_n(&sfwlog_flight_next, __ATOMIC_ACQUIRE);
+
+    /* Threads that start using the ring from now on get the new one;
+     * wait for the ones registered in the previous epoch to finish */
+    unsigned epoch = __atomic_fetch_add(&sfwlog_flight_epoch, 1, __ATOMIC_SEQ_CST) & 1;
+    while( __atomic_load_n(&sfwlog_flight_users[epoch], __ATOMIC_SEQ_CST) )
+        g_usleep(100);
+    g_free(prev);
+
+    /* Re-evaluate recording status of call sites */
+    g_mutex_lock(&sfwlog_pattern_mutex);
+    sfwlog_generation_bump();
+    g_mutex_unlock(&sfwlog_pattern_mutex);
+
+UNLOCK:
+    g_mutex_unlock(&sfwlog_flight_mutex);
+}
+
+size_t
+sfwlog_flight_recorder_size(void)
+{
+    unsigned          epoch;
+    SfwLogFlightRing *ring = sfwlog_flight_acquire(&epoch);
+    size_t            size = ring ? ring->fr_size : 0;
+    sfwlog_flight_release(epoch);
+    return size;
+}
+
+/** Write out messages recorded since the previous dump
+ */
+void
+sfwlog_dump_flight_recorder(void)
+{
+    /* Logging must not change errno */
+    int               saved = errno;
+    unsigned          epoch;
+    SfwLogFlightRing *ring  = sfwlog_flight_acquire(&epoch);
+
+    if( !ring )
+        goto EXIT;
+
+    size_t   size = ring->fr_size;
+    uint64_t end = __atomic_load_n(&sfwlog_flight_next, __ATOMIC_ACQUIRE);
+    uint64_t beg = MAX(sfwlog_flight_dumped, end > size ? end - size : 0);
+    sfwlog_flight_dumped = end;
+
+    if( beg == end )
+        goto EXIT;
+
+    char text[SFWLOG_MESSAGE_MAX];
+    snprintf(text, sizeof text, "flight recorder: %" PRIu64 " records",
+             end - beg);
+    sfwlog_record_output(__FILE__, __LINE__, __func__, SFWLOG_WARNING,
+                         sfwlog_tick(), text);
+
+    for( uint64_t seq = beg; seq < end; ++seq ) {
+        SfwLogRecord rec = ring->fr_records[seq & (size - 1)];
+        /* Skip records that were incomplete or got overwritten */
+        if( rec.rec_sequence != seq + 1 ||
+            __atomic_load_n(&ring->fr_records[seq & (size - 1)].rec_sequence,
+                            __ATOMIC_ACQUIRE) != seq + 1 )
+            continue;
+
+        sfwlog_record_format(&rec, text, sizeof text);
+        sfwlog_record_output(rec.rec_file, rec.rec_line, rec.rec_func,
+                             rec.rec_level, rec.rec_tick, text);
     }
+    fflush(stderr);
 
-    free(msg);
+EXIT:
+    sfwlog_flight_release(epoch);
     errno = saved;
 }
 
+static gboolean
+sfwlog_dump_on_signal_cb(gpointer aptr)
+{
+    (void)aptr;
+    sfwlog_dump_flight_recorder();
+    return G_SOURCE_CONTINUE;
+}
+
+/** Dump flight recorder when a signal is received
+ *
+ * The dump is made from the main loop, see g_unix_signal_add()
+ * for supported signals.
+ *
+ * @return signal source id, or 0 on failure
+ */
+guint
+sfwlog_dump_on_signal(int signo)
+{
+    return g_unix_signal_add(signo, sfwlog_dump_on_signal_cb, NULL);
+}
+
+/* ========================================================================= *
+ * LOGGING_LIMIT
+ * ========================================================================= */
+
+/** FNV-1a hash of message text, used for detecting repeats
+ */
+static uint32_t
+sfwlog_limit_hash(const char *msg)
+{
+    uint32_t hash = 2166136261u;
+    while( *msg ) {
+        hash ^= (unsigned char)*msg++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/** Decide whether message from a call site should be output
+ *
+ * Repeats of the previous message are folded into a count. The count
+ * is reported, and the message let through, when a different message
+ * arrives or when the repeating has gone on for a while. Counts left
+ * pending when the repeating stops are reported by sfwlog_limit_flush().
+ * Distinct messages consume tokens from a per call site bucket;
+ * messages dropped while it is empty are reported once a token becomes
+ * available again.
+ *
+ * @param note  buffer for summary to output before the message,
+ *              set to empty string if there is none
+ *
+ * @return true if message should be output, false otherwise
+ */
+static bool
+sfwlog_limit_check(SfwLoggingState *state, uint64_t tick, const char *msg,
+                   char *note, size_t size)
+{
+    bool   admit = true;
+    size_t used  = 0;
+
+    *note = 0;
+
+    if( state->level > SFWLOG_LIMIT_MAXLEV )
+        goto EXIT;
+
+    g_mutex_lock(&sfwlog_limit_mutex);
+
+    unsigned burst    = sfwlog_limit_burst;
+    unsigned interval = sfwlog_limit_interval;
+    uint32_t hash     = sfwlog_limit_hash(msg);
+
+    if( burst == 0 )
+        goto UNLOCK;
+
+    if( !state->limit_primed ) {
+        state->limit_primed = true;
+        state->limit_tick   = tick;
+        state->limit_tokens = burst;
+        state->repeat_hash  = ~hash;
+    }
+
+    if( hash == state->repeat_hash &&
+        tick - state->repeat_tick < SFWLOG_REPEAT_INTERVAL ) {
+        /* Fold repeat */
+        state->repeat_count += 1;
+        state->repeat_last   = tick;
+        if( !state->repeat_listed ) {
+            state->repeat_listed  = true;
+            state->repeat_next    = sfwlog_repeat_pending;
+            __atomic_store_n(&sfwlog_repeat_pending, state, __ATOMIC_RELEASE);
+        }
+        admit = false;
+        goto UNLOCK;
+    }
+
+    if( state->repeat_count ) {
+        used = snprintf(note, size, "last message repeated %u times",
+                        state->repeat_count);
+        state->repeat_count = 0;
+    }
+
+    /* Refill tokens earned since the previous refill */
+    uint64_t earned = interval ? (tick - state->limit_tick) / interval : burst;
+    if( state->limit_tokens + earned >= burst ) {
+        state->limit_tokens = burst;
+        state->limit_tick   = tick;
+    }
+    else {
+        state->limit_tokens += (uint32_t)earned;
+        state->limit_tick   += earned * interval;
+    }
+
+    if( state->limit_tokens == 0 ) {
+        state->limit_dropped += 1;
+        admit = false;
+        goto UNLOCK;
+    }
+
+    state->limit_tokens -= 1;
+    state->repeat_hash   = hash;
+    state->repeat_tick   = tick;
+
+    if( state->limit_dropped ) {
+        if( used < size )
+            snprintf(note + used, size - used, "%s%u messages suppressed",
+                     used ? "; " : "", state->limit_dropped);
+        state->limit_dropped = 0;
+    }
+
+UNLOCK:
+    g_mutex_unlock(&sfwlog_limit_mutex);
+
+EXIT:
+    return admit;
+}
+
+/** Report folded repeats of call sites that have gone quiet
+ *
+ * Called for every emitted message, so that repeat counts do not stay
+ * pending indefinitely after the repeating stops.
+ */
+static void
+sfwlog_limit_flush(uint64_t tick)
+{
+    SfwLoggingState *flush[SFWLOG_REPEAT_FLUSH_MAX];
+    uint32_t         count[SFWLOG_REPEAT_FLUSH_MAX];
+    size_t           used = 0;
+
+    if( !__atomic_load_n(&sfwlog_repeat_pending, __ATOMIC_ACQUIRE) )
+        goto EXIT;
+
+    g_mutex_lock(&sfwlog_limit_mutex);
+    for( SfwLoggingState **prev = &sfwlog_repeat_pending, *state;
+         (state = *prev); ) {
+        /* Call sites still repeating report by themselves */
+        if( state->repeat_count &&
+            tick - state->repeat_last < SFWLOG_REPEAT_QUIET ) {
+            prev = &state->repeat_next;
+            continue;
+        }
+        if( state->repeat_count ) {
+            if( used == SFWLOG_REPEAT_FLUSH_MAX )
+                break;
+            flush[used] = state;
+            count[used] = state->repeat_count;
+            ++used;
+            state->repeat_count = 0;
+        }
+        /* Unlink reported and already cleared call sites */
+        *prev = state->repeat_next;
+        state->repeat_next   = NULL;
+        state->repeat_listed = false;
+    }
+    g_mutex_unlock(&sfwlog_limit_mutex);
+
+    for( size_t i = 0; i < used; ++i ) {
+        char note[64];
+        snprintf(note, sizeof note, "last message repeated %u times",
+                 count[i]);
+        sfwlog_output(flush[i]->file, flush[i]->line, flush[i]->func,
+                      flush[i]->level, tick, note);
+    }
+
+EXIT:
+    return;
+}
+
+/** Configure per call site rate limiting
+ *
+ * Applies to messages at info level and above. Each call site can
+ * emit up to burst distinct messages back to back, after which one
+ * more is allowed per interval. Identical consecutive messages are
+ * folded into a "last message repeated N times" summary.
+ *
+ * @param burst        messages allowed in a burst, or zero to disable
+ * @param interval_ms  time needed to earn one more message
+ */
+void
+sfwlog_set_rate_limit(unsigned burst, unsigned interval_ms)
+{
+    g_mutex_lock(&sfwlog_limit_mutex);
+    sfwlog_limit_burst    = burst;
+    sfwlog_limit_interval = interval_ms;
+    g_mutex_unlock(&sfwlog_limit_mutex);
+}
+
 /* ========================================================================= *
  * LOGGING_STATE
  * ========================================================================= */
@@ -455,9 +1729,22 @@ bool
 sfwlogging_state_evaluate(SfwLoggingState *self)
 {
     /* Logging must not change errno */
-    if( self->generation != sfwlog_generation ) {
-        self->generation = sfwlog_generation;
-        self->enabled    = sfwlog_p_(self->file, self->func, self->level);
+    int  saved = errno;
+    bool enabled;
+
+    /* Call sites can be evaluated from multiple threads. Cached values
+     * are written before the generation, so that the inline check in
+     * sfwlogging_state_enabled() sees them once generation matches. */
+    g_mutex_lock(&sfwlog_pattern_mutex);
+    int generation = __atomic_load_n(&sfwlog_generation_, __ATOMIC_RELAXED);
+    if( __atomic_load_n(&self->generation, __ATOMIC_RELAXED) != generation ) {
+        self->enabled  = sfwlog_p_unlocked(self->file, self->func, self->level);
+        self->recorded = sfwlog_flight_recorder_size() > 0;
+        __atomic_store_n(&self->generation, generation, __ATOMIC_RELEASE);
     }
-    return self->enabled;
+    enabled = self->enabled;
+    g_mutex_unlock(&sfwlog_pattern_mutex);
+
+    errno = saved;
+    return enabled;
 }
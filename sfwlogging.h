@@ -66,6 +66,15 @@ enum {
     SFWLOG_DEFLEV  = SFWLOG_WARNING,
 };
 
+/** Highest level of logging call sites that are compiled in
+ *
+ * Call sites above this level compile to nothing. Can be overridden
+ * at build time, e.g. -DSFWLOG_COMPILE_MAXLEV=SFWLOG_INFO.
+ */
+# ifndef SFWLOG_COMPILE_MAXLEV
+#  define SFWLOG_COMPILE_MAXLEV SFWLOG_MAXLEV
+# endif
+
 enum {
     SFWLOG_TO_UNSET,
     SFWLOG_TO_STDERR,
@@ -83,6 +92,19 @@ typedef struct SfwLoggingState {
     int         level;
     int         generation;
     bool        enabled;
+    bool        recorded;
+
+    /* Rate limiting and repeat folding, see sfwlog_set_rate_limit() */
+    bool        limit_primed;
+    uint32_t    limit_tokens;
+    uint32_t    limit_dropped;
+    uint64_t    limit_tick;
+    uint32_t    repeat_hash;
+    uint32_t    repeat_count;
+    uint64_t    repeat_tick;
+    uint64_t    repeat_last;
+    bool        repeat_listed;
+    struct SfwLoggingState *repeat_next;
 } SfwLoggingState;
 
 /* ========================================================================= *
@@ -103,31 +125,88 @@ int         sfwlog_level_from_name(const char *name);
 const char *sfwlog_level_name     (int level);
 bool        sfwlog_p_             (const char *file, const char *func, int level);
 void        sfwlog_emit_          (const char *file, int line, const char *func, int level, const char *fmt, ...) __attribute__((format(printf, 5, 6)));
+void        sfwlog_emit_at_       (SfwLoggingState *state, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+/* ------------------------------------------------------------------------- *
+ * LOGGING_ASYNC
+ * ------------------------------------------------------------------------- */
+
+bool        sfwlog_get_async      (void);
+void        sfwlog_set_async      (bool enabled);
+
+/* ------------------------------------------------------------------------- *
+ * LOGGING_FLIGHT_RECORDER
+ * ------------------------------------------------------------------------- */
+
+void        sfwlog_set_flight_recorder (size_t records);
+size_t      sfwlog_flight_recorder_size(void);
+void        sfwlog_dump_flight_recorder(void);
+guint       sfwlog_dump_on_signal      (int signo);
+void        sfwlog_record_             (const SfwLoggingState *state, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+/* ------------------------------------------------------------------------- *
+ * LOGGING_LIMIT
+ * ------------------------------------------------------------------------- */
+
+void        sfwlog_set_rate_limit (unsigned burst, unsigned interval_ms);
 
 /* ------------------------------------------------------------------------- *
  * LOGGING_STATE
  * ------------------------------------------------------------------------- */
 
+extern int sfwlog_generation_;
+
 bool sfwlogging_state_evaluate(SfwLoggingState *self);
 
+/* ========================================================================= *
+ * Inline functions
+ * ========================================================================= */
+
+/** Check whether call site is enabled
+ *
+ * Fast path for logging macros: function call is made only after
+ * logging configuration has changed.
+ */
+static inline bool
+sfwlogging_state_enabled(SfwLoggingState *self)
+{
+    if( self->generation == sfwlog_generation_ )
+        return self->enabled;
+    return sfwlogging_state_evaluate(self);
+}
+
 /* ========================================================================= *
  * Macros
  * ========================================================================= */
 
 # define sfwlog_p(LEV) ({\
-    static SfwLoggingState cached_state = {\
-        .file  = __FILE__,\
-        .func  =  __func__,\
-        .line  = __LINE__,\
-        .level = LEV,\
-    };\
-    sfwlogging_state_evaluate(&cached_state);\
+    bool enabled = false;\
+    if( (LEV) <= SFWLOG_COMPILE_MAXLEV ) {\
+        static SfwLoggingState cached_state = {\
+            .file  = __FILE__,\
+            .func  =  __func__,\
+            .line  = __LINE__,\
+            .level = LEV,\
+        };\
+        enabled = sfwlogging_state_enabled(&cached_state);\
+    }\
+    enabled;\
 })
 
 # define sfwlog_emit(LEV, FMT, ARGS...)\
      do {\
-         if( sfwlog_p(LEV) ) \
-             sfwlog_emit_(__FILE__, __LINE__, __func__, LEV, FMT, ##ARGS);\
+         if( (LEV) > SFWLOG_COMPILE_MAXLEV )\
+             break;\
+         static SfwLoggingState cached_state = {\
+             .file  = __FILE__,\
+             .func  =  __func__,\
+             .line  = __LINE__,\
+             .level = LEV,\
+         };\
+         if( sfwlogging_state_enabled(&cached_state) ) \
+             sfwlog_emit_at_(&cached_state, FMT, ##ARGS);\
+         else if( cached_state.recorded ) \
+             sfwlog_record_(&cached_state, FMT, ##ARGS);\
      } while( 0 )
 
 # define sfwlog_crit(   FMT,ARGS...) sfwlog_emit(SFWLOG_CRIT,    FMT, ##ARGS)
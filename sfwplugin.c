@@ -39,6 +39,7 @@
 
 #include "sfwservice.h"
 #include "sfwlogging.h"
+#include "sfwtrace.h"
 #include "sfwdbus.h"
 #include "utility.h"
 
@@ -98,6 +99,11 @@ typedef GObjectClass SfwPluginClass;
 # define sfwplugin_log_debug(  FMT, ARGS...) sfwplugin_log_emit(SFWLOG_DEBUG,   FMT, ##ARGS)
 # define sfwplugin_log_trace(  FMT, ARGS...) sfwplugin_log_emit(SFWLOG_TRACE,   FMT, ##ARGS)
 
+# define sfwplugin_trace_state(STATE)\
+     sfwtrace_state(self, "sfplugin", sfwplugin_name(self), STATE)
+# define sfwplugin_trace_event(TYPE, WHAT, VALUE)\
+     sfwtrace_event(self, "sfplugin", sfwplugin_name(self), TYPE, WHAT, VALUE)
+
 /* ========================================================================= *
  * Prototypes
  * ========================================================================= */
@@ -286,6 +292,8 @@ sfwplugin_finalize(GObject *object)
     sfwplugin_stm_set_state(self, SFWPLUGINSTATE_FINAL);
     sfwplugin_detach_from_service(self);
 
+    sfwtrace_forget(self);
+
     G_OBJECT_CLASS(sfwplugin_parent_class)->finalize(object);
 }
 
@@ -532,6 +540,7 @@ sfwplugin_stm_set_state(SfwPlugin *self, SfwPluginState state)
                            sfwpluginstate_repr(state));
         sfwplugin_stm_leave_state(self);
         priv->plg_state = state;
+        sfwplugin_trace_state(sfwpluginstate_repr(state));
         sfwplugin_stm_enter_state(self);
         sfwplugin_stm_eval_state_later(self);
     }
@@ -552,6 +561,7 @@ sfwplugin_stm_enter_state(SfwPlugin *self)
         sfwplugin_set_valid(self, true);
         break;
     case SFWPLUGINSTATE_FAILED:
+        sfwlog_dump_flight_recorder();
         sfwplugin_stm_start_retry_delay(self);
         break;
     case SFWPLUGINSTATE_FINAL:
@@ -705,7 +715,8 @@ sfwplugin_stm_pending_retry_delay(const SfwPlugin *self)
 static void
 sfwplugin_stm_load_cb(GObject *object, GAsyncResult *res, gpointer aptr)
 {
-    SfwPlugin        *self = aptr;
+    AsyncCall        *call = aptr;
+    SfwPlugin        *self = call->ac_object;
     SfwPluginPrivate *priv = sfwplugin_priv(self);
 
     sfwplugin_log_debug("loaded");
@@ -719,6 +730,9 @@ sfwplugin_stm_load_cb(GObject *object, GAsyncResult *res, gpointer aptr)
     else
         g_variant_get(rsp, "(b)", &ack);
 
+    sfwplugin_trace_event(SFWTRACE_ASYNC_END, call->ac_what,
+                          (uintptr_t)call->ac_cancellable);
+
     if( cancellable_finish(&priv->plg_load_cancellable) ) {
         if( ack )
             priv->plg_load_succeeded = true;
@@ -728,6 +742,7 @@ sfwplugin_stm_load_cb(GObject *object, GAsyncResult *res, gpointer aptr)
     g_clear_error(&err);
     gutil_variant_unref(rsp);
     sfwplugin_unref(self);
+    async_call_delete(call);
 }
 
 static void
@@ -739,6 +754,8 @@ sfwplugin_stm_start_load(SfwPlugin *self)
 
     priv->plg_load_succeeded = false;
     cancellable_start(&priv->plg_load_cancellable);
+    sfwplugin_trace_event(SFWTRACE_ASYNC_BEGIN, SFWDBUS_MANAGER_METHOD_LOAD_PLUGIN,
+                          (uintptr_t)priv->plg_load_cancellable);
     g_dbus_connection_call(sfwplugin_connection(self),
                            SFWDBUS_SERVICE,
                            SFWDBUS_MANAGER_OBJECT,
@@ -750,7 +767,9 @@ sfwplugin_stm_start_load(SfwPlugin *self)
                            -1,
                            priv->plg_load_cancellable,
                            sfwplugin_stm_load_cb,
-                           sfwplugin_ref(self));
+                           async_call_new(sfwplugin_ref(self),
+                                          priv->plg_load_cancellable,
+                                          SFWDBUS_MANAGER_METHOD_LOAD_PLUGIN));
 }
 
 static void
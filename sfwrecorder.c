@@ -0,0 +1,458 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "sfwrecorder.h"
+
+#include "sfwlogging.h"
+
+#include <sys/stat.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <inttypes.h>
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Buffered data amount that wakes up the writer thread [bytes] */
+#define SFWRECORDER_FLUSH_SIZE     (16 * 1024)
+
+/** Maximum amount of buffered data before frames get dropped [bytes] */
+#define SFWRECORDER_BUFFER_MAX     (512 * 1024)
+
+/** Maximum time data is held in buffer before writing [us] */
+#define SFWRECORDER_FLUSH_DELAY    (1000 * 1000)
+
+/** Maximum sample count of a valid frame; same as used in playback */
+#define SFWRECORDER_FRAME_MAX      16
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+struct SfwRecorder
+{
+    gchar       *rec_path;
+    SfwSensorId  rec_sensor_id;
+    size_t       rec_sample_size;
+    int          rec_fd;
+
+    /* Writer thread */
+    GThread     *rec_thread;
+    GMutex       rec_mutex;
+    GCond        rec_cond;
+    bool         rec_quit;
+
+    /* Data path appends to fill buffer, writer thread
+     * swaps and writes out the flush buffer */
+    GByteArray  *rec_fill;
+    GByteArray  *rec_flush;
+
+    /* Statistics */
+    uint64_t     rec_frames;
+    uint64_t     rec_dropped;
+
+    /* Write error from writer thread, which does not log by itself;
+     * reported from the data path i.e. main thread */
+    int          rec_errno;
+    bool         rec_errno_reported;
+};
+
+/* ========================================================================= *
+ * Macros
+ * ========================================================================= */
+
+# define sfwrecorder_log_emit(LEV, FMT, ARGS...)\
+     sfwlog_emit(LEV, "sfwrecorder(%s): " FMT, sfwrecorder_path(self), ##ARGS)
+
+# define sfwrecorder_log_crit(   FMT, ARGS...) sfwrecorder_log_emit(SFWLOG_CRIT,    FMT, ##ARGS)
+# define sfwrecorder_log_err(    FMT, ARGS...) sfwrecorder_log_emit(SFWLOG_ERR,     FMT, ##ARGS)
+# define sfwrecorder_log_warning(FMT, ARGS...) sfwrecorder_log_emit(SFWLOG_WARNING, FMT, ##ARGS)
+# define sfwrecorder_log_notice( FMT, ARGS...) sfwrecorder_log_emit(SFWLOG_NOTICE,  FMT, ##ARGS)
+# define sfwrecorder_log_info(   FMT, ARGS...) sfwrecorder_log_emit(SFWLOG_INFO,    FMT, ##ARGS)
+# define sfwrecorder_log_debug(  FMT, ARGS...) sfwrecorder_log_emit(SFWLOG_DEBUG,   FMT, ##ARGS)
+# define sfwrecorder_log_trace(  FMT, ARGS...) sfwrecorder_log_emit(SFWLOG_TRACE,   FMT, ##ARGS)
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWRECORDER_FILE
+ * ------------------------------------------------------------------------- */
+
+static bool  sfwrecorder_file_write (SfwRecorder *self, const void *data, size_t size);
+static void  sfwrecorder_file_error (SfwRecorder *self, int err);
+static off_t sfwrecorder_file_scan  (SfwRecorder *self, off_t size);
+static bool  sfwrecorder_file_header(SfwRecorder *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWRECORDER_THREAD
+ * ------------------------------------------------------------------------- */
+
+static gpointer sfwrecorder_thread_cb(gpointer aptr);
+
+/* ------------------------------------------------------------------------- *
+ * SFWRECORDER
+ * ------------------------------------------------------------------------- */
+
+SfwRecorder *sfwrecorder_open    (const char *path, SfwSensorId id);
+void         sfwrecorder_close   (SfwRecorder *self);
+void         sfwrecorder_close_at(SfwRecorder **pself);
+bool         sfwrecorder_frame   (SfwRecorder *self, int64_t arrival, uint32_t count, const void *data);
+const char  *sfwrecorder_path    (const SfwRecorder *self);
+uint64_t     sfwrecorder_frames  (const SfwRecorder *self);
+uint64_t     sfwrecorder_dropped (const SfwRecorder *self);
+
+/* ========================================================================= *
+ * SFWRECORDER_FILE
+ * ========================================================================= */
+
+G_STATIC_ASSERT(sizeof(SfwRecorderHeader) == 24);
+G_STATIC_ASSERT(sizeof(SfwRecorderFrame) == 16);
+
+/** Write data to file
+ *
+ * Called also from writer thread, so must not log; on failure
+ * errno is left as set by write().
+ */
+static bool
+sfwrecorder_file_write(SfwRecorder *self, const void *data, size_t size)
+{
+    const char *pos = data;
+    while( size > 0 ) {
+        ssize_t done = write(self->rec_fd, pos, size);
+        if( done == -1 ) {
+            if( errno == EINTR )
+                continue;
+            return false;
+        }
+        pos += done, size -= done;
+    }
+    return true;
+}
+
+/** Log write error detected by writer thread
+ */
+static void
+sfwrecorder_file_error(SfwRecorder *self, int err)
+{
+    errno = err;
+    sfwrecorder_log_err("write: %m");
+}
+
+/** Locate end of the last complete frame in existing file
+ *
+ * A recording that was interrupted while writing can end with a
+ * partial frame, which would misalign everything appended after it.
+ *
+ * @param size  file size
+ *
+ * @return offset after the last complete frame, or -1 on read error
+ */
+static off_t
+sfwrecorder_file_scan(SfwRecorder *self, off_t size)
+{
+    off_t offset = sizeof(SfwRecorderHeader);
+
+    while( size - offset >= (off_t)sizeof(SfwRecorderFrame) ) {
+        SfwRecorderFrame frame = { };
+        ssize_t          done  = pread(self->rec_fd, &frame, sizeof frame, offset);
+        if( done == -1 ) {
+            if( errno == EINTR )
+                continue;
+            offset = -1;
+            break;
+        }
+        if( done != sizeof frame )
+            break;
+        if( frame.count < 1 || frame.count > SFWRECORDER_FRAME_MAX )
+            break;
+        off_t end = (offset + (off_t)sizeof frame +
+                     (off_t)frame.count * self->rec_sample_size);
+        if( end > size )
+            break;
+        offset = end;
+    }
+    return offset;
+}
+
+static bool
+sfwrecorder_file_header(SfwRecorder *self)
+{
+    bool              ack    = false;
+    SfwRecorderHeader wanted = {
+        .version     = SFWRECORDER_VERSION,
+        .sensor_id   = self->rec_sensor_id,
+        .sample_size = self->rec_sample_size,
+    };
+    memcpy(wanted.magic, SFWRECORDER_MAGIC, sizeof wanted.magic);
+
+    struct stat st = { };
+    if( fstat(self->rec_fd, &st) == -1 ) {
+        sfwrecorder_log_err("stat: %m");
+        goto EXIT;
+    }
+
+    if( st.st_size == 0 ) {
+        /* New file -> write header */
+        ack = sfwrecorder_file_write(self, &wanted, sizeof wanted);
+        if( !ack )
+            sfwrecorder_log_err("write: %m");
+    }
+    else {
+        /* Appending -> header must match */
+        SfwRecorderHeader header = { };
+        if( pread(self->rec_fd, &header, sizeof header, 0) != sizeof header )
+            sfwrecorder_log_err("can't read existing header");
+        else if( memcmp(&header, &wanted, sizeof header) )
+            sfwrecorder_log_err("existing file is not a %s recording",
+                                sfwsensorid_name(self->rec_sensor_id));
+        else {
+            /* Drop trailing partial frame, if any */
+            off_t end = sfwrecorder_file_scan(self, st.st_size);
+            if( end == -1 )
+                sfwrecorder_log_err("read: %m");
+            else if( end < st.st_size && ftruncate(self->rec_fd, end) == -1 )
+                sfwrecorder_log_err("truncate: %m");
+            else {
+                if( end < st.st_size )
+                    sfwrecorder_log_warning("dropped %jd bytes of incomplete data",
+                                            (intmax_t)(st.st_size - end));
+                ack = true;
+            }
+        }
+    }
+
+EXIT:
+    return ack;
+}
+
+/* ========================================================================= *
+ * SFWRECORDER_THREAD
+ * ========================================================================= */
+
+static gpointer
+sfwrecorder_thread_cb(gpointer aptr)
+{
+    SfwRecorder *self = aptr;
+    bool         quit = false;
+
+    g_mutex_lock(&self->rec_mutex);
+    while( !quit ) {
+        gint64 deadline = g_get_monotonic_time() + SFWRECORDER_FLUSH_DELAY;
+        while( !self->rec_quit && self->rec_fill->len < SFWRECORDER_FLUSH_SIZE ) {
+            if( !g_cond_wait_until(&self->rec_cond, &self->rec_mutex, deadline) )
+                break;
+        }
+        quit = self->rec_quit;
+
+        /* Swap buffers and write without holding the lock */
+        GByteArray *data = self->rec_fill;
+        self->rec_fill  = self->rec_flush;
+        self->rec_flush = data;
+
+        g_mutex_unlock(&self->rec_mutex);
+        int err = 0;
+        if( data->len > 0 ) {
+            if( !sfwrecorder_file_write(self, data->data, data->len) )
+                err = errno;
+            g_byte_array_set_size(data, 0);
+        }
+        g_mutex_lock(&self->rec_mutex);
+        if( err && !self->rec_errno )
+            self->rec_errno = err;
+    }
+    g_mutex_unlock(&self->rec_mutex);
+    return NULL;
+}
+
+/* ========================================================================= *
+ * SFWRECORDER
+ * ========================================================================= */
+
+SfwRecorder *
+sfwrecorder_open(const char *path, SfwSensorId id)
+{
+    GError      *err  = NULL;
+    SfwRecorder *self = g_new0(SfwRecorder, 1);
+
+    self->rec_path        = g_strdup(path);
+    self->rec_sensor_id   = id;
+    self->rec_sample_size = sfwsensorid_sample_size(id);
+    self->rec_fd          = -1;
+    g_mutex_init(&self->rec_mutex);
+    g_cond_init(&self->rec_cond);
+    self->rec_fill        = g_byte_array_sized_new(SFWRECORDER_FLUSH_SIZE);
+    self->rec_flush       = g_byte_array_sized_new(SFWRECORDER_FLUSH_SIZE);
+
+    if( !path || !sfwsensorid_is_valid(id) )
+        goto FAIL;
+
+    self->rec_fd = open(path, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if( self->rec_fd == -1 ) {
+        sfwrecorder_log_err("open: %m");
+        goto FAIL;
+    }
+
+    if( !sfwrecorder_file_header(self) )
+        goto FAIL;
+
+    self->rec_thread = g_thread_try_new("sfwrecorder", sfwrecorder_thread_cb,
+                                        self, &err);
+    if( !self->rec_thread ) {
+        sfwrecorder_log_err("writer thread: %s", err ? err->message : "?");
+        goto FAIL;
+    }
+
+    sfwrecorder_log_info("recording %s", sfwsensorid_name(id));
+    goto EXIT;
+
+FAIL:
+    sfwrecorder_close(self), self = NULL;
+
+EXIT:
+    g_clear_error(&err);
+    return self;
+}
+
+void
+sfwrecorder_close(SfwRecorder *self)
+{
+    if( self ) {
+        if( self->rec_thread ) {
+            g_mutex_lock(&self->rec_mutex);
+            self->rec_quit = true;
+            g_cond_signal(&self->rec_cond);
+            g_mutex_unlock(&self->rec_mutex);
+            g_thread_join(self->rec_thread),
+                self->rec_thread = NULL;
+            if( self->rec_errno && !self->rec_errno_reported )
+                sfwrecorder_file_error(self, self->rec_errno);
+            sfwrecorder_log_info("closed: frames=%" PRIu64
+                                 " dropped=%" PRIu64,
+                                 self->rec_frames, self->rec_dropped);
+        }
+        if( self->rec_fd != -1 )
+            close(self->rec_fd), self->rec_fd = -1;
+        g_byte_array_unref(self->rec_flush);
+        g_byte_array_unref(self->rec_fill);
+        g_cond_clear(&self->rec_cond);
+        g_mutex_clear(&self->rec_mutex);
+        g_free(self->rec_path);
+        g_free(self);
+    }
+}
+
+void
+sfwrecorder_close_at(SfwRecorder **pself)
+{
+    sfwrecorder_close(*pself), *pself = NULL;
+}
+
+bool
+sfwrecorder_frame(SfwRecorder *self, int64_t arrival, uint32_t count,
+                  const void *data)
+{
+    bool             ack   = false;
+    int              err   = 0;
+    size_t           size  = count * self->rec_sample_size;
+    SfwRecorderFrame frame = {
+        .arrival = arrival,
+        .count   = count,
+    };
+
+    g_mutex_lock(&self->rec_mutex);
+    if( self->rec_fill->len + sizeof frame + size > SFWRECORDER_BUFFER_MAX ) {
+        /* Writer is not keeping up - drop rather than block data path */
+        self->rec_dropped += 1;
+    }
+    else {
+        g_byte_array_append(self->rec_fill, (const guint8 *)&frame, sizeof frame);
+        g_byte_array_append(self->rec_fill, data, size);
+        self->rec_frames += 1;
+        if( self->rec_fill->len >= SFWRECORDER_FLUSH_SIZE )
+            g_cond_signal(&self->rec_cond);
+        ack = true;
+    }
+    if( self->rec_errno && !self->rec_errno_reported ) {
+        self->rec_errno_reported = true;
+        err = self->rec_errno;
+    }
+    g_mutex_unlock(&self->rec_mutex);
+
+    if( err )
+        sfwrecorder_file_error(self, err);
+
+    return ack;
+}
+
+const char *
+sfwrecorder_path(const SfwRecorder *self)
+{
+    return (self && self->rec_path) ? self->rec_path : "null";
+}
+
+uint64_t
+sfwrecorder_frames(const SfwRecorder *self)
+{
+    uint64_t frames = 0;
+    if( self ) {
+        SfwRecorder *recorder = (SfwRecorder *)self;
+        g_mutex_lock(&recorder->rec_mutex);
+        frames = recorder->rec_frames;
+        g_mutex_unlock(&recorder->rec_mutex);
+    }
+    return frames;
+}
+
+uint64_t
+sfwrecorder_dropped(const SfwRecorder *self)
+{
+    uint64_t dropped = 0;
+    if( self ) {
+        SfwRecorder *recorder = (SfwRecorder *)self;
+        g_mutex_lock(&recorder->rec_mutex);
+        dropped = recorder->rec_dropped;
+        g_mutex_unlock(&recorder->rec_mutex);
+    }
+    return dropped;
+}
@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef SFWRECORDER_H_
+# define SFWRECORDER_H_
+
+# include "sfwtypes.h"
+
+G_BEGIN_DECLS
+
+# pragma GCC visibility push(default)
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Recording file identification bytes */
+# define SFWRECORDER_MAGIC   "SFWREC\r\n"
+
+/** Recording file format version */
+# define SFWRECORDER_VERSION 1
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+/** Buffered raw sensor data stream writer
+ */
+typedef struct SfwRecorder SfwRecorder;
+
+/** Recording file header
+ *
+ * Written once at the start of a recording file. Appending to an
+ * existing file is allowed only if the header content matches, and
+ * a trailing partial frame is truncated away before appending.
+ */
+typedef struct SfwRecorderHeader
+{
+    /** SFWRECORDER_MAGIC, without terminating nul */
+    char     magic[8];
+
+    /** SFWRECORDER_VERSION */
+    uint32_t version;
+
+    /** SfwSensorId of the recorded sensor */
+    uint32_t sensor_id;
+
+    /** Sample block size, as in sfwsensorid_sample_size() */
+    uint32_t sample_size;
+
+    /** Padding, written as zero */
+    uint32_t reserved;
+} SfwRecorderHeader;
+
+/** Recorded frame header
+ *
+ * Followed by count * sample_size bytes of sample data exactly
+ * as received from sensord i.e. before normalization.
+ */
+typedef struct SfwRecorderFrame
+{
+    /** Arrival time, microseconds, monotonic */
+    int64_t  arrival;
+
+    /** Number of sample blocks in the frame */
+    uint32_t count;
+
+    /** Padding, written as zero */
+    uint32_t reserved;
+} SfwRecorderFrame;
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWRECORDER
+ * ------------------------------------------------------------------------- */
+
+SfwRecorder *sfwrecorder_open    (const char *path, SfwSensorId id);
+void         sfwrecorder_close   (SfwRecorder *self);
+void         sfwrecorder_close_at(SfwRecorder **pself);
+bool         sfwrecorder_frame   (SfwRecorder *self, int64_t arrival, uint32_t count, const void *data);
+const char  *sfwrecorder_path    (const SfwRecorder *self);
+uint64_t     sfwrecorder_frames  (const SfwRecorder *self);
+uint64_t     sfwrecorder_dropped (const SfwRecorder *self);
+
+# pragma GCC visibility pop
+
+G_END_DECLS
+
+#endif /* SFWRECORDER_H_ */
@@ -0,0 +1,483 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "sfwreplay.h"
+
+#include "sfwlogging.h"
+#include "utility.h"
+
+#include <string.h>
+#include <inttypes.h>
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Maximum number of sample blocks in a sane frame */
+#define SFWREPLAY_FRAME_MAX 16
+
+/** Maximum number of frames delivered from one mainloop dispatch */
+#define SFWREPLAY_BURST_MAX 64
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+struct SfwReplay
+{
+    gchar            *rpl_path;
+    GMappedFile      *rpl_file;
+    const uint8_t    *rpl_data;
+    size_t            rpl_size;
+    SfwSensorId       rpl_sensor_id;
+    size_t            rpl_sample_size;
+
+    /* Playback position */
+    size_t            rpl_offset;
+    uint64_t          rpl_frames;
+    bool              rpl_running;
+    bool              rpl_finished;
+
+    /* Pacing: frame with arrival time rpl_base_arrival is
+     * due at rpl_base_time, others relative to that */
+    double            rpl_speed;
+    int64_t           rpl_base_arrival;
+    int64_t           rpl_base_time;
+    int64_t           rpl_prev_arrival;
+    guint             rpl_dispatch_id;
+
+    /* Delivery */
+    SfwReplayHandler  rpl_handler;
+    gpointer          rpl_handler_aptr;
+    bool              rpl_dispatching;
+    bool              rpl_closed;
+};
+
+/* ========================================================================= *
+ * Macros
+ * ========================================================================= */
+
+# define sfwreplay_log_emit(LEV, FMT, ARGS...)\
+     sfwlog_emit(LEV, "sfwreplay(%s): " FMT, sfwreplay_path(self), ##ARGS)
+
+# define sfwreplay_log_crit(   FMT, ARGS...) sfwreplay_log_emit(SFWLOG_CRIT,    FMT, ##ARGS)
+# define sfwreplay_log_err(    FMT, ARGS...) sfwreplay_log_emit(SFWLOG_ERR,     FMT, ##ARGS)
+# define sfwreplay_log_warning(FMT, ARGS...) sfwreplay_log_emit(SFWLOG_WARNING, FMT, ##ARGS)
+# define sfwreplay_log_notice( FMT, ARGS...) sfwreplay_log_emit(SFWLOG_NOTICE,  FMT, ##ARGS)
+# define sfwreplay_log_info(   FMT, ARGS...) sfwreplay_log_emit(SFWLOG_INFO,    FMT, ##ARGS)
+# define sfwreplay_log_debug(  FMT, ARGS...) sfwreplay_log_emit(SFWLOG_DEBUG,   FMT, ##ARGS)
+# define sfwreplay_log_trace(  FMT, ARGS...) sfwreplay_log_emit(SFWLOG_TRACE,   FMT, ##ARGS)
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWREPLAY_FILE
+ * ------------------------------------------------------------------------- */
+
+static bool sfwreplay_file_header(SfwReplay *self);
+static bool sfwreplay_file_peek  (SfwReplay *self, SfwRecorderFrame *frame);
+
+/* ------------------------------------------------------------------------- *
+ * SFWREPLAY_DISPATCH
+ * ------------------------------------------------------------------------- */
+
+static void     sfwreplay_dispatch_rebase  (SfwReplay *self, int64_t now);
+static gboolean sfwreplay_dispatch_cb      (gpointer aptr);
+static void     sfwreplay_dispatch_schedule(SfwReplay *self, int64_t delay);
+static void     sfwreplay_dispatch_cancel  (SfwReplay *self);
+static void     sfwreplay_dispatch_finish  (SfwReplay *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWREPLAY
+ * ------------------------------------------------------------------------- */
+
+static void  sfwreplay_delete     (SfwReplay *self);
+SfwReplay   *sfwreplay_open       (const char *path);
+void         sfwreplay_close      (SfwReplay *self);
+void         sfwreplay_close_at   (SfwReplay **pself);
+void         sfwreplay_set_handler(SfwReplay *self, SfwReplayHandler handler, gpointer aptr);
+void         sfwreplay_set_speed  (SfwReplay *self, double speed);
+double       sfwreplay_speed      (const SfwReplay *self);
+void         sfwreplay_start      (SfwReplay *self);
+void         sfwreplay_stop       (SfwReplay *self);
+void         sfwreplay_rewind     (SfwReplay *self);
+bool         sfwreplay_is_running (const SfwReplay *self);
+bool         sfwreplay_is_finished(const SfwReplay *self);
+const char  *sfwreplay_path       (const SfwReplay *self);
+SfwSensorId  sfwreplay_sensor_id  (const SfwReplay *self);
+size_t       sfwreplay_sample_size(const SfwReplay *self);
+uint64_t     sfwreplay_frames     (const SfwReplay *self);
+
+/* ========================================================================= *
+ * SFWREPLAY_FILE
+ * ========================================================================= */
+
+static bool
+sfwreplay_file_header(SfwReplay *self)
+{
+    bool              ack    = false;
+    SfwRecorderHeader header = { };
+
+    if( self->rpl_size < sizeof header ) {
+        sfwreplay_log_err("file too short");
+        goto EXIT;
+    }
+    memcpy(&header, self->rpl_data, sizeof header);
+
+    if( memcmp(header.magic, SFWRECORDER_MAGIC, sizeof header.magic) ) {
+        sfwreplay_log_err("not a recording file");
+        goto EXIT;
+    }
+    if( header.version != SFWRECORDER_VERSION ) {
+        sfwreplay_log_err("unsupported version: %" PRIu32, header.version);
+        goto EXIT;
+    }
+    if( !sfwsensorid_is_valid(header.sensor_id) ) {
+        sfwreplay_log_err("invalid sensor id: %" PRIu32, header.sensor_id);
+        goto EXIT;
+    }
+    if( header.sample_size != sfwsensorid_sample_size(header.sensor_id) ) {
+        sfwreplay_log_err("sample size mismatch: %" PRIu32, header.sample_size);
+        goto EXIT;
+    }
+
+    self->rpl_sensor_id   = header.sensor_id;
+    self->rpl_sample_size = header.sample_size;
+    self->rpl_offset      = sizeof header;
+    ack = true;
+
+EXIT:
+    return ack;
+}
+
+static bool
+sfwreplay_file_peek(SfwReplay *self, SfwRecorderFrame *frame)
+{
+    /* Frames are packed i.e. not necessarily aligned -> copy header */
+    size_t avail = self->rpl_size - self->rpl_offset;
+
+    if( avail == 0 )
+        return false;
+
+    if( avail < sizeof *frame ) {
+        sfwreplay_log_warning("truncated frame header at offset %zu",
+                              self->rpl_offset);
+        return false;
+    }
+    memcpy(frame, self->rpl_data + self->rpl_offset, sizeof *frame);
+
+    if( frame->count < 1 || frame->count > SFWREPLAY_FRAME_MAX ) {
+        sfwreplay_log_warning("suspicious sample count %" PRIu32
+                              " at offset %zu", frame->count,
+                              self->rpl_offset);
+        return false;
+    }
+
+    if( avail - sizeof *frame < frame->count * self->rpl_sample_size ) {
+        sfwreplay_log_warning("truncated frame data at offset %zu",
+                              self->rpl_offset);
+        return false;
+    }
+
+    return true;
+}
+
+/* ========================================================================= *
+ * SFWREPLAY_DISPATCH
+ * ========================================================================= */
+
+static void
+sfwreplay_dispatch_rebase(SfwReplay *self, int64_t now)
+{
+    SfwRecorderFrame frame = { };
+    if( !sfwreplay_file_peek(self, &frame) )
+        frame.arrival = 0;
+    self->rpl_base_arrival = frame.arrival;
+    self->rpl_base_time    = now;
+    self->rpl_prev_arrival = frame.arrival;
+}
+
+static gboolean
+sfwreplay_dispatch_cb(gpointer aptr)
+{
+    SfwReplay *self = aptr;
+    int64_t    now  = g_get_monotonic_time();
+
+    self->rpl_dispatch_id = 0;
+    self->rpl_dispatching = true;
+
+    for( int burst = 0; self->rpl_running && !self->rpl_closed; ++burst ) {
+        SfwRecorderFrame frame = { };
+        if( !sfwreplay_file_peek(self, &frame) ) {
+            sfwreplay_dispatch_finish(self);
+            break;
+        }
+
+        /* Timeline discontinuity, e.g. appended recording sessions */
+        if( frame.arrival < self->rpl_prev_arrival )
+            sfwreplay_dispatch_rebase(self, now);
+
+        if( self->rpl_speed > 0 ) {
+            int64_t due = (self->rpl_base_time +
+                           (int64_t)((frame.arrival - self->rpl_base_arrival) /
+                                     self->rpl_speed));
+            if( due > now ) {
+                sfwreplay_dispatch_schedule(self, due - now);
+                break;
+            }
+        }
+
+        /* Do not starve the mainloop while catching up */
+        if( burst >= SFWREPLAY_BURST_MAX ) {
+            sfwreplay_dispatch_schedule(self, 0);
+            break;
+        }
+
+        const void *data = self->rpl_data + self->rpl_offset + sizeof frame;
+        self->rpl_offset      += sizeof frame + frame.count * self->rpl_sample_size;
+        self->rpl_prev_arrival = frame.arrival;
+        self->rpl_frames      += 1;
+
+        if( self->rpl_handler )
+            self->rpl_handler(self, &frame, data, self->rpl_handler_aptr);
+    }
+
+    self->rpl_dispatching = false;
+    if( self->rpl_closed )
+        sfwreplay_delete(self);
+
+    return G_SOURCE_REMOVE;
+}
+
+static void
+sfwreplay_dispatch_schedule(SfwReplay *self, int64_t delay)
+{
+    sfwreplay_dispatch_cancel(self);
+    if( delay <= 0 )
+        self->rpl_dispatch_id = g_idle_add(sfwreplay_dispatch_cb, self);
+    else
+        self->rpl_dispatch_id = g_timeout_add((delay + 999) / 1000,
+                                              sfwreplay_dispatch_cb, self);
+}
+
+static void
+sfwreplay_dispatch_cancel(SfwReplay *self)
+{
+    gutil_source_remove_at(&self->rpl_dispatch_id);
+}
+
+static void
+sfwreplay_dispatch_finish(SfwReplay *self)
+{
+    sfwreplay_log_info("finished after %" PRIu64 " frames", self->rpl_frames);
+    self->rpl_running  = false;
+    self->rpl_finished = true;
+    if( self->rpl_handler )
+        self->rpl_handler(self, NULL, NULL, self->rpl_handler_aptr);
+}
+
+/* ========================================================================= *
+ * SFWREPLAY
+ * ========================================================================= */
+
+static void
+sfwreplay_delete(SfwReplay *self)
+{
+    sfwreplay_dispatch_cancel(self);
+    if( self->rpl_file )
+        g_mapped_file_unref(self->rpl_file);
+    g_free(self->rpl_path);
+    g_free(self);
+}
+
+SfwReplay *
+sfwreplay_open(const char *path)
+{
+    GError    *err  = NULL;
+    SfwReplay *self = g_new0(SfwReplay, 1);
+
+    self->rpl_path      = g_strdup(path);
+    self->rpl_sensor_id = SFW_SENSOR_ID_INVALID;
+    self->rpl_speed     = SFWREPLAY_SPEED_ORIGINAL;
+
+    if( !path )
+        goto FAIL;
+
+    if( !(self->rpl_file = g_mapped_file_new(path, FALSE, &err)) ) {
+        sfwreplay_log_err("open: %s", error_message(err));
+        goto FAIL;
+    }
+    self->rpl_data = (const uint8_t *)g_mapped_file_get_contents(self->rpl_file);
+    self->rpl_size = g_mapped_file_get_length(self->rpl_file);
+
+    if( !sfwreplay_file_header(self) )
+        goto FAIL;
+
+    sfwreplay_log_info("replaying %s", sfwsensorid_name(self->rpl_sensor_id));
+    goto EXIT;
+
+FAIL:
+    sfwreplay_delete(self), self = NULL;
+
+EXIT:
+    g_clear_error(&err);
+    return self;
+}
+
+void
+sfwreplay_close(SfwReplay *self)
+{
+    if( self ) {
+        self->rpl_running = false;
+        self->rpl_handler = NULL;
+        if( self->rpl_dispatching )
+            self->rpl_closed = true;
+        else
+            sfwreplay_delete(self);
+    }
+}
+
+void
+sfwreplay_close_at(SfwReplay **pself)
+{
+    sfwreplay_close(*pself), *pself = NULL;
+}
+
+void
+sfwreplay_set_handler(SfwReplay *self, SfwReplayHandler handler, gpointer aptr)
+{
+    if( self ) {
+        self->rpl_handler      = handler;
+        self->rpl_handler_aptr = aptr;
+    }
+}
+
+void
+sfwreplay_set_speed(SfwReplay *self, double speed)
+{
+    if( self ) {
+        if( !(speed > 0) )
+            speed = SFWREPLAY_SPEED_UNLIMITED;
+        if( self->rpl_speed != speed ) {
+            sfwreplay_log_info("speed: %g -> %g", self->rpl_speed, speed);
+            self->rpl_speed = speed;
+            if( self->rpl_running ) {
+                sfwreplay_dispatch_rebase(self, g_get_monotonic_time());
+                sfwreplay_dispatch_schedule(self, 0);
+            }
+        }
+    }
+}
+
+double
+sfwreplay_speed(const SfwReplay *self)
+{
+    return self ? self->rpl_speed : SFWREPLAY_SPEED_ORIGINAL;
+}
+
+void
+sfwreplay_start(SfwReplay *self)
+{
+    if( self && !self->rpl_running && !self->rpl_finished ) {
+        sfwreplay_log_info("starting");
+        self->rpl_running = true;
+        sfwreplay_dispatch_rebase(self, g_get_monotonic_time());
+        sfwreplay_dispatch_schedule(self, 0);
+    }
+}
+
+void
+sfwreplay_stop(SfwReplay *self)
+{
+    if( self && self->rpl_running ) {
+        sfwreplay_log_info("stopping");
+        self->rpl_running = false;
+        sfwreplay_dispatch_cancel(self);
+    }
+}
+
+void
+sfwreplay_rewind(SfwReplay *self)
+{
+    if( self ) {
+        self->rpl_offset   = sizeof(SfwRecorderHeader);
+        self->rpl_frames   = 0;
+        self->rpl_finished = false;
+        if( self->rpl_running ) {
+            sfwreplay_dispatch_rebase(self, g_get_monotonic_time());
+            sfwreplay_dispatch_schedule(self, 0);
+        }
+    }
+}
+
+bool
+sfwreplay_is_running(const SfwReplay *self)
+{
+    return self && self->rpl_running;
+}
+
+bool
+sfwreplay_is_finished(const SfwReplay *self)
+{
+    return self && self->rpl_finished;
+}
+
+const char *
+sfwreplay_path(const SfwReplay *self)
+{
+    return (self && self->rpl_path) ? self->rpl_path : "null";
+}
+
+SfwSensorId
+sfwreplay_sensor_id(const SfwReplay *self)
+{
+    return self ? self->rpl_sensor_id : SFW_SENSOR_ID_INVALID;
+}
+
+size_t
+sfwreplay_sample_size(const SfwReplay *self)
+{
+    return self ? self->rpl_sample_size : 0;
+}
+
+uint64_t
+sfwreplay_frames(const SfwReplay *self)
+{
+    return self ? self->rpl_frames : 0;
+}
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef SFWREPLAY_H_
+# define SFWREPLAY_H_
+
+# include "sfwrecorder.h"
+
+G_BEGIN_DECLS
+
+# pragma GCC visibility push(default)
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Replay speed: frames are delivered with original timing */
+# define SFWREPLAY_SPEED_ORIGINAL   1.0
+
+/** Replay speed: frames are delivered as fast as possible */
+# define SFWREPLAY_SPEED_UNLIMITED  0.0
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+/** Memory mapped recording file player
+ */
+typedef struct SfwReplay SfwReplay;
+
+/** Frame delivery callback
+ *
+ * Called with frame header and pointer to frame->count sample blocks
+ * of sample size bytes each. When end of recording is reached, the
+ * callback gets called once with NULL frame and data.
+ */
+typedef void (*SfwReplayHandler)(SfwReplay *replay, const SfwRecorderFrame *frame, const void *data, gpointer aptr);
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWREPLAY
+ * ------------------------------------------------------------------------- */
+
+SfwReplay   *sfwreplay_open       (const char *path);
+void         sfwreplay_close      (SfwReplay *self);
+void         sfwreplay_close_at   (SfwReplay **pself);
+void         sfwreplay_set_handler(SfwReplay *self, SfwReplayHandler handler, gpointer aptr);
+void         sfwreplay_set_speed  (SfwReplay *self, double speed);
+double       sfwreplay_speed      (const SfwReplay *self);
+void         sfwreplay_start      (SfwReplay *self);
+void         sfwreplay_stop       (SfwReplay *self);
+void         sfwreplay_rewind     (SfwReplay *self);
+bool         sfwreplay_is_running (const SfwReplay *self);
+bool         sfwreplay_is_finished(const SfwReplay *self);
+const char  *sfwreplay_path       (const SfwReplay *self);
+SfwSensorId  sfwreplay_sensor_id  (const SfwReplay *self);
+size_t       sfwreplay_sample_size(const SfwReplay *self);
+uint64_t     sfwreplay_frames     (const SfwReplay *self);
+
+# pragma GCC visibility pop
+
+G_END_DECLS
+
+#endif /* SFWREPLAY_H_ */
@@ -40,6 +40,7 @@
 #include "sfwservice.h"
 #include "sfwsensor.h"
 #include "sfwlogging.h"
+#include "sfwtrace.h"
 #include "sfwdbus.h"
 #include "utility.h"
 
@@ -138,6 +139,11 @@ typedef GObjectClass SfwReportingClass;
 # define sfwreporting_log_debug(  FMT, ARGS...) sfwreporting_log_emit(SFWLOG_DEBUG,   FMT, ##ARGS)
 # define sfwreporting_log_trace(  FMT, ARGS...) sfwreporting_log_emit(SFWLOG_TRACE,   FMT, ##ARGS)
 
+# define sfwreporting_trace_state(STATE)\
+     sfwtrace_state(self, "sfwreporting", sfwreporting_name(self), STATE)
+# define sfwreporting_trace_event(TYPE, WHAT, VALUE)\
+     sfwtrace_event(self, "sfwreporting", sfwreporting_name(self), TYPE, WHAT, VALUE)
+
 /* ========================================================================= *
  * Prototypes
  * ========================================================================= */
@@ -388,6 +394,8 @@ sfwreporting_finalize(GObject *object)
     sfwreporting_log_info("DELETED");
     sfwreporting_detach_from_sensor(self);
 
+    sfwtrace_forget(self);
+
     G_OBJECT_CLASS(sfwreporting_parent_class)->finalize(object);
 }
 
@@ -732,6 +740,7 @@ sfwreporting_stm_set_state(SfwReporting *self, SfwReportingState state)
                               sfwreportingstate_repr(state));
         sfwreporting_stm_leave_state(self);
         priv->rpt_state = state;
+        sfwreporting_trace_state(sfwreportingstate_repr(state));
         sfwreporting_stm_enter_state(self);
         sfwreporting_stm_eval_state_later(self);
     }
@@ -778,6 +787,7 @@ sfwreporting_stm_enter_state(SfwReporting *self)
         sfwreporting_set_valid(self, true);
         break;
     case SFWREPORTINGSTATE_FAILED:
+        sfwlog_dump_flight_recorder();
         priv->rpt_enable_effective = ENABLE_INVALID;
         sfwreporting_stm_start_retry_delay(self);
         break;
@@ -978,7 +988,8 @@ sfwreporting_stm_pending_retry_delay(const SfwReporting *self)
 static void
 sfwreporting_stm_enable_cb(GObject *object, GAsyncResult *res, gpointer aptr)
 {
-    SfwReporting        *self = aptr;
+    AsyncCall           *call = aptr;
+    SfwReporting        *self = call->ac_object;
     SfwReportingPrivate *priv = sfwreporting_priv(self);
     GDBusConnection     *con  = G_DBUS_CONNECTION(object);
     bool                 ack  = false;
@@ -990,6 +1001,9 @@ sfwreporting_stm_enable_cb(GObject *object, GAsyncResult *res, gpointer aptr)
     else
         ack = true;
 
+    sfwreporting_trace_event(SFWTRACE_ASYNC_END, call->ac_what,
+                             (uintptr_t)call->ac_cancellable);
+
     if( cancellable_finish(&priv->rpt_enable_cancellable) ) {
         if( ack )
             priv->rpt_enable_effective = priv->rpt_enable_requested;
@@ -999,6 +1013,7 @@ sfwreporting_stm_enable_cb(GObject *object, GAsyncResult *res, gpointer aptr)
     g_clear_error(&err);
     gutil_variant_unref(rsp);
     sfwreporting_unref(self);
+    async_call_delete(call);
 }
 
 static void
@@ -1015,6 +1030,8 @@ sfwreporting_stm_start_enable(SfwReporting *self)
     priv->rpt_enable_effective = ENABLE_INVALID;
 
     cancellable_start(&priv->rpt_enable_cancellable);
+    sfwreporting_trace_event(SFWTRACE_ASYNC_BEGIN, method,
+                             (uintptr_t)priv->rpt_enable_cancellable);
     g_dbus_connection_call(sfwreporting_connection(self),
                            SFWDBUS_SERVICE,
                            object,
@@ -1026,7 +1043,9 @@ sfwreporting_stm_start_enable(SfwReporting *self)
                            -1,
                            priv->rpt_enable_cancellable,
                            sfwreporting_stm_enable_cb,
-                           sfwreporting_ref(self));
+                           async_call_new(sfwreporting_ref(self),
+                                          priv->rpt_enable_cancellable,
+                                          method));
 }
 static void
 sfwreporting_stm_cancel_enable(SfwReporting *self)
@@ -1049,7 +1068,8 @@ sfwreporting_stm_pending_enable(SfwReporting *self)
 static void
 sfwreporting_stm_datarate_cb(GObject *object, GAsyncResult *res, gpointer aptr)
 {
-    SfwReporting        *self = aptr;
+    AsyncCall           *call = aptr;
+    SfwReporting        *self = call->ac_object;
     SfwReportingPrivate *priv = sfwreporting_priv(self);
     GDBusConnection     *con  = G_DBUS_CONNECTION(object);
     bool                 ack  = false;
@@ -1061,6 +1081,9 @@ sfwreporting_stm_datarate_cb(GObject *object, GAsyncResult *res, gpointer aptr)
     else
         ack = true;
 
+    sfwreporting_trace_event(SFWTRACE_ASYNC_END, call->ac_what,
+                             (uintptr_t)call->ac_cancellable);
+
     if( cancellable_finish(&priv->rpt_datarate_cancellable) ) {
         if( ack )
             priv->rpt_datarate_effective = priv->rpt_datarate_requested;
@@ -1070,6 +1093,7 @@ sfwreporting_stm_datarate_cb(GObject *object, GAsyncResult *res, gpointer aptr)
     gutil_variant_unref(rsp);
     g_clear_error(&err);
     sfwreporting_unref(self);
+    async_call_delete(call);
 }
 
 static void
@@ -1083,6 +1107,8 @@ sfwreporting_stm_start_datarate(SfwReporting *self)
     priv->rpt_datarate_effective = INVALID_DATARATE;
 
     cancellable_start(&priv->rpt_datarate_cancellable);
+    sfwreporting_trace_event(SFWTRACE_ASYNC_BEGIN, SFWDBUS_SENSOR_METHOD_SET_DATARATE,
+                             (uintptr_t)priv->rpt_datarate_cancellable);
     g_dbus_connection_call(sfwreporting_connection(self),
                            SFWDBUS_SERVICE,
                            object,
@@ -1095,7 +1121,9 @@ sfwreporting_stm_start_datarate(SfwReporting *self)
                            -1,
                            priv->rpt_datarate_cancellable,
                            sfwreporting_stm_datarate_cb,
-                           sfwreporting_ref(self));
+                           async_call_new(sfwreporting_ref(self),
+                                          priv->rpt_datarate_cancellable,
+                                          SFWDBUS_SENSOR_METHOD_SET_DATARATE));
 }
 static void
 sfwreporting_stm_cancel_datarate(SfwReporting *self)
@@ -1118,7 +1146,8 @@ sfwreporting_stm_pending_datarate(SfwReporting *self)
 static void
 sfwreporting_stm_override_cb(GObject *object, GAsyncResult *res, gpointer aptr)
 {
-    SfwReporting        *self = aptr;
+    AsyncCall           *call = aptr;
+    SfwReporting        *self = call->ac_object;
     SfwReportingPrivate *priv = sfwreporting_priv(self);
     GDBusConnection     *con  = G_DBUS_CONNECTION(object);
     bool                 ack  = false;
@@ -1130,6 +1159,9 @@ sfwreporting_stm_override_cb(GObject *object, GAsyncResult *res, gpointer aptr)
     else
         ack = true;
 
+    sfwreporting_trace_event(SFWTRACE_ASYNC_END, call->ac_what,
+                             (uintptr_t)call->ac_cancellable);
+
     if( cancellable_finish(&priv->rpt_override_cancellable) ) {
         /* Note: Failures to adjust standby override are ignored as
          *       it is not supported by some sensors in some devices.
@@ -1143,6 +1175,7 @@ sfwreporting_stm_override_cb(GObject *object, GAsyncResult *res, gpointer aptr)
     gutil_variant_unref(rsp);
     g_clear_error(&err);
     sfwreporting_unref(self);
+    async_call_delete(call);
 }
 
 static void
@@ -1156,6 +1189,8 @@ sfwreporting_stm_start_override(SfwReporting *self)
     priv->rpt_override_effective = INVALID_OVERRIDE;
 
     cancellable_start(&priv->rpt_override_cancellable);
+    sfwreporting_trace_event(SFWTRACE_ASYNC_BEGIN, SFWDBUS_SENSOR_METHOD_SET_OVERRIDE,
+                             (uintptr_t)priv->rpt_override_cancellable);
     gboolean value = priv->rpt_override_wanted;
     g_dbus_connection_call(sfwreporting_connection(self),
                            SFWDBUS_SERVICE,
@@ -1168,7 +1203,9 @@ sfwreporting_stm_start_override(SfwReporting *self)
                            -1,
                            priv->rpt_override_cancellable,
                            sfwreporting_stm_override_cb,
-                           sfwreporting_ref(self));
+                           async_call_new(sfwreporting_ref(self),
+                                          priv->rpt_override_cancellable,
+                                          SFWDBUS_SENSOR_METHOD_SET_OVERRIDE));
 }
 static void
 sfwreporting_stm_cancel_override(SfwReporting *self)
@@ -0,0 +1,424 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "sfwresampler.h"
+
+#include "sfwfilter.h"
+#include "sfwlogging.h"
+
+#include <math.h>
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Initial number of input samples retained for sinc interpolation */
+#define SFWRESAMPLER_HISTORY 512
+
+/** Upper limit for sinc interpolation input history size */
+#define SFWRESAMPLER_HISTORY_MAX 16384
+
+/** Sinc kernel half width, in zero crossings */
+#define SFWRESAMPLER_SINC_LOBES 4
+
+/** Input gap, in input or output periods whichever is longer, after
+ *  which output grid is restarted */
+#define SFWRESAMPLER_GAP_PERIODS 8
+
+/** Number of input intervals used for estimating input rate */
+#define SFWRESAMPLER_ESTIMATE_COUNT 16
+
+/** Linear mode anti-alias cutoff, relative to output rate */
+#define SFWRESAMPLER_CUTOFF_RATIO 0.4
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+struct SfwResampler
+{
+    SfwResamplerMethod  rsm_method;
+    double              rsm_rate;
+
+    /** Output period [us] */
+    double              rsm_period;
+
+    /** Timestamp of the first output sample [us] */
+    uint64_t            rsm_origin;
+
+    /** Index of the next output sample */
+    uint64_t            rsm_index;
+
+    /** Input sample ring buffer, oldest first */
+    SfwSample          *rsm_history;
+    size_t              rsm_capacity;
+    size_t              rsm_head;
+    size_t              rsm_count;
+
+    /** Input rate estimation */
+    uint64_t            rsm_estimate_first;
+    size_t              rsm_estimate_count;
+    double              rsm_input_period;
+
+    /** Anti-alias filter for linear downsampling */
+    SfwFilter          *rsm_filter;
+};
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWRESAMPLER
+ * ------------------------------------------------------------------------- */
+
+static inline const SfwSample *sfwresampler_at         (const SfwResampler *self, size_t i);
+static inline const SfwSample *sfwresampler_latest     (const SfwResampler *self);
+static uint64_t                sfwresampler_grid_time  (const SfwResampler *self);
+static void                    sfwresampler_reserve    (SfwResampler *self, size_t capacity);
+static void                    sfwresampler_estimate   (SfwResampler *self, uint64_t t);
+static double                  sfwresampler_half_width (const SfwResampler *self);
+static bool                    sfwresampler_pull_linear(SfwResampler *self, uint64_t t, SfwSample *out);
+static bool                    sfwresampler_pull_sinc  (SfwResampler *self, uint64_t t, SfwSample *out);
+SfwResampler                  *sfwresampler_new        (SfwResamplerMethod method, double rate_hz);
+void                           sfwresampler_delete     (SfwResampler *self);
+void                           sfwresampler_delete_at  (SfwResampler **pself);
+SfwResamplerMethod             sfwresampler_method     (const SfwResampler *self);
+double                         sfwresampler_rate       (const SfwResampler *self);
+void                           sfwresampler_reset      (SfwResampler *self);
+void                           sfwresampler_push       (SfwResampler *self, const SfwSample *sample);
+bool                           sfwresampler_pull       (SfwResampler *self, SfwSample *out);
+
+/* ========================================================================= *
+ * SFWRESAMPLER
+ * ========================================================================= */
+
+static inline const SfwSample *
+sfwresampler_at(const SfwResampler *self, size_t i)
+{
+    i += self->rsm_head;
+    if( i >= self->rsm_capacity )
+        i -= self->rsm_capacity;
+    return &self->rsm_history[i];
+}
+
+static inline const SfwSample *
+sfwresampler_latest(const SfwResampler *self)
+{
+    return sfwresampler_at(self, self->rsm_count - 1);
+}
+
+static uint64_t
+sfwresampler_grid_time(const SfwResampler *self)
+{
+    /* Computed from origin to avoid accumulating rounding errors */
+    return self->rsm_origin + (uint64_t)llround(self->rsm_index * self->rsm_period);
+}
+
+/** Grow input history, keeping retained samples
+ */
+static void
+sfwresampler_reserve(SfwResampler *self, size_t capacity)
+{
+    if( capacity <= self->rsm_capacity )
+        return;
+
+    SfwSample *history = g_new0(SfwSample, capacity);
+    for( size_t i = 0; i < self->rsm_count; ++i )
+        history[i] = *sfwresampler_at(self, i);
+    g_free(self->rsm_history);
+    self->rsm_history  = history;
+    self->rsm_capacity = capacity;
+    self->rsm_head     = 0;
+}
+
+static void
+sfwresampler_estimate(SfwResampler *self, uint64_t t)
+{
+    if( self->rsm_estimate_count == 0 )
+        self->rsm_estimate_first = t;
+
+    if( self->rsm_estimate_count++ != SFWRESAMPLER_ESTIMATE_COUNT )
+        return;
+
+    self->rsm_input_period = (double)(t - self->rsm_estimate_first) /
+        SFWRESAMPLER_ESTIMATE_COUNT;
+
+    /* Sinc kernel must see all inputs within its window, which
+     * extends one output period past the latest input */
+    if( self->rsm_method == SFW_RESAMPLER_SINC ) {
+        double span   = 2.0 * sfwresampler_half_width(self) + self->rsm_period;
+        double needed = ceil(span / self->rsm_input_period) + 2.0;
+        if( needed > SFWRESAMPLER_HISTORY_MAX ) {
+            sfwlog_warning("resampling ratio too large; sinc kernel truncated");
+            needed = SFWRESAMPLER_HISTORY_MAX;
+        }
+        sfwresampler_reserve(self, (size_t)needed);
+    }
+
+    /* Add anti-alias filter if linear mode is downsampling */
+    double input_rate = 1e6 / self->rsm_input_period;
+    if( self->rsm_method == SFW_RESAMPLER_LINEAR && input_rate > self->rsm_rate ) {
+        self->rsm_filter =
+            sfwfilter_new_lowpass(self->rsm_rate * SFWRESAMPLER_CUTOFF_RATIO,
+                                  input_rate, 0.0);
+        /* Start from the latest input to avoid transient */
+        if( self->rsm_filter ) {
+            SfwSample *latest = (SfwSample *)sfwresampler_latest(self);
+            sfwfilter_process(self->rsm_filter, latest, 1);
+        }
+    }
+}
+
+/** Get sinc kernel half width [us]
+ */
+static double
+sfwresampler_half_width(const SfwResampler *self)
+{
+    /* Kernel zero crossings are spaced by the longer of input
+     * and output periods */
+    double period = MAX(self->rsm_period, self->rsm_input_period);
+    return SFWRESAMPLER_SINC_LOBES * period;
+}
+
+static bool
+sfwresampler_pull_linear(SfwResampler *self, uint64_t t, SfwSample *out)
+{
+    if( self->rsm_count < 2 || sfwresampler_latest(self)->timestamp < t )
+        return false;
+
+    const SfwSample *prev = sfwresampler_at(self, self->rsm_count - 2);
+    const SfwSample *next = sfwresampler_latest(self);
+
+    double frac = 1.0;
+    if( next->timestamp > prev->timestamp && t > prev->timestamp )
+        frac = (double)(t - prev->timestamp) / (next->timestamp - prev->timestamp);
+    else if( t <= prev->timestamp )
+        frac = 0.0;
+
+    *out = *next;
+    out->timestamp = t;
+    out->xyz.x = prev->xyz.x + (float)frac * (next->xyz.x - prev->xyz.x);
+    out->xyz.y = prev->xyz.y + (float)frac * (next->xyz.y - prev->xyz.y);
+    out->xyz.z = prev->xyz.z + (float)frac * (next->xyz.z - prev->xyz.z);
+    return true;
+}
+
+static bool
+sfwresampler_pull_sinc(SfwResampler *self, uint64_t t, SfwSample *out)
+{
+    /* Input rate must be known for choosing kernel width */
+    if( self->rsm_input_period <= 0.0 )
+        return false;
+
+    double half = sfwresampler_half_width(self);
+    if( (double)sfwresampler_latest(self)->timestamp < t + half )
+        return false;
+
+    /* Normalized windowed-sinc kernel over irregularly spaced
+     * input samples within the window */
+    double scale = M_PI / MAX(self->rsm_period, self->rsm_input_period);
+    double sum_w = 0.0;
+    double sum_x = 0.0, sum_y = 0.0, sum_z = 0.0;
+
+    for( size_t i = 0; i < self->rsm_count; ++i ) {
+        const SfwSample *s = sfwresampler_at(self, i);
+        double dt = (double)s->timestamp - (double)t;
+        if( fabs(dt) >= half )
+            continue;
+        double arg = dt * scale;
+        double w   = (arg == 0.0) ? 1.0 : sin(arg) / arg;
+        w *= 0.5 * (1.0 + cos(M_PI * dt / half));
+        sum_w += w;
+        sum_x += w * s->xyz.x;
+        sum_y += w * s->xyz.y;
+        sum_z += w * s->xyz.z;
+    }
+
+    *out = *sfwresampler_latest(self);
+    out->timestamp = t;
+    if( sum_w != 0.0 ) {
+        out->xyz.x = (float)(sum_x / sum_w);
+        out->xyz.y = (float)(sum_y / sum_w);
+        out->xyz.z = (float)(sum_z / sum_w);
+    }
+    return true;
+}
+
+/** Create resampler
+ *
+ * @param method   interpolation method
+ * @param rate_hz  output sample rate
+ */
+SfwResampler *
+sfwresampler_new(SfwResamplerMethod method, double rate_hz)
+{
+    SfwResampler *self = NULL;
+
+    if( !(rate_hz > 0.0 && rate_hz <= 1e6) ) {
+        sfwlog_warning("invalid resampling rate: %g Hz", rate_hz);
+        goto EXIT;
+    }
+
+    self = g_new0(SfwResampler, 1);
+    self->rsm_method   = method;
+    self->rsm_rate     = rate_hz;
+    self->rsm_period   = 1e6 / rate_hz;
+    self->rsm_capacity = (method == SFW_RESAMPLER_SINC) ? SFWRESAMPLER_HISTORY : 2;
+    self->rsm_history  = g_new0(SfwSample, self->rsm_capacity);
+    sfwresampler_reset(self);
+
+EXIT:
+    return self;
+}
+
+void
+sfwresampler_delete(SfwResampler *self)
+{
+    if( self ) {
+        sfwfilter_delete(self->rsm_filter);
+        g_free(self->rsm_history);
+        g_free(self);
+    }
+}
+
+void
+sfwresampler_delete_at(SfwResampler **pself)
+{
+    sfwresampler_delete(*pself), *pself = NULL;
+}
+
+SfwResamplerMethod
+sfwresampler_method(const SfwResampler *self)
+{
+    return self->rsm_method;
+}
+
+double
+sfwresampler_rate(const SfwResampler *self)
+{
+    return self ? self->rsm_rate : 0.0;
+}
+
+/** Forget input history and restart output grid from next input
+ */
+void
+sfwresampler_reset(SfwResampler *self)
+{
+    if( self ) {
+        self->rsm_origin         = 0;
+        self->rsm_index          = 0;
+        self->rsm_head           = 0;
+        self->rsm_count          = 0;
+        self->rsm_estimate_first = 0;
+        self->rsm_estimate_count = 0;
+        self->rsm_input_period   = 0.0;
+        sfwfilter_delete_at(&self->rsm_filter);
+    }
+}
+
+/** Feed one input sample
+ *
+ * Output samples that become available should be fetched with
+ * sfwresampler_pull() before pushing more input.
+ */
+void
+sfwresampler_push(SfwResampler *self, const SfwSample *sample)
+{
+    if( !self )
+        goto EXIT;
+
+    if( self->rsm_count > 0 ) {
+        uint64_t prev = sfwresampler_latest(self)->timestamp;
+        if( sample->timestamp <= prev )
+            goto EXIT;
+        /* Gaps can be detected only after input rate is known */
+        double period = MAX(self->rsm_period, self->rsm_input_period);
+        if( self->rsm_input_period > 0.0 &&
+            sample->timestamp - prev > SFWRESAMPLER_GAP_PERIODS * period ) {
+            sfwlog_debug("input gap; restarting output grid");
+            sfwresampler_reset(self);
+        }
+    }
+
+    if( self->rsm_count == 0 )
+        self->rsm_origin = sample->timestamp;
+
+    if( self->rsm_count == self->rsm_capacity ) {
+        self->rsm_count--;
+        if( ++self->rsm_head == self->rsm_capacity )
+            self->rsm_head = 0;
+    }
+    size_t slot = self->rsm_head + self->rsm_count++;
+    if( slot >= self->rsm_capacity )
+        slot -= self->rsm_capacity;
+    self->rsm_history[slot] = *sample;
+
+    if( self->rsm_filter )
+        sfwfilter_process(self->rsm_filter, &self->rsm_history[slot], 1);
+
+    sfwresampler_estimate(self, sample->timestamp);
+
+EXIT:
+    return;
+}
+
+/** Fetch next output sample, if available
+ *
+ * @return true if sample was stored to out, false otherwise
+ */
+bool
+sfwresampler_pull(SfwResampler *self, SfwSample *out)
+{
+    bool ack = false;
+
+    if( !self || self->rsm_count < 1 )
+        goto EXIT;
+
+    uint64_t t = sfwresampler_grid_time(self);
+
+    if( self->rsm_method == SFW_RESAMPLER_SINC )
+        ack = sfwresampler_pull_sinc(self, t, out);
+    else
+        ack = sfwresampler_pull_linear(self, t, out);
+
+    if( ack )
+        self->rsm_index++;
+
+EXIT:
+    return ack;
+}
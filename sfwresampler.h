@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef SFWRESAMPLER_H_
+# define SFWRESAMPLER_H_
+
+# include "sfwtypes.h"
+
+G_BEGIN_DECLS
+
+# pragma GCC visibility push(default)
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+/** Interpolation methods
+ */
+typedef enum SfwResamplerMethod
+{
+    /** Linear interpolation between neighbouring input samples
+     *
+     * When downsampling, input is first passed through a low-pass
+     * filter with cutoff below output Nyquist frequency. */
+    SFW_RESAMPLER_LINEAR,
+
+    /** Windowed-sinc interpolation
+     *
+     * Kernel bandwidth is limited to the lower of input and output
+     * Nyquist frequencies, which acts as anti-alias filter when
+     * downsampling. Adds latency of a few sample periods. */
+    SFW_RESAMPLER_SINC,
+} SfwResamplerMethod;
+
+/** Converter from irregularly timed xyz samples to a fixed rate
+ *
+ * Samples are fed in with sfwresampler_push(), and output samples
+ * with timestamps on an exact fixed-period grid are then available
+ * via sfwresampler_pull().
+ */
+typedef struct SfwResampler SfwResampler;
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWRESAMPLER
+ * ------------------------------------------------------------------------- */
+
+SfwResampler       *sfwresampler_new      (SfwResamplerMethod method, double rate_hz);
+void                sfwresampler_delete   (SfwResampler *self);
+void                sfwresampler_delete_at(SfwResampler **pself);
+SfwResamplerMethod  sfwresampler_method   (const SfwResampler *self);
+double              sfwresampler_rate     (const SfwResampler *self);
+void                sfwresampler_reset    (SfwResampler *self);
+void                sfwresampler_push     (SfwResampler *self, const SfwSample *sample);
+bool                sfwresampler_pull     (SfwResampler *self, SfwSample *out);
+
+# pragma GCC visibility pop
+
+G_END_DECLS
+
+#endif /* SFWRESAMPLER_H_ */
@@ -0,0 +1,759 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "sfwsamplelog.h"
+
+#include "sfwlogging.h"
+#include "utility.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Offset of the first value channel within a sample */
+#define SFWSAMPLELOG_CHANNEL_OFFSET sizeof(uint64_t)
+
+/** Upper limit for block size accepted by reader */
+#define SFWSAMPLELOG_BLOCK_SAMPLES_MAX 65536
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+struct SfwSampleLogWriter
+{
+    gchar        *slw_path;
+    FILE         *slw_file;
+    bool          slw_failed;
+    SfwSensorId   slw_sensor_id;
+    size_t        slw_sample_size;
+    size_t        slw_channel_count;
+    bool          slw_channel_float;
+
+    /* Samples collected for the current block */
+    SfwSample    *slw_samples;
+    size_t        slw_count;
+
+    /* Block encoding buffer */
+    GByteArray   *slw_payload;
+
+    /* Block index */
+    uint64_t      slw_offset;
+    GArray       *slw_index;
+};
+
+struct SfwSampleLogReader
+{
+    gchar              *slr_path;
+    GMappedFile        *slr_file;
+    const uint8_t      *slr_data;
+    size_t              slr_size;
+    SfwSampleLogHeader  slr_header;
+    bool                slr_channel_float;
+    GArray             *slr_index;
+
+    /* Streaming position */
+    size_t              slr_block;
+    SfwSample          *slr_samples;
+    size_t              slr_count;
+    size_t              slr_pos;
+};
+
+/* ========================================================================= *
+ * Macros
+ * ========================================================================= */
+
+# define sfwsamplelogwriter_log_emit(LEV, FMT, ARGS...)\
+     sfwlog_emit(LEV, "sfwsamplelog(%s): " FMT, self->slw_path, ##ARGS)
+
+# define sfwsamplelogwriter_log_err(    FMT, ARGS...) sfwsamplelogwriter_log_emit(SFWLOG_ERR,     FMT, ##ARGS)
+# define sfwsamplelogwriter_log_warning(FMT, ARGS...) sfwsamplelogwriter_log_emit(SFWLOG_WARNING, FMT, ##ARGS)
+# define sfwsamplelogwriter_log_info(   FMT, ARGS...) sfwsamplelogwriter_log_emit(SFWLOG_INFO,    FMT, ##ARGS)
+
+# define sfwsamplelogreader_log_emit(LEV, FMT, ARGS...)\
+     sfwlog_emit(LEV, "sfwsamplelog(%s): " FMT, self->slr_path, ##ARGS)
+
+# define sfwsamplelogreader_log_err(    FMT, ARGS...) sfwsamplelogreader_log_emit(SFWLOG_ERR,     FMT, ##ARGS)
+# define sfwsamplelogreader_log_warning(FMT, ARGS...) sfwsamplelogreader_log_emit(SFWLOG_WARNING, FMT, ##ARGS)
+# define sfwsamplelogreader_log_info(   FMT, ARGS...) sfwsamplelogreader_log_emit(SFWLOG_INFO,    FMT, ##ARGS)
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWSAMPLELOG_CODEC
+ * ------------------------------------------------------------------------- */
+
+static inline uint64_t sfwsamplelog_zigzag64  (int64_t val);
+static inline int64_t  sfwsamplelog_unzigzag64(uint64_t val);
+static inline uint32_t sfwsamplelog_zigzag32  (int32_t val);
+static inline int32_t  sfwsamplelog_unzigzag32(uint32_t val);
+static inline uint32_t sfwsamplelog_get_word  (const SfwSample *sample, size_t channel);
+static inline void     sfwsamplelog_set_word  (SfwSample *sample, size_t channel, uint32_t word);
+static void            sfwsamplelog_put_varint(GByteArray *buf, uint64_t val);
+static bool            sfwsamplelog_get_varint(const uint8_t **ppos, const uint8_t *end, uint64_t *pval);
+static void            sfwsamplelog_encode    (GByteArray *buf, const SfwSample *samples, size_t count, size_t channels, bool floats);
+static bool            sfwsamplelog_decode    (const uint8_t *pos, const uint8_t *end, uint64_t t_first, size_t count, size_t channels, bool floats, SfwSample *out, size_t max);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSAMPLELOGWRITER
+ * ------------------------------------------------------------------------- */
+
+static bool         sfwsamplelogwriter_write      (SfwSampleLogWriter *self, const void *data, size_t size);
+static bool         sfwsamplelogwriter_write_index(SfwSampleLogWriter *self);
+static void         sfwsamplelogwriter_delete     (SfwSampleLogWriter *self);
+SfwSampleLogWriter *sfwsamplelogwriter_open       (const char *path, SfwSensorId id);
+void                sfwsamplelogwriter_close      (SfwSampleLogWriter *self);
+void                sfwsamplelogwriter_close_at   (SfwSampleLogWriter **pself);
+bool                sfwsamplelogwriter_add        (SfwSampleLogWriter *self, const SfwSample *sample);
+bool                sfwsamplelogwriter_add_raw    (SfwSampleLogWriter *self, const void *data, size_t count);
+bool                sfwsamplelogwriter_flush      (SfwSampleLogWriter *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSAMPLELOGREADER
+ * ------------------------------------------------------------------------- */
+
+static bool              sfwsamplelogreader_load_header(SfwSampleLogReader *self);
+static bool              sfwsamplelogreader_load_index (SfwSampleLogReader *self);
+static void              sfwsamplelogreader_scan_index (SfwSampleLogReader *self);
+static bool              sfwsamplelogreader_load_block (SfwSampleLogReader *self, size_t block);
+static void              sfwsamplelogreader_delete     (SfwSampleLogReader *self);
+SfwSampleLogReader      *sfwsamplelogreader_open       (const char *path);
+void                     sfwsamplelogreader_close      (SfwSampleLogReader *self);
+void                     sfwsamplelogreader_close_at   (SfwSampleLogReader **pself);
+SfwSensorId              sfwsamplelogreader_sensor_id  (const SfwSampleLogReader *self);
+size_t                   sfwsamplelogreader_block_count(const SfwSampleLogReader *self);
+const SfwSampleLogIndex *sfwsamplelogreader_block_info (const SfwSampleLogReader *self, size_t block);
+size_t                   sfwsamplelogreader_find_block (const SfwSampleLogReader *self, uint64_t t);
+size_t                   sfwsamplelogreader_read_block (SfwSampleLogReader *self, size_t block, SfwSample *out, size_t max);
+bool                     sfwsamplelogreader_seek       (SfwSampleLogReader *self, uint64_t t);
+bool                     sfwsamplelogreader_next       (SfwSampleLogReader *self, SfwSample *out);
+
+/* ========================================================================= *
+ * SFWSAMPLELOG_CODEC
+ * ========================================================================= */
+
+G_STATIC_ASSERT(sizeof(SfwSampleLogHeader)  == 32);
+G_STATIC_ASSERT(sizeof(SfwSampleLogBlock)   == 32);
+G_STATIC_ASSERT(sizeof(SfwSampleLogIndex)   == 32);
+G_STATIC_ASSERT(sizeof(SfwSampleLogTrailer) == 16);
+
+static inline uint64_t
+sfwsamplelog_zigzag64(int64_t val)
+{
+    return ((uint64_t)val << 1) ^ (uint64_t)(val >> 63);
+}
+
+static inline int64_t
+sfwsamplelog_unzigzag64(uint64_t val)
+{
+    return (int64_t)((val >> 1) ^ (0 - (val & 1)));
+}
+
+static inline uint32_t
+sfwsamplelog_zigzag32(int32_t val)
+{
+    return ((uint32_t)val << 1) ^ (uint32_t)(val >> 31);
+}
+
+static inline int32_t
+sfwsamplelog_unzigzag32(uint32_t val)
+{
+    return (int32_t)((val >> 1) ^ (0 - (val & 1)));
+}
+
+static inline uint32_t
+sfwsamplelog_get_word(const SfwSample *sample, size_t channel)
+{
+    uint32_t word;
+    memcpy(&word, (const uint8_t *)sample + SFWSAMPLELOG_CHANNEL_OFFSET
+           + channel * sizeof word, sizeof word);
+    return word;
+}
+
+static inline void
+sfwsamplelog_set_word(SfwSample *sample, size_t channel, uint32_t word)
+{
+    memcpy((uint8_t *)sample + SFWSAMPLELOG_CHANNEL_OFFSET
+           + channel * sizeof word, &word, sizeof word);
+}
+
+static void
+sfwsamplelog_put_varint(GByteArray *buf, uint64_t val)
+{
+    uint8_t tmp[10];
+    guint   len = 0;
+    while( val >= 0x80 )
+        tmp[len++] = (uint8_t)val | 0x80, val >>= 7;
+    tmp[len++] = (uint8_t)val;
+    g_byte_array_append(buf, tmp, len);
+}
+
+static bool
+sfwsamplelog_get_varint(const uint8_t **ppos, const uint8_t *end,
+                        uint64_t *pval)
+{
+    const uint8_t *pos = *ppos;
+    uint64_t       val = 0;
+
+    for( unsigned shift = 0; pos < end && shift < 64; shift += 7 ) {
+        uint8_t byte = *pos++;
+        val |= (uint64_t)(byte & 0x7f) << shift;
+        if( !(byte & 0x80) ) {
+            *ppos = pos, *pval = val;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void
+sfwsamplelog_encode(GByteArray *buf, const SfwSample *samples, size_t count,
+                    size_t channels, bool floats)
+{
+    /* Timestamps: delta-of-delta, so that steady sampling
+     * rate encodes into one byte per sample */
+    uint64_t prev_time  = samples[0].timestamp;
+    int64_t  prev_delta = 0;
+    for( size_t i = 1; i < count; ++i ) {
+        int64_t delta = (int64_t)(samples[i].timestamp - prev_time);
+        sfwsamplelog_put_varint(buf, sfwsamplelog_zigzag64(delta - prev_delta));
+        prev_time  = samples[i].timestamp;
+        prev_delta = delta;
+    }
+
+    /* Value channels: one column at a time */
+    for( size_t ch = 0; ch < channels; ++ch ) {
+        uint32_t prev = 0;
+        for( size_t i = 0; i < count; ++i ) {
+            uint32_t word = sfwsamplelog_get_word(&samples[i], ch);
+            if( floats ) {
+                uint32_t bits = word ^ prev;
+                if( bits == 0 ) {
+                    sfwsamplelog_put_varint(buf, 0);
+                }
+                else {
+                    unsigned tz = __builtin_ctz(bits);
+                    sfwsamplelog_put_varint(buf, ((uint64_t)(bits >> tz) << 5) | tz);
+                }
+            }
+            else {
+                sfwsamplelog_put_varint(buf, sfwsamplelog_zigzag32((int32_t)(word - prev)));
+            }
+            prev = word;
+        }
+    }
+}
+
+static bool
+sfwsamplelog_decode(const uint8_t *pos, const uint8_t *end, uint64_t t_first,
+                    size_t count, size_t channels, bool floats,
+                    SfwSample *out, size_t max)
+{
+    uint64_t val  = 0;
+    size_t   have = MIN(count, max);
+
+    memset(out, 0, have * sizeof *out);
+
+    uint64_t time  = t_first;
+    int64_t  delta = 0;
+    for( size_t i = 0; i < count; ++i ) {
+        if( i > 0 ) {
+            if( !sfwsamplelog_get_varint(&pos, end, &val) )
+                return false;
+            delta += sfwsamplelog_unzigzag64(val);
+            time  += delta;
+        }
+        if( i < have )
+            out[i].timestamp = time;
+    }
+
+    for( size_t ch = 0; ch < channels; ++ch ) {
+        uint32_t prev = 0;
+        for( size_t i = 0; i < count; ++i ) {
+            if( !sfwsamplelog_get_varint(&pos, end, &val) )
+                return false;
+            if( floats )
+                prev ^= (uint32_t)((val >> 5) << (val & 31));
+            else
+                prev += (uint32_t)sfwsamplelog_unzigzag32((uint32_t)val);
+            if( i < have )
+                sfwsamplelog_set_word(&out[i], ch, prev);
+        }
+    }
+
+    return true;
+}
+
+/* ========================================================================= *
+ * SFWSAMPLELOGWRITER
+ * ========================================================================= */
+
+static bool
+sfwsamplelogwriter_write(SfwSampleLogWriter *self, const void *data, size_t size)
+{
+    if( !self->slw_failed && fwrite(data, 1, size, self->slw_file) != size ) {
+        sfwsamplelogwriter_log_err("write: %m");
+        self->slw_failed = true;
+    }
+    if( !self->slw_failed )
+        self->slw_offset += size;
+    return !self->slw_failed;
+}
+
+static bool
+sfwsamplelogwriter_write_index(SfwSampleLogWriter *self)
+{
+    SfwSampleLogTrailer trailer = {
+        .offset = self->slw_offset,
+        .count  = self->slw_index->len,
+        .magic  = SFWSAMPLELOG_INDEX_MAGIC,
+    };
+    sfwsamplelogwriter_write(self, self->slw_index->data,
+                             self->slw_index->len * sizeof(SfwSampleLogIndex));
+    return sfwsamplelogwriter_write(self, &trailer, sizeof trailer);
+}
+
+static void
+sfwsamplelogwriter_delete(SfwSampleLogWriter *self)
+{
+    if( self->slw_file )
+        fclose(self->slw_file);
+    g_array_unref(self->slw_index);
+    g_byte_array_unref(self->slw_payload);
+    g_free(self->slw_samples);
+    g_free(self->slw_path);
+    g_free(self);
+}
+
+SfwSampleLogWriter *
+sfwsamplelogwriter_open(const char *path, SfwSensorId id)
+{
+    SfwSampleLogWriter *self = g_new0(SfwSampleLogWriter, 1);
+
+    self->slw_path          = g_strdup(path ?: "null");
+    self->slw_sensor_id     = id;
+    self->slw_sample_size   = sfwsensorid_sample_size(id);
+    self->slw_channel_count = sfwsensorid_channel_count(id);
+    self->slw_channel_float = sfwsensorid_channel_float(id);
+    self->slw_samples       = g_new0(SfwSample, SFWSAMPLELOG_BLOCK_SAMPLES);
+    self->slw_payload       = g_byte_array_new();
+    self->slw_index         = g_array_new(FALSE, FALSE, sizeof(SfwSampleLogIndex));
+
+    if( !path || !sfwsensorid_is_valid(id) )
+        goto FAIL;
+
+    if( !(self->slw_file = fopen(path, "wb")) ) {
+        sfwsamplelogwriter_log_err("open: %m");
+        goto FAIL;
+    }
+
+    SfwSampleLogHeader header = {
+        .version       = SFWSAMPLELOG_VERSION,
+        .sensor_id     = id,
+        .sample_size   = self->slw_sample_size,
+        .channel_count = self->slw_channel_count,
+        .block_samples = SFWSAMPLELOG_BLOCK_SAMPLES,
+    };
+    memcpy(header.magic, SFWSAMPLELOG_MAGIC, sizeof header.magic);
+
+    if( !sfwsamplelogwriter_write(self, &header, sizeof header) )
+        goto FAIL;
+
+    goto EXIT;
+
+FAIL:
+    sfwsamplelogwriter_delete(self), self = NULL;
+
+EXIT:
+    return self;
+}
+
+void
+sfwsamplelogwriter_close(SfwSampleLogWriter *self)
+{
+    if( self ) {
+        sfwsamplelogwriter_flush(self);
+        sfwsamplelogwriter_write_index(self);
+        if( fclose(self->slw_file) == EOF ) {
+            sfwsamplelogwriter_log_err("close: %m");
+            self->slw_failed = true;
+        }
+        self->slw_file = NULL;
+        sfwsamplelogwriter_log_info("closed: blocks=%u bytes=%" PRIu64 "%s",
+                                    self->slw_index->len, self->slw_offset,
+                                    self->slw_failed ? " (FAILED)" : "");
+        sfwsamplelogwriter_delete(self);
+    }
+}
+
+void
+sfwsamplelogwriter_close_at(SfwSampleLogWriter **pself)
+{
+    sfwsamplelogwriter_close(*pself), *pself = NULL;
+}
+
+bool
+sfwsamplelogwriter_add(SfwSampleLogWriter *self, const SfwSample *sample)
+{
+    return sfwsamplelogwriter_add_raw(self, sample, 1);
+}
+
+bool
+sfwsamplelogwriter_add_raw(SfwSampleLogWriter *self, const void *data,
+                           size_t count)
+{
+    const uint8_t *pos = data;
+
+    for( size_t i = 0; i < count; ++i, pos += self->slw_sample_size ) {
+        memcpy(&self->slw_samples[self->slw_count++], pos,
+               self->slw_sample_size);
+        if( self->slw_count == SFWSAMPLELOG_BLOCK_SAMPLES )
+            sfwsamplelogwriter_flush(self);
+    }
+
+    return !self->slw_failed;
+}
+
+bool
+sfwsamplelogwriter_flush(SfwSampleLogWriter *self)
+{
+    if( self->slw_count > 0 ) {
+        const SfwSample *samples = self->slw_samples;
+        size_t           count   = self->slw_count;
+
+        g_byte_array_set_size(self->slw_payload, 0);
+        sfwsamplelog_encode(self->slw_payload, samples, count,
+                            self->slw_channel_count,
+                            self->slw_channel_float);
+
+        SfwSampleLogBlock block = {
+            .magic   = SFWSAMPLELOG_BLOCK_MAGIC,
+            .count   = count,
+            .size    = self->slw_payload->len,
+            .t_first = samples[0].timestamp,
+            .t_last  = samples[count - 1].timestamp,
+        };
+        SfwSampleLogIndex entry = {
+            .offset  = self->slw_offset,
+            .t_first = block.t_first,
+            .t_last  = block.t_last,
+            .count   = block.count,
+        };
+
+        if( sfwsamplelogwriter_write(self, &block, sizeof block) &&
+            sfwsamplelogwriter_write(self, self->slw_payload->data,
+                                     self->slw_payload->len) )
+            g_array_append_vals(self->slw_index, &entry, 1);
+
+        self->slw_count = 0;
+    }
+    return !self->slw_failed;
+}
+
+/* ========================================================================= *
+ * SFWSAMPLELOGREADER
+ * ========================================================================= */
+
+static bool
+sfwsamplelogreader_load_header(SfwSampleLogReader *self)
+{
+    SfwSampleLogHeader *header = &self->slr_header;
+
+    if( self->slr_size < sizeof *header ) {
+        sfwsamplelogreader_log_err("file too short");
+        return false;
+    }
+    memcpy(header, self->slr_data, sizeof *header);
+
+    if( memcmp(header->magic, SFWSAMPLELOG_MAGIC, sizeof header->magic) ) {
+        sfwsamplelogreader_log_err("not a sample log file");
+        return false;
+    }
+    if( header->version != SFWSAMPLELOG_VERSION ) {
+        sfwsamplelogreader_log_err("unsupported version: %" PRIu32, header->version);
+        return false;
+    }
+    if( !sfwsensorid_is_valid(header->sensor_id) ||
+        header->sample_size != sfwsensorid_sample_size(header->sensor_id) ||
+        header->channel_count != sfwsensorid_channel_count(header->sensor_id) ) {
+        sfwsamplelogreader_log_err("sensor type mismatch");
+        return false;
+    }
+    if( header->block_samples < 1 ||
+        header->block_samples > SFWSAMPLELOG_BLOCK_SAMPLES_MAX ) {
+        sfwsamplelogreader_log_err("invalid block size: %" PRIu32,
+                                   header->block_samples);
+        return false;
+    }
+
+    self->slr_channel_float = sfwsensorid_channel_float(header->sensor_id);
+    return true;
+}
+
+static bool
+sfwsamplelogreader_load_index(SfwSampleLogReader *self)
+{
+    SfwSampleLogTrailer trailer = { };
+
+    if( self->slr_size < sizeof self->slr_header + sizeof trailer )
+        return false;
+
+    size_t end = self->slr_size - sizeof trailer;
+    memcpy(&trailer, self->slr_data + end, sizeof trailer);
+
+    if( trailer.magic != SFWSAMPLELOG_INDEX_MAGIC )
+        return false;
+    if( trailer.offset < sizeof self->slr_header || trailer.offset > end )
+        return false;
+    if( (end - trailer.offset) / sizeof(SfwSampleLogIndex) != trailer.count )
+        return false;
+
+    g_array_append_vals(self->slr_index, self->slr_data + trailer.offset,
+                        trailer.count);
+    return true;
+}
+
+static void
+sfwsamplelogreader_scan_index(SfwSampleLogReader *self)
+{
+    /* Writer did not get to finish - locate blocks by walking
+     * through block headers */
+    size_t offset = sizeof self->slr_header;
+
+    while( self->slr_size - offset >= sizeof(SfwSampleLogBlock) ) {
+        SfwSampleLogBlock block = { };
+        memcpy(&block, self->slr_data + offset, sizeof block);
+
+        if( block.magic != SFWSAMPLELOG_BLOCK_MAGIC ||
+            block.count < 1 || block.count > self->slr_header.block_samples ||
+            self->slr_size - offset - sizeof block < block.size )
+            break;
+
+        SfwSampleLogIndex entry = {
+            .offset  = offset,
+            .t_first = block.t_first,
+            .t_last  = block.t_last,
+            .count   = block.count,
+        };
+        g_array_append_vals(self->slr_index, &entry, 1);
+        offset += sizeof block + block.size;
+    }
+
+    sfwsamplelogreader_log_warning("no block index; found %u blocks by scanning",
+                                   self->slr_index->len);
+}
+
+static bool
+sfwsamplelogreader_load_block(SfwSampleLogReader *self, size_t block)
+{
+    size_t got = sfwsamplelogreader_read_block(self, block, self->slr_samples,
+                                               self->slr_header.block_samples);
+    self->slr_count = got;
+    self->slr_pos   = 0;
+    self->slr_block = block + 1;
+    return got > 0;
+}
+
+static void
+sfwsamplelogreader_delete(SfwSampleLogReader *self)
+{
+    if( self->slr_file )
+        g_mapped_file_unref(self->slr_file);
+    g_array_unref(self->slr_index);
+    g_free(self->slr_samples);
+    g_free(self->slr_path);
+    g_free(self);
+}
+
+SfwSampleLogReader *
+sfwsamplelogreader_open(const char *path)
+{
+    GError             *err  = NULL;
+    SfwSampleLogReader *self = g_new0(SfwSampleLogReader, 1);
+
+    self->slr_path  = g_strdup(path ?: "null");
+    self->slr_index = g_array_new(FALSE, FALSE, sizeof(SfwSampleLogIndex));
+
+    if( !path )
+        goto FAIL;
+
+    if( !(self->slr_file = g_mapped_file_new(path, FALSE, &err)) ) {
+        sfwsamplelogreader_log_err("open: %s", error_message(err));
+        goto FAIL;
+    }
+    self->slr_data = (const uint8_t *)g_mapped_file_get_contents(self->slr_file);
+    self->slr_size = g_mapped_file_get_length(self->slr_file);
+
+    if( !sfwsamplelogreader_load_header(self) )
+        goto FAIL;
+
+    if( !sfwsamplelogreader_load_index(self) )
+        sfwsamplelogreader_scan_index(self);
+
+    self->slr_samples = g_new0(SfwSample, self->slr_header.block_samples);
+    goto EXIT;
+
+FAIL:
+    sfwsamplelogreader_delete(self), self = NULL;
+
+EXIT:
+    g_clear_error(&err);
+    return self;
+}
+
+void
+sfwsamplelogreader_close(SfwSampleLogReader *self)
+{
+    if( self )
+        sfwsamplelogreader_delete(self);
+}
+
+void
+sfwsamplelogreader_close_at(SfwSampleLogReader **pself)
+{
+    sfwsamplelogreader_close(*pself), *pself = NULL;
+}
+
+SfwSensorId
+sfwsamplelogreader_sensor_id(const SfwSampleLogReader *self)
+{
+    return self ? self->slr_header.sensor_id : SFW_SENSOR_ID_INVALID;
+}
+
+size_t
+sfwsamplelogreader_block_count(const SfwSampleLogReader *self)
+{
+    return self ? self->slr_index->len : 0;
+}
+
+const SfwSampleLogIndex *
+sfwsamplelogreader_block_info(const SfwSampleLogReader *self, size_t block)
+{
+    if( !self || block >= self->slr_index->len )
+        return NULL;
+    return &g_array_index(self->slr_index, SfwSampleLogIndex, block);
+}
+
+size_t
+sfwsamplelogreader_find_block(const SfwSampleLogReader *self, uint64_t t)
+{
+    /* First block that has samples at or after t */
+    size_t lo = 0;
+    size_t hi = sfwsamplelogreader_block_count(self);
+    while( lo < hi ) {
+        size_t mid = lo + (hi - lo) / 2;
+        if( g_array_index(self->slr_index, SfwSampleLogIndex, mid).t_last < t )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+size_t
+sfwsamplelogreader_read_block(SfwSampleLogReader *self, size_t block,
+                              SfwSample *out, size_t max)
+{
+    const SfwSampleLogIndex *entry = sfwsamplelogreader_block_info(self, block);
+    SfwSampleLogBlock        header = { };
+
+    if( !entry )
+        return 0;
+
+    if( entry->offset > self->slr_size ||
+        self->slr_size - entry->offset < sizeof header ) {
+        sfwsamplelogreader_log_err("block %zu: offset out of range", block);
+        return 0;
+    }
+    memcpy(&header, self->slr_data + entry->offset, sizeof header);
+
+    if( header.magic != SFWSAMPLELOG_BLOCK_MAGIC ||
+        header.count < 1 || header.count > self->slr_header.block_samples ||
+        self->slr_size - entry->offset - sizeof header < header.size ) {
+        sfwsamplelogreader_log_err("block %zu: corrupted header", block);
+        return 0;
+    }
+
+    const uint8_t *pos = self->slr_data + entry->offset + sizeof header;
+    if( !sfwsamplelog_decode(pos, pos + header.size, header.t_first,
+                             header.count, self->slr_header.channel_count,
+                             self->slr_channel_float, out, max) ) {
+        sfwsamplelogreader_log_err("block %zu: truncated data", block);
+        return 0;
+    }
+
+    return MIN(header.count, max);
+}
+
+bool
+sfwsamplelogreader_seek(SfwSampleLogReader *self, uint64_t t)
+{
+    size_t block = sfwsamplelogreader_find_block(self, t);
+
+    if( block >= sfwsamplelogreader_block_count(self) ) {
+        self->slr_block = block;
+        self->slr_count = self->slr_pos = 0;
+        return false;
+    }
+
+    if( !sfwsamplelogreader_load_block(self, block) )
+        return false;
+
+    while( self->slr_pos < self->slr_count &&
+           self->slr_samples[self->slr_pos].timestamp < t )
+        ++self->slr_pos;
+
+    return true;
+}
+
+bool
+sfwsamplelogreader_next(SfwSampleLogReader *self, SfwSample *out)
+{
+    while( self->slr_pos >= self->slr_count ) {
+        if( self->slr_block >= sfwsamplelogreader_block_count(self) )
+            return false;
+        sfwsamplelogreader_load_block(self, self->slr_block);
+    }
+    *out = self->slr_samples[self->slr_pos++];
+    return true;
+}
@@ -0,0 +1,203 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef SFWSAMPLELOG_H_
+# define SFWSAMPLELOG_H_
+
+# include "sfwtypes.h"
+
+G_BEGIN_DECLS
+
+# pragma GCC visibility push(default)
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Sample log file identification bytes */
+# define SFWSAMPLELOG_MAGIC         "SFWSLOG\n"
+
+/** Sample log file format version */
+# define SFWSAMPLELOG_VERSION       1
+
+/** Block header identification */
+# define SFWSAMPLELOG_BLOCK_MAGIC   0x4b4c4253u /* "SBLK" */
+
+/** Block index trailer identification */
+# define SFWSAMPLELOG_INDEX_MAGIC   0x58444953u /* "SIDX" */
+
+/** Default maximum number of samples per block */
+# define SFWSAMPLELOG_BLOCK_SAMPLES 256
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+/** Streaming sample log writer
+ */
+typedef struct SfwSampleLogWriter SfwSampleLogWriter;
+
+/** Sample log reader
+ */
+typedef struct SfwSampleLogReader SfwSampleLogReader;
+
+/** Sample log file header
+ *
+ * Samples are handled as a 64-bit timestamp followed by channel_count
+ * 32-bit value words, as described by sfwsensorid_channel_count() and
+ * sfwsensorid_channel_float().
+ */
+typedef struct SfwSampleLogHeader
+{
+    /** SFWSAMPLELOG_MAGIC, without terminating nul */
+    char     magic[8];
+
+    /** SFWSAMPLELOG_VERSION */
+    uint32_t version;
+
+    /** SfwSensorId of the logged sensor */
+    uint32_t sensor_id;
+
+    /** Sample size, as in sfwsensorid_sample_size() */
+    uint32_t sample_size;
+
+    /** Number of value channels per sample */
+    uint32_t channel_count;
+
+    /** Maximum number of samples per block */
+    uint32_t block_samples;
+
+    /** Padding, written as zero */
+    uint32_t reserved;
+} SfwSampleLogHeader;
+
+/** Sample block header
+ *
+ * Followed by size bytes of column data:
+ * - timestamps: zigzag varint delta-of-delta, first one is t_first
+ * - integer channels: zigzag varint delta to previous value
+ * - float channels: varint of xor to previous value bits, with
+ *   trailing zero bits stripped and their count in low 5 bits
+ */
+typedef struct SfwSampleLogBlock
+{
+    /** SFWSAMPLELOG_BLOCK_MAGIC */
+    uint32_t magic;
+
+    /** Number of samples in block */
+    uint32_t count;
+
+    /** Size of column data following the block header */
+    uint32_t size;
+
+    /** Padding, written as zero */
+    uint32_t reserved;
+
+    /** Timestamp of the first sample in block */
+    uint64_t t_first;
+
+    /** Timestamp of the last sample in block */
+    uint64_t t_last;
+} SfwSampleLogBlock;
+
+/** Block index entry
+ *
+ * Written after the last block when the log is closed, followed by
+ * SfwSampleLogTrailer. Logs without index are still readable, the
+ * index is then reconstructed by scanning block headers.
+ */
+typedef struct SfwSampleLogIndex
+{
+    /** File offset of SfwSampleLogBlock */
+    uint64_t offset;
+
+    /** Copies of block header data */
+    uint64_t t_first;
+    uint64_t t_last;
+    uint32_t count;
+    uint32_t reserved;
+} SfwSampleLogIndex;
+
+/** Sample log trailer
+ */
+typedef struct SfwSampleLogTrailer
+{
+    /** File offset of the first SfwSampleLogIndex entry */
+    uint64_t offset;
+
+    /** Number of index entries */
+    uint32_t count;
+
+    /** SFWSAMPLELOG_INDEX_MAGIC */
+    uint32_t magic;
+} SfwSampleLogTrailer;
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWSAMPLELOGWRITER
+ * ------------------------------------------------------------------------- */
+
+SfwSampleLogWriter *sfwsamplelogwriter_open    (const char *path, SfwSensorId id);
+void                sfwsamplelogwriter_close   (SfwSampleLogWriter *self);
+void                sfwsamplelogwriter_close_at(SfwSampleLogWriter **pself);
+bool                sfwsamplelogwriter_add     (SfwSampleLogWriter *self, const SfwSample *sample);
+bool                sfwsamplelogwriter_add_raw (SfwSampleLogWriter *self, const void *data, size_t count);
+bool                sfwsamplelogwriter_flush   (SfwSampleLogWriter *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSAMPLELOGREADER
+ * ------------------------------------------------------------------------- */
+
+SfwSampleLogReader      *sfwsamplelogreader_open       (const char *path);
+void                     sfwsamplelogreader_close      (SfwSampleLogReader *self);
+void                     sfwsamplelogreader_close_at   (SfwSampleLogReader **pself);
+SfwSensorId              sfwsamplelogreader_sensor_id  (const SfwSampleLogReader *self);
+size_t                   sfwsamplelogreader_block_count(const SfwSampleLogReader *self);
+const SfwSampleLogIndex *sfwsamplelogreader_block_info (const SfwSampleLogReader *self, size_t block);
+size_t                   sfwsamplelogreader_find_block (const SfwSampleLogReader *self, uint64_t t);
+size_t                   sfwsamplelogreader_read_block (SfwSampleLogReader *self, size_t block, SfwSample *out, size_t max);
+bool                     sfwsamplelogreader_seek       (SfwSampleLogReader *self, uint64_t t);
+bool                     sfwsamplelogreader_next       (SfwSampleLogReader *self, SfwSample *out);
+
+# pragma GCC visibility pop
+
+G_END_DECLS
+
+#endif /* SFWSAMPLELOG_H_ */
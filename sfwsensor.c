@@ -40,11 +40,21 @@
 #include "sfwservice.h"
 #include "sfwplugin.h"
 #include "sfwreporting.h"
+#include "sfwrecorder.h"
+#include "sfwreplay.h"
+#include "sfwhistory.h"
+#include "sfwfilter.h"
+#include "sfwresampler.h"
+#include "sfwspectrum.h"
+#include "sfwstats.h"
 #include "sfwlogging.h"
+#include "sfwtrace.h"
 #include "sfwdbus.h"
 #include "utility.h"
 
+#include <string.h>
 #include <inttypes.h>
+#include <math.h>
 
 /* ========================================================================= *
  * Constants
@@ -56,6 +66,30 @@
 /** Placeholder session id value */
 #define SESSION_ID_INVALID (-1)
 
+/** Maximum number of samples sensord sends in one frame */
+#define SFWSENSOR_FRAME_MAX 16
+
+/** Maximum number of queued frames to skip in latest only mode */
+#define SFWSENSOR_DRAIN_MAX 64
+
+/** Default reading queue size for backpressure policies */
+#define SFWSENSOR_QUEUE_DEFAULT 64
+
+/** Maximum number of queued readings to deliver per idle callback */
+#define SFWSENSOR_QUEUE_BATCH 16
+
+/** Maximum number of direct reading callbacks per sensor */
+#define SFWSENSOR_CALLBACKS_MAX 8
+
+/** Maximum number of readings passed to worker callback at once */
+#define SFWSENSOR_BATCH_MAX 64
+
+/** Maximum number of batches waiting for worker callback per sensor */
+#define SFWSENSOR_WORKER_PENDING_MAX 64
+
+/** Maximum number of threads in shared worker pool */
+#define SFWSENSOR_WORKER_THREADS 4
+
 /* ========================================================================= *
  * Types
  * ========================================================================= */
@@ -73,6 +107,48 @@ typedef enum SfwSensorState
     SFWSENSORSTATE_COUNT
 } SfwSensorState;
 
+/** Directly invoked reading callback, see sfwsensor_add_reading_callback()
+ */
+typedef struct SfwSensorCallback
+{
+    guint                    cb_id;
+    SfwSensorReadingCallback cb_func;
+    gpointer                 cb_aptr;
+} SfwSensorCallback;
+
+/** Readings waiting to be passed to worker callback
+ */
+typedef struct SfwSensorBatch
+{
+    struct SfwSensorBatch *bat_next;
+    size_t                 bat_count;
+    SfwReading             bat_readings[SFWSENSOR_BATCH_MAX];
+} SfwSensorBatch;
+
+/** Ordered delivery of reading batches via shared thread pool
+ *
+ * Batches are filled in the main context. At most one pool task
+ * per worker is scheduled at any time, which keeps batches from one
+ * sensor in order. Workers are reference counted, as pool tasks can
+ * outlive the sensor.
+ */
+typedef struct SfwSensorWorker
+{
+    gint                    wrk_refcount;
+    GMutex                  wrk_mutex;
+    GCond                   wrk_cond;
+    SfwSensorBatchCallback  wrk_callback;
+    gpointer                wrk_aptr;
+    bool                    wrk_cancelled;
+    bool                    wrk_scheduled;
+    bool                    wrk_running;
+    SfwSensorBatch         *wrk_head;
+    SfwSensorBatch         *wrk_tail;
+    size_t                  wrk_pending;
+    SfwSensorBatch         *wrk_spare;
+    SfwSensorBatch         *wrk_filling;
+} SfwSensorWorker;
+
 typedef struct SfwSensorPrivate
 {
     SfwPlugin      *sns_plugin;
@@ -95,6 +171,49 @@ typedef struct SfwSensorPrivate
     SfwReporting   *sns_reporting;
     SfwReading      sns_reading;
     gulong          sns_reporting_active_changed_id;
+    uint8_t         sns_frame[SFWSENSOR_FRAME_MAX * sizeof(SfwSample)];
+    SfwSample       sns_samples[SFWSENSOR_FRAME_MAX];
+    SfwRecorder    *sns_recorder;
+    SfwReplay      *sns_replay;
+    SfwHistory     *sns_history;
+    GPtrArray      *sns_filters;
+    SfwResampler   *sns_resampler;
+    SfwSample       sns_resampled;
+    bool            sns_resampled_held;
+    GPtrArray      *sns_stats;
+    SfwSpectrum    *sns_spectrum;
+
+    /* Delivery policy */
+    SfwSensorThreshold sns_threshold;
+    double             sns_threshold_epsilon;
+    double             sns_threshold_hysteresis;
+    bool               sns_threshold_primed;
+    double             sns_threshold_ref[SFW_SAMPLE_CHANNELS_MAX];
+    int8_t             sns_threshold_dir[SFW_SAMPLE_CHANNELS_MAX];
+    uint64_t           sns_suppressed;
+    bool               sns_latest_only;
+    uint64_t           sns_skipped;
+
+    /* Reading queue */
+    SfwSensorBackpressure sns_backpressure;
+    SfwSample         *sns_queue;
+    size_t             sns_queue_capacity;
+    size_t             sns_queue_size;
+    size_t             sns_queue_high_water;
+    size_t             sns_queue_head;
+    size_t             sns_queue_count;
+    bool               sns_queue_above_high_water;
+    guint              sns_queue_id;
+    uint64_t           sns_dropped;
+    bool               sns_socket_paused;
+
+    /* Direct reading callbacks */
+    SfwSensorCallback  sns_callbacks[SFWSENSOR_CALLBACKS_MAX];
+    size_t             sns_callback_count;
+    guint              sns_callback_id;
+
+    /* Worker thread delivery */
+    SfwSensorWorker   *sns_worker;
 } SfwSensorPrivate;
 
 struct SfwSensor
@@ -107,6 +226,8 @@ typedef enum SfwSensorSignal
     SFWSENSOR_SIGNAL_VALID_CHANGED,
     SFWSENSOR_SIGNAL_READING_CHANGED,
     SFWSENSOR_SIGNAL_ACTIVE_CHANGED,
+    SFWSENSOR_SIGNAL_HIGH_WATER,
+    SFWSENSOR_SIGNAL_SPECTRUM_CHANGED,
     SFWSENSOR_SIGNAL_COUNT,
 } SfwSensorSignal;
 
@@ -127,6 +248,13 @@ typedef GObjectClass SfwSensorClass;
 # define sfwsensor_log_debug(  FMT, ARGS...) sfwsensor_log_emit(SFWLOG_DEBUG,   FMT, ##ARGS)
 # define sfwsensor_log_trace(  FMT, ARGS...) sfwsensor_log_emit(SFWLOG_TRACE,   FMT, ##ARGS)
 
+# define sfwsensor_trace_state(STATE)\
+     sfwtrace_state(self, "sfsensor", sfwsensor_name(self), STATE)
+# define sfwsensor_trace_event(TYPE, WHAT, VALUE)\
+     sfwtrace_event(self, "sfsensor", sfwsensor_name(self), TYPE, WHAT, VALUE)
+# define sfwsensor_trace_data(TYPE, WHAT, VALUE)\
+     sfwtrace_event(priv, "sfsensor-data", sfwsensor_name(self), TYPE, WHAT, VALUE)
+
 /* ========================================================================= *
  * Prototypes
  * ========================================================================= */
@@ -155,13 +283,14 @@ static const char *sfwsensorstate_repr(SfwSensorState state);
  * SFWSENSOR_LIFECYCLE
  * ------------------------------------------------------------------------- */
 
-static void  sfwsensor_init    (SfwSensor *self);
-static void  sfwsensor_finalize(GObject *object);
-SfwSensor   *sfwsensor_new     (SfwSensorId id);
-SfwSensor   *sfwsensor_ref     (SfwSensor *self);
-void         sfwsensor_unref   (SfwSensor *self);
-void         sfwsensor_unref_cb(gpointer self);
-void         sfwsensor_unref_at(SfwSensor **pself);
+static void  sfwsensor_init      (SfwSensor *self);
+static void  sfwsensor_finalize  (GObject *object);
+SfwSensor   *sfwsensor_new       (SfwSensorId id);
+SfwSensor   *sfwsensor_new_replay(const char *path);
+SfwSensor   *sfwsensor_ref       (SfwSensor *self);
+void         sfwsensor_unref     (SfwSensor *self);
+void         sfwsensor_unref_cb  (gpointer self);
+void         sfwsensor_unref_at  (SfwSensor **pself);
 
 /* ------------------------------------------------------------------------- *
  * SFWSENSOR_CONTROL
@@ -193,17 +322,126 @@ static void sfwsensor_reporting_active_changed_cb(SfwReporting *sfwreporting, gp
 
 SfwReading *sfwsensor_reading(SfwSensor *self);
 
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_FRAME
+ * ------------------------------------------------------------------------- */
+
+static void sfwsensor_deliver_sample(SfwSensor *self, const SfwSample *sample, bool final);
+static void sfwsensor_handle_frame  (SfwSensor *self, int64_t arrival, uint32_t cnt, const void *data, bool deliver);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_REPLAY
+ * ------------------------------------------------------------------------- */
+
+static void sfwsensor_replay_cb       (SfwReplay *replay, const SfwRecorderFrame *frame, const void *data, gpointer aptr);
+bool        sfwsensor_is_replay       (const SfwSensor *self);
+void        sfwsensor_set_replay_speed(SfwSensor *self, double speed);
+void        sfwsensor_rewind_replay   (SfwSensor *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_RECORDING
+ * ------------------------------------------------------------------------- */
+
+bool sfwsensor_start_recording(SfwSensor *self, const char *path);
+void sfwsensor_stop_recording (SfwSensor *self);
+bool sfwsensor_is_recording   (const SfwSensor *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_HISTORY
+ * ------------------------------------------------------------------------- */
+
+void   sfwsensor_set_history_size (SfwSensor *self, size_t count);
+size_t sfwsensor_history_size     (const SfwSensor *self);
+size_t sfwsensor_history_query    (const SfwSensor *self, uint64_t t_begin, uint64_t t_end, SfwSample *out, size_t max);
+size_t sfwsensor_history_query_xyz(const SfwSensor *self, uint64_t t_begin, uint64_t t_end, uint64_t *t, float *x, float *y, float *z, size_t max);
+bool   sfwsensor_history_nearest  (const SfwSensor *self, uint64_t t, SfwSample *out);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_FILTERS
+ * ------------------------------------------------------------------------- */
+
+bool sfwsensor_add_filter   (SfwSensor *self, SfwFilter *filter);
+void sfwsensor_clear_filters(SfwSensor *self);
+void sfwsensor_reset_filters(SfwSensor *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_RESAMPLING
+ * ------------------------------------------------------------------------- */
+
+bool   sfwsensor_set_resampler(SfwSensor *self, SfwResamplerMethod method, double rate_hz);
+double sfwsensor_resample_rate(const SfwSensor *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_STATISTICS
+ * ------------------------------------------------------------------------- */
+
+SfwStats *sfwsensor_add_stats   (SfwSensor *self, size_t channel, size_t count, uint64_t window_us);
+bool      sfwsensor_remove_stats(SfwSensor *self, SfwStats *stats);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_SPECTRUM
+ * ------------------------------------------------------------------------- */
+
+SfwSpectrum               *sfwsensor_set_spectrum(SfwSensor *self, size_t size, size_t hop);
+const SfwSpectrumFeatures *sfwsensor_spectrum    (const SfwSensor *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_DELIVERY
+ * ------------------------------------------------------------------------- */
+
+static bool     sfwsensor_threshold_passed(SfwSensor *self, const SfwSample *sample);
+static void     sfwsensor_threshold_reset (SfwSensor *self);
+void            sfwsensor_set_threshold   (SfwSensor *self, SfwSensorThreshold mode, double epsilon, double hysteresis);
+uint64_t        sfwsensor_suppressed      (const SfwSensor *self);
+void            sfwsensor_set_latest_only (SfwSensor *self, bool latest_only);
+uint64_t        sfwsensor_skipped         (const SfwSensor *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_QUEUE
+ * ------------------------------------------------------------------------- */
+
+static void     sfwsensor_queue_push       (SfwSensor *self, const SfwSample *sample);
+static gboolean sfwsensor_queue_dispatch_cb(gpointer aptr);
+static void     sfwsensor_queue_clear      (SfwSensor *self);
+void            sfwsensor_set_backpressure (SfwSensor *self, SfwSensorBackpressure policy, size_t queue_size, size_t high_water);
+size_t          sfwsensor_queued           (const SfwSensor *self);
+uint64_t        sfwsensor_dropped          (const SfwSensor *self);
+
 /* ------------------------------------------------------------------------- *
  * SFWSENSOR_SIGNALS
  * ------------------------------------------------------------------------- */
 
-static gulong sfwsensor_add_handler                (SfwSensor *self, SfwSensorSignal signo, SfwSensorHandler handler, gpointer aptr);
-gulong        sfwsensor_add_valid_changed_handler  (SfwSensor *self, SfwSensorHandler handler, gpointer aptr);
-gulong        sfwsensor_add_active_changed_handler (SfwSensor *self, SfwSensorHandler handler, gpointer aptr);
-gulong        sfwsensor_add_reading_changed_handler(SfwSensor *self, SfwSensorHandler handler, gpointer aptr);
-void          sfwsensor_remove_handler             (SfwSensor *self, gulong id);
-void          sfwsensor_remove_handler_at          (SfwSensor *self, gulong *pid);
-static void   sfwsensor_emit_signal                (SfwSensor *self, SfwSensorSignal signo);
+static gulong sfwsensor_add_handler                 (SfwSensor *self, SfwSensorSignal signo, SfwSensorHandler handler, gpointer aptr);
+gulong        sfwsensor_add_valid_changed_handler   (SfwSensor *self, SfwSensorHandler handler, gpointer aptr);
+gulong        sfwsensor_add_active_changed_handler  (SfwSensor *self, SfwSensorHandler handler, gpointer aptr);
+gulong        sfwsensor_add_reading_changed_handler (SfwSensor *self, SfwSensorHandler handler, gpointer aptr);
+gulong        sfwsensor_add_high_water_handler      (SfwSensor *self, SfwSensorHandler handler, gpointer aptr);
+gulong        sfwsensor_add_spectrum_changed_handler(SfwSensor *self, SfwSensorHandler handler, gpointer aptr);
+void          sfwsensor_remove_handler              (SfwSensor *self, gulong id);
+void          sfwsensor_remove_handler_at           (SfwSensor *self, gulong *pid);
+static void   sfwsensor_emit_signal                 (SfwSensor *self, SfwSensorSignal signo);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_CALLBACKS
+ * ------------------------------------------------------------------------- */
+
+guint       sfwsensor_add_reading_callback    (SfwSensor *self, SfwSensorReadingCallback callback, gpointer aptr);
+void        sfwsensor_remove_reading_callback (SfwSensor *self, guint id);
+static void sfwsensor_notify_reading          (SfwSensor *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_WORKER
+ * ------------------------------------------------------------------------- */
+
+static SfwSensorWorker *sfwsensor_worker_new      (SfwSensorBatchCallback callback, gpointer aptr);
+static SfwSensorWorker *sfwsensor_worker_ref      (SfwSensorWorker *worker);
+static void             sfwsensor_batch_free_list (SfwSensorBatch *batch);
+static void             sfwsensor_worker_unref    (SfwSensorWorker *worker);
+static void             sfwsensor_worker_cancel_at(SfwSensorWorker **pworker);
+static void             sfwsensor_worker_run_cb   (gpointer data, gpointer aptr);
+static void             sfwsensor_worker_add      (SfwSensor *self, const SfwReading *reading);
+static void             sfwsensor_worker_flush    (SfwSensor *self);
+bool                    sfwsensor_set_worker      (SfwSensor *self, SfwSensorBatchCallback callback, gpointer aptr);
 
 /* ------------------------------------------------------------------------- *
  * SFWSENSOR_ACCESSORS
@@ -277,6 +515,7 @@ static bool sfwsensor_stm_pending_get_properties(const SfwSensor *self);
 
 static gboolean sfwsensor_stm_socket_rx_unexpected    (GIOChannel *chn, GIOCondition cnd, gpointer aptr);
 static gboolean sfwsensor_stm_socket_rx_handshake     (GIOChannel *chn, GIOCondition cnd, gpointer aptr);
+static bool     sfwsensor_stm_socket_read_frame       (SfwSensor *self, uint32_t *pcnt);
 static gboolean sfwsensor_stm_socket_rx_reading       (GIOChannel *chn, GIOCondition cnd, gpointer aptr);
 static gboolean sfwsensor_stm_socket_tx_unexpected    (GIOChannel *chn, GIOCondition cnd, gpointer aptr);
 static gboolean sfwsensor_stm_socket_tx_handshake     (GIOChannel *chn, GIOCondition cnd, gpointer aptr);
@@ -297,9 +536,11 @@ G_DEFINE_TYPE_WITH_PRIVATE(SfwSensor, sfwsensor, G_TYPE_OBJECT)
 
 static const char * const sfwsensor_signal_name[SFWSENSOR_SIGNAL_COUNT] =
 {
-    [SFWSENSOR_SIGNAL_VALID_CHANGED]   = "sfwsensor-valid-changed",
-    [SFWSENSOR_SIGNAL_READING_CHANGED] = "sfwsensor-reading-changed",
-    [SFWSENSOR_SIGNAL_ACTIVE_CHANGED]  = "sfwsensor-active-changed",
+    [SFWSENSOR_SIGNAL_VALID_CHANGED]    = "sfwsensor-valid-changed",
+    [SFWSENSOR_SIGNAL_READING_CHANGED]  = "sfwsensor-reading-changed",
+    [SFWSENSOR_SIGNAL_ACTIVE_CHANGED]   = "sfwsensor-active-changed",
+    [SFWSENSOR_SIGNAL_HIGH_WATER]       = "sfwsensor-high-water",
+    [SFWSENSOR_SIGNAL_SPECTRUM_CHANGED] = "sfwsensor-spectrum-changed",
 };
 
 static guint sfwsensor_signal_id[SFWSENSOR_SIGNAL_COUNT] = { };
@@ -376,8 +617,42 @@ sfwsensor_init(SfwSensor *self)
     priv->sns_socket_rx_cb      = sfwsensor_stm_socket_rx_unexpected;
     priv->sns_reporting         = sfwreporting_new(self);
     priv->sns_reading.sensor_id = SFW_SENSOR_ID_INVALID;
+    priv->sns_recorder          = NULL;
+    priv->sns_replay            = NULL;
+    priv->sns_history           = NULL;
+    priv->sns_filters           = g_ptr_array_new_with_free_func(sfwfilter_delete_cb);
+    priv->sns_resampler         = NULL;
+    priv->sns_resampled_held    = false;
+    priv->sns_stats             = g_ptr_array_new_with_free_func(sfwstats_delete_cb);
+    priv->sns_spectrum          = NULL;
+
+    priv->sns_threshold            = SFW_SENSOR_THRESHOLD_NONE;
+    priv->sns_threshold_epsilon    = 0.0;
+    priv->sns_threshold_hysteresis = 0.0;
+    priv->sns_threshold_primed     = false;
+    priv->sns_suppressed           = 0;
+    priv->sns_latest_only          = false;
+    priv->sns_skipped              = 0;
+
+    priv->sns_backpressure           = SFW_SENSOR_BACKPRESSURE_NONE;
+    priv->sns_queue                  = NULL;
+    priv->sns_queue_capacity         = 0;
+    priv->sns_queue_size             = 0;
+    priv->sns_queue_high_water       = 0;
+    priv->sns_queue_head             = 0;
+    priv->sns_queue_count            = 0;
+    priv->sns_queue_above_high_water = false;
+    priv->sns_queue_id               = 0;
+    priv->sns_dropped                = 0;
+    priv->sns_socket_paused          = false;
     priv->sns_valid             = false;
 
+    memset(priv->sns_callbacks, 0, sizeof priv->sns_callbacks);
+    priv->sns_callback_count = 0;
+    priv->sns_callback_id    = 0;
+
+    priv->sns_worker = NULL;
+
     priv->sns_reporting_active_changed_id =
         sfwreporting_add_active_changed_handler(priv->sns_reporting,
                                                 sfwsensor_reporting_active_changed_cb,
@@ -398,10 +673,28 @@ sfwsensor_finalize(GObject *object)
 
     sfwreporting_unref_at(&priv->sns_reporting);
     sfwsensor_detach_from_plugin(self);
+    sfwrecorder_close_at(&priv->sns_recorder);
+    sfwreplay_close_at(&priv->sns_replay);
+    sfwhistory_close_at(&priv->sns_history);
+
+    g_ptr_array_unref(priv->sns_filters),
+        priv->sns_filters = NULL;
+    sfwresampler_delete_at(&priv->sns_resampler);
+    g_ptr_array_unref(priv->sns_stats),
+        priv->sns_stats = NULL;
+    sfwspectrum_delete_at(&priv->sns_spectrum);
+    sfwsensor_worker_cancel_at(&priv->sns_worker);
+
+    gutil_source_remove_at(&priv->sns_queue_id);
+    g_free(priv->sns_queue),
+        priv->sns_queue = NULL;
 
     g_hash_table_unref(priv->sns_properties),
         priv->sns_properties = NULL;
 
+    sfwtrace_forget(self);
+    sfwtrace_forget(priv);
+
     G_OBJECT_CLASS(sfwsensor_parent_class)->finalize(object);
 }
 
@@ -417,6 +710,31 @@ sfwsensor_new(SfwSensorId id)
     return self;
 }
 
+SfwSensor *
+sfwsensor_new_replay(const char *path)
+{
+    SfwSensor *self   = NULL;
+    SfwReplay *replay = sfwreplay_open(path);
+
+    if( replay ) {
+        self = g_object_new(SFWSENSOR_TYPE, NULL);
+        SfwSensorPrivate *priv = sfwsensor_priv(self);
+
+        /* Not backed by sensord -> no plugin, session or reporting */
+        sfwreporting_remove_handler(priv->sns_reporting, priv->sns_reporting_active_changed_id),
+            priv->sns_reporting_active_changed_id = 0;
+        sfwreporting_unref_at(&priv->sns_reporting);
+
+        priv->sns_reading.sensor_id = sfwreplay_sensor_id(replay);
+        priv->sns_replay            = replay;
+        sfwreplay_set_handler(replay, sfwsensor_replay_cb, self);
+        sfwsensor_set_valid(self, true);
+
+        sfwsensor_log_info("CREATED from %s", path);
+    }
+    return self;
+}
+
 SfwSensor *
 sfwsensor_ref(SfwSensor *self)
 {
@@ -456,90 +774,875 @@ void
 sfwsensor_start(SfwSensor *self)
 {
     SfwSensorPrivate *priv = sfwsensor_priv(self);
-    if( priv )
+    if( !priv ) {
+        /* Nop */
+    }
+    else if( priv->sns_replay ) {
+        sfwreplay_start(priv->sns_replay);
+        sfwsensor_eval_active(self);
+    }
+    else {
         sfwreporting_start(priv->sns_reporting);
+    }
+}
+
+void
+sfwsensor_stop(SfwSensor *self)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    if( !priv ) {
+        /* Nop */
+    }
+    else if( priv->sns_replay ) {
+        sfwreplay_stop(priv->sns_replay);
+        sfwsensor_eval_active(self);
+    }
+    else {
+        sfwreporting_stop(priv->sns_reporting);
+    }
+}
+
+void
+sfwsensor_set_datarate(SfwSensor *self, double datarate_hz)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    if( priv && priv->sns_reporting )
+        sfwreporting_set_datarate(priv->sns_reporting, datarate_hz);
+}
+
+void
+sfwsensor_set_alwayson(SfwSensor *self, bool alwayson)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    if( priv && priv->sns_reporting )
+        sfwreporting_set_override(priv->sns_reporting, alwayson);
+}
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_VALID
+ * ------------------------------------------------------------------------- */
+
+bool
+sfwsensor_is_valid(const SfwSensor *self)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    return priv ? priv->sns_valid : false;
+}
+
+static void
+sfwsensor_set_valid(SfwSensor *self, bool valid)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    if( priv && priv->sns_valid != valid ) {
+        sfwsensor_log_info("valid: %s -> %s",
+                           priv->sns_valid ? "true" : "false",
+                           valid           ? "true" : "false");
+        priv->sns_valid = valid;
+        sfwsensor_emit_signal(self, SFWSENSOR_SIGNAL_VALID_CHANGED);
+    }
+}
+
+bool
+sfwsensor_is_active(const SfwSensor *self)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    return priv ? priv->sns_active : false;
+}
+
+static void
+sfwsensor_eval_active(SfwSensor *self)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    if( priv ) {
+        bool active = (priv->sns_replay
+                       ? sfwreplay_is_running(priv->sns_replay)
+                       : sfwreporting_is_active(priv->sns_reporting));
+        if( priv->sns_active != active ) {
+            sfwsensor_log_info("active: %s -> %s",
+                               priv->sns_active ? "true" : "false",
+                               active           ? "true" : "false");
+            priv->sns_active = active;
+            if( active ) {
+                sfwsensor_reset_filters(self);
+                sfwresampler_reset(priv->sns_resampler);
+                sfwspectrum_reset(priv->sns_spectrum);
+                sfwsensor_threshold_reset(self);
+            }
+            else {
+                sfwsensor_queue_clear(self);
+            }
+            sfwsensor_emit_signal(self, SFWSENSOR_SIGNAL_ACTIVE_CHANGED);
+        }
+    }
+}
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_READING
+ * ------------------------------------------------------------------------- */
+
+SfwReading *
+sfwsensor_reading(SfwSensor *self)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    return priv ? &priv->sns_reading : NULL;
+}
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_FRAME
+ * ------------------------------------------------------------------------- */
+
+static void
+sfwsensor_deliver_sample(SfwSensor *self, const SfwSample *sample, bool final)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+
+    priv->sns_reading.sample = *sample;
+    sfwhistory_add(priv->sns_history, &priv->sns_reading.sample);
+    for( guint i = 0; i < priv->sns_stats->len; ++i )
+        sfwstats_add(g_ptr_array_index(priv->sns_stats, i), &priv->sns_reading.sample);
+    if( sfwspectrum_add(priv->sns_spectrum, &priv->sns_reading.sample) )
+        sfwsensor_emit_signal(self, SFWSENSOR_SIGNAL_SPECTRUM_CHANGED);
+
+    /* In latest only mode, deliver just the newest sample */
+    if( priv->sns_latest_only && !final ) {
+        priv->sns_skipped++;
+        goto EXIT;
+    }
+
+    /* Suppressed readings update cached state only */
+    if( !sfwsensor_threshold_passed(self, &priv->sns_reading.sample) ) {
+        priv->sns_suppressed++;
+        goto EXIT;
+    }
+
+    if( priv->sns_backpressure != SFW_SENSOR_BACKPRESSURE_NONE ) {
+        sfwsensor_queue_push(self, &priv->sns_reading.sample);
+        goto EXIT;
+    }
+
+    sfwsensor_notify_reading(self);
+
+EXIT:
+    return;
+}
+
+static void
+sfwsensor_handle_frame(SfwSensor *self, int64_t arrival, uint32_t cnt,
+                       const void *data, bool deliver)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    const uint8_t    *pos  = data;
+    const size_t      blk  = sfwsensorid_sample_size(priv->sns_reading.sensor_id);
+
+    /* Store frame as-is, before normalization */
+    if( priv->sns_recorder )
+        sfwrecorder_frame(priv->sns_recorder, arrival, cnt, data);
+
+    /* Replayed frames are not limited to SFWSENSOR_FRAME_MAX */
+    for( uint32_t done = 0; done < cnt; ) {
+        uint32_t todo = MIN(cnt - done, SFWSENSOR_FRAME_MAX);
+
+        /* Unpack to sample array and normalize all at once */
+        for( uint32_t i = 0; i < todo; ++i, pos += blk )
+            memcpy(&priv->sns_samples[i], pos, blk);
+        sfwsample_normalize(priv->sns_reading.sensor_id, priv->sns_samples, todo);
+        for( guint k = 0; k < priv->sns_filters->len; ++k )
+            sfwfilter_process(g_ptr_array_index(priv->sns_filters, k),
+                              priv->sns_samples, todo);
+
+        for( uint32_t i = 0; i < todo; ++i ) {
+            if( !sfwsensor_is_active(self) ) {
+                priv->sns_reading.sample = priv->sns_samples[i];
+                sfwsensor_log_debug("IGNORED[%"PRIu32"]: %s", done + i,
+                                    sfwreading_repr(&priv->sns_reading));
+                continue;
+            }
+
+            if( !priv->sns_resampler ) {
+                bool final = deliver && done + i + 1 == cnt;
+                sfwsensor_deliver_sample(self, &priv->sns_samples[i], final);
+                continue;
+            }
+
+            /* The latest resampled output is held back, so that it
+             * can be delivered as final after all input is consumed;
+             * the last inputs do not necessarily produce any output */
+            SfwSample next;
+            sfwresampler_push(priv->sns_resampler, &priv->sns_samples[i]);
+            while( priv->sns_resampler &&
+                   sfwresampler_pull(priv->sns_resampler, &next) ) {
+                if( priv->sns_resampled_held )
+                    sfwsensor_deliver_sample(self, &priv->sns_resampled, false);
+                priv->sns_resampled      = next;
+                priv->sns_resampled_held = true;
+            }
+        }
+        done += todo;
+    }
+
+    /* Held output is carried over frames drained in latest only mode */
+    if( deliver && priv->sns_resampled_held ) {
+        priv->sns_resampled_held = false;
+        if( priv->sns_resampler && sfwsensor_is_active(self) )
+            sfwsensor_deliver_sample(self, &priv->sns_resampled, true);
+    }
+
+    sfwsensor_worker_flush(self);
+}
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_REPLAY
+ * ------------------------------------------------------------------------- */
+
+static void
+sfwsensor_replay_cb(SfwReplay *replay, const SfwRecorderFrame *frame,
+                    const void *data, gpointer aptr)
+{
+    (void)replay;
+
+    SfwSensor *self = sfwsensor_ref(aptr);
+    if( frame )
+        sfwsensor_handle_frame(self, frame->arrival, frame->count, data, true);
+    else
+        sfwsensor_eval_active(self);
+    sfwsensor_unref(self);
+}
+
+bool
+sfwsensor_is_replay(const SfwSensor *self)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    return priv && priv->sns_replay;
+}
+
+void
+sfwsensor_set_replay_speed(SfwSensor *self, double speed)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    if( priv )
+        sfwreplay_set_speed(priv->sns_replay, speed);
+}
+
+void
+sfwsensor_rewind_replay(SfwSensor *self)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    if( priv )
+        sfwreplay_rewind(priv->sns_replay);
+}
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_RECORDING
+ * ------------------------------------------------------------------------- */
+
+bool
+sfwsensor_start_recording(SfwSensor *self, const char *path)
+{
+    bool              ack  = false;
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    if( priv ) {
+        sfwsensor_stop_recording(self);
+        priv->sns_recorder = sfwrecorder_open(path, priv->sns_reading.sensor_id);
+        ack = (priv->sns_recorder != NULL);
+    }
+    return ack;
+}
+
+void
+sfwsensor_stop_recording(SfwSensor *self)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    if( priv )
+        sfwrecorder_close_at(&priv->sns_recorder);
+}
+
+bool
+sfwsensor_is_recording(const SfwSensor *self)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    return priv && priv->sns_recorder;
+}
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_HISTORY
+ * ------------------------------------------------------------------------- */
+
+/** Set number of delivered readings to retain for later lookups
+ *
+ * Changing the size discards already collected history.
+ * Zero count disables history collection.
+ */
+void
+sfwsensor_set_history_size(SfwSensor *self, size_t count)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    if( priv && sfwhistory_capacity(priv->sns_history) != count ) {
+        sfwhistory_close_at(&priv->sns_history);
+        priv->sns_history = sfwhistory_open(count);
+    }
+}
+
+size_t
+sfwsensor_history_size(const SfwSensor *self)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    return priv ? sfwhistory_capacity(priv->sns_history) : 0;
+}
+
+/** Get retained readings with t_begin <= timestamp <= t_end
+ *
+ * @return number of samples stored to out, oldest first
+ */
+size_t
+sfwsensor_history_query(const SfwSensor *self, uint64_t t_begin,
+                        uint64_t t_end, SfwSample *out, size_t max)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    return priv ? sfwhistory_query(priv->sns_history, t_begin, t_end, out, max) : 0;
+}
+
+/** Get retained xyz readings with t_begin <= timestamp <= t_end
+ *
+ * Timestamps and channel values are stored into separate arrays,
+ * any of which can be NULL. Channel arrays that are 16 byte aligned
+ * are filled using aligned vector stores.
+ *
+ * @return number of samples stored, oldest first
+ */
+size_t
+sfwsensor_history_query_xyz(const SfwSensor *self, uint64_t t_begin,
+                            uint64_t t_end, uint64_t *t, float *x,
+                            float *y, float *z, size_t max)
+{
+    size_t            cnt  = 0;
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    if( priv ) {
+        if( !sfwsensorid_is_xyz(priv->sns_reading.sensor_id) )
+            sfwsensor_log_warning("does not have xyz data");
+        else
+            cnt = sfwhistory_query_xyz(priv->sns_history, t_begin, t_end,
+                                       t, x, y, z, max);
+    }
+    return cnt;
+}
+
+/** Get retained reading with timestamp closest to t
+ *
+ * @return true if sample was stored to out, false if there is no history
+ */
+bool
+sfwsensor_history_nearest(const SfwSensor *self, uint64_t t, SfwSample *out)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    return priv && sfwhistory_nearest(priv->sns_history, t, out);
+}
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_FILTERS
+ * ------------------------------------------------------------------------- */
+
+/** Append filter stage to processing chain
+ *
+ * Filters are applied to normalized readings before they are
+ * delivered, in the order they were added. Ownership of the filter
+ * is transferred to the sensor, also on failure.
+ *
+ * @return true if filter was added, false otherwise
+ */
+bool
+sfwsensor_add_filter(SfwSensor *self, SfwFilter *filter)
+{
+    bool              ack  = false;
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+
+    if( !priv || !filter )
+        goto EXIT;
+
+    if( !sfwsensorid_is_xyz(priv->sns_reading.sensor_id) ) {
+        sfwsensor_log_warning("%s filter not applicable; no xyz data",
+                              sfwfilter_name(filter));
+        goto EXIT;
+    }
+
+    sfwsensor_log_debug("%s filter added", sfwfilter_name(filter));
+    g_ptr_array_add(priv->sns_filters, filter), filter = NULL;
+    ack = true;
+
+EXIT:
+    sfwfilter_delete(filter);
+    return ack;
+}
+
+void
+sfwsensor_clear_filters(SfwSensor *self)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    if( priv )
+        g_ptr_array_set_size(priv->sns_filters, 0);
+}
+
+/** Make filters forget history, e.g. after a gap in data
+ */
+void
+sfwsensor_reset_filters(SfwSensor *self)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    if( priv ) {
+        for( guint i = 0; i < priv->sns_filters->len; ++i )
+            sfwfilter_reset(g_ptr_array_index(priv->sns_filters, i));
+    }
+}
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_RESAMPLING
+ * ------------------------------------------------------------------------- */
+
+/** Deliver readings at fixed rate
+ *
+ * Readings are interpolated to timestamps on a fixed grid after
+ * filtering, and the rest of delivery processing is applied to
+ * the resampled readings.
+ *
+ * @param method   interpolation method
+ * @param rate_hz  output rate, or zero to disable resampling
+ *
+ * @return true if resampling was configured, false otherwise
+ */
+bool
+sfwsensor_set_resampler(SfwSensor *self, SfwResamplerMethod method,
+                        double rate_hz)
+{
+    bool              ack  = false;
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+
+    if( !priv )
+        goto EXIT;
+
+    sfwresampler_delete_at(&priv->sns_resampler);
+    priv->sns_resampled_held = false;
+
+    if( rate_hz <= 0.0 ) {
+        ack = true;
+        goto EXIT;
+    }
+
+    if( !sfwsensorid_is_xyz(priv->sns_reading.sensor_id) ) {
+        sfwsensor_log_warning("resampling not applicable; no xyz data");
+        goto EXIT;
+    }
+
+    if( !(priv->sns_resampler = sfwresampler_new(method, rate_hz)) )
+        goto EXIT;
+
+    sfwsensor_log_debug("resampling to %g Hz", rate_hz);
+    ack = true;
+
+EXIT:
+    return ack;
+}
+
+double
+sfwsensor_resample_rate(const SfwSensor *self)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    return priv ? sfwresampler_rate(priv->sns_resampler) : 0.0;
+}
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_STATISTICS
+ * ------------------------------------------------------------------------- */
+
+/** Start tracking sliding window statistics of a reading channel
+ *
+ * Statistics are updated from all readings received while the sensor
+ * is active, regardless of delivery policies.
+ *
+ * @param channel    value channel, or SFWSTATS_MAGNITUDE
+ * @param count      maximum number of readings in window, or zero
+ * @param window_us  maximum time span of window, or zero
+ *
+ * @return statistics owned by the sensor, or NULL on failure
+ */
+SfwStats *
+sfwsensor_add_stats(SfwSensor *self, size_t channel, size_t count,
+                    uint64_t window_us)
+{
+    SfwStats         *stats = NULL;
+    SfwSensorPrivate *priv  = sfwsensor_priv(self);
+
+    if( priv ) {
+        stats = sfwstats_new(priv->sns_reading.sensor_id, channel,
+                             count, window_us);
+        if( stats )
+            g_ptr_array_add(priv->sns_stats, stats);
+    }
+    return stats;
+}
+
+/** Stop tracking and release statistics
+ *
+ * @return true if stats belonged to the sensor and were released
+ */
+bool
+sfwsensor_remove_stats(SfwSensor *self, SfwStats *stats)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    return priv && stats && g_ptr_array_remove(priv->sns_stats, stats);
+}
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_SPECTRUM
+ * ------------------------------------------------------------------------- */
+
+/** Enable spectral analysis of readings
+ *
+ * Analysis runs on all readings received while the sensor is active,
+ * regardless of delivery policies, and spectrum changed signal is
+ * emitted after each analyzed frame.
+ *
+ * @param size  frame size, power of two, or zero to disable analysis
+ * @param hop   number of readings between frames
+ *
+ * @return analyzer owned by the sensor, for adding energy bands,
+ *         or NULL if analysis was disabled or could not be enabled
+ */
+SfwSpectrum *
+sfwsensor_set_spectrum(SfwSensor *self, size_t size, size_t hop)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+
+    if( !priv )
+        goto EXIT;
+
+    sfwspectrum_delete_at(&priv->sns_spectrum);
+
+    if( size == 0 )
+        goto EXIT;
+
+    if( !sfwsensorid_is_xyz(priv->sns_reading.sensor_id) ) {
+        sfwsensor_log_warning("spectrum not applicable; no xyz data");
+        goto EXIT;
+    }
+
+    if( (priv->sns_spectrum = sfwspectrum_new(size, hop)) )
+        sfwsensor_log_debug("spectrum size=%zu hop=%zu", size, hop);
+
+EXIT:
+    return priv ? priv->sns_spectrum : NULL;
+}
+
+/** Get features from the latest analyzed frame
+ *
+ * @return features, or NULL if spectral analysis is not enabled
+ */
+const SfwSpectrumFeatures *
+sfwsensor_spectrum(const SfwSensor *self)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    return priv ? sfwspectrum_features(priv->sns_spectrum) : NULL;
+}
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_DELIVERY
+ * ------------------------------------------------------------------------- */
+
+/** Check whether sample differs enough from the last delivered one
+ *
+ * Updates reference values when sample is to be delivered.
+ */
+static bool
+sfwsensor_threshold_passed(SfwSensor *self, const SfwSample *sample)
+{
+    SfwSensorPrivate *priv   = sfwsensor_priv(self);
+    SfwSensorId       id     = priv->sns_reading.sensor_id;
+    size_t            cnt    = sfwsensorid_channel_count(id);
+    bool              passed = false;
+    double            val[SFW_SAMPLE_CHANNELS_MAX];
+
+    if( priv->sns_threshold == SFW_SENSOR_THRESHOLD_NONE )
+        return true;
+
+    for( size_t ch = 0; ch < cnt; ++ch ) {
+        val[ch] = sfwsample_channel(id, sample, ch);
+
+        if( !priv->sns_threshold_primed ) {
+            passed = true;
+            continue;
+        }
+
+        double ref   = priv->sns_threshold_ref[ch];
+        double delta = val[ch] - ref;
+        if( delta == 0.0 )
+            continue;
+
+        double limit = 0.0;
+        double hyst  = 0.0;
+        switch( priv->sns_threshold ) {
+        case SFW_SENSOR_THRESHOLD_ABSOLUTE:
+            limit = priv->sns_threshold_epsilon;
+            hyst  = priv->sns_threshold_hysteresis;
+            break;
+        case SFW_SENSOR_THRESHOLD_RELATIVE:
+            limit = priv->sns_threshold_epsilon * fabs(ref);
+            hyst  = priv->sns_threshold_hysteresis * fabs(ref);
+            break;
+        default:
+            hyst  = priv->sns_threshold_hysteresis;
+            break;
+        }
+
+        /* Changing direction requires crossing the hysteresis band too */
+        int dir = (delta > 0.0) ? 1 : -1;
+        if( priv->sns_threshold_dir[ch] && priv->sns_threshold_dir[ch] != dir )
+            limit += hyst;
+
+        if( fabs(delta) > limit )
+            passed = true;
+    }
+
+    if( passed ) {
+        for( size_t ch = 0; ch < cnt; ++ch ) {
+            double delta = val[ch] - priv->sns_threshold_ref[ch];
+            if( priv->sns_threshold_primed && delta != 0.0 )
+                priv->sns_threshold_dir[ch] = (delta > 0.0) ? 1 : -1;
+            priv->sns_threshold_ref[ch] = val[ch];
+        }
+        priv->sns_threshold_primed = true;
+    }
+
+    return passed;
+}
+
+static void
+sfwsensor_threshold_reset(SfwSensor *self)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    priv->sns_threshold_primed = false;
+    memset(priv->sns_threshold_dir, 0, sizeof priv->sns_threshold_dir);
+}
+
+/** Set change threshold for reading delivery
+ *
+ * @param mode        threshold mode
+ * @param epsilon     minimum change for ABSOLUTE / RELATIVE modes
+ * @param hysteresis  additional change needed when value turns
+ *                    direction, absolute or relative according to mode
+ */
+void
+sfwsensor_set_threshold(SfwSensor *self, SfwSensorThreshold mode,
+                        double epsilon, double hysteresis)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    if( priv ) {
+        priv->sns_threshold            = mode;
+        priv->sns_threshold_epsilon    = fabs(epsilon);
+        priv->sns_threshold_hysteresis = fabs(hysteresis);
+        sfwsensor_threshold_reset(self);
+    }
 }
 
-void
-sfwsensor_stop(SfwSensor *self)
+/** Get number of readings not delivered due to delivery policy
+ */
+uint64_t
+sfwsensor_suppressed(const SfwSensor *self)
 {
     SfwSensorPrivate *priv = sfwsensor_priv(self);
-    if( priv )
-        sfwreporting_stop(priv->sns_reporting);
+    return priv ? priv->sns_suppressed : 0;
 }
 
+/** Set latest only delivery mode
+ *
+ * When enabled, all frames queued in the data socket are consumed on
+ * each wakeup, but reading changed signal is emitted only for the
+ * newest sample. Skipped samples still go to recording and history.
+ */
 void
-sfwsensor_set_datarate(SfwSensor *self, double datarate_hz)
+sfwsensor_set_latest_only(SfwSensor *self, bool latest_only)
 {
     SfwSensorPrivate *priv = sfwsensor_priv(self);
     if( priv )
-        sfwreporting_set_datarate(priv->sns_reporting, datarate_hz);
+        priv->sns_latest_only = latest_only;
 }
 
-void
-sfwsensor_set_alwayson(SfwSensor *self, bool alwayson)
+/** Get number of samples skipped due to latest only mode
+ */
+uint64_t
+sfwsensor_skipped(const SfwSensor *self)
 {
     SfwSensorPrivate *priv = sfwsensor_priv(self);
-    if( priv )
-        sfwreporting_set_override(priv->sns_reporting, alwayson);
+    return priv ? priv->sns_skipped : 0;
 }
 
 /* ------------------------------------------------------------------------- *
- * SFWSENSOR_VALID
+ * SFWSENSOR_QUEUE
  * ------------------------------------------------------------------------- */
 
-bool
-sfwsensor_is_valid(const SfwSensor *self)
+static void
+sfwsensor_queue_push(SfwSensor *self, const SfwSample *sample)
 {
     SfwSensorPrivate *priv = sfwsensor_priv(self);
-    return priv ? priv->sns_valid : false;
+
+    if( priv->sns_queue_count >= priv->sns_queue_size ) {
+        switch( priv->sns_backpressure ) {
+        case SFW_SENSOR_BACKPRESSURE_DROP_NEWEST:
+            priv->sns_dropped++;
+            return;
+        case SFW_SENSOR_BACKPRESSURE_STOP_READING:
+            /* Use slack for finishing the current frame; replay
+             * can't be held back and overflows as drop oldest */
+            if( priv->sns_queue_count < priv->sns_queue_capacity )
+                break;
+            /* fall through */
+        default:
+            priv->sns_dropped++;
+            priv->sns_queue_count--;
+            if( ++priv->sns_queue_head == priv->sns_queue_capacity )
+                priv->sns_queue_head = 0;
+            break;
+        }
+    }
+
+    size_t slot = priv->sns_queue_head + priv->sns_queue_count++;
+    if( slot >= priv->sns_queue_capacity )
+        slot -= priv->sns_queue_capacity;
+    priv->sns_queue[slot] = *sample;
+
+    if( priv->sns_backpressure == SFW_SENSOR_BACKPRESSURE_STOP_READING &&
+        priv->sns_queue_count >= priv->sns_queue_size &&
+        priv->sns_socket_rx_id && !priv->sns_socket_paused ) {
+        sfwsensor_log_debug("queue full; stop reading");
+        priv->sns_socket_paused = true;
+    }
+
+    if( !priv->sns_queue_id )
+        priv->sns_queue_id = g_idle_add(sfwsensor_queue_dispatch_cb, self);
+
+    if( priv->sns_queue_count >= priv->sns_queue_high_water &&
+        !priv->sns_queue_above_high_water ) {
+        priv->sns_queue_above_high_water = true;
+        sfwsensor_log_debug("queue high water: %zu", priv->sns_queue_count);
+        sfwsensor_emit_signal(self, SFWSENSOR_SIGNAL_HIGH_WATER);
+    }
 }
 
-static void
-sfwsensor_set_valid(SfwSensor *self, bool valid)
+static gboolean
+sfwsensor_queue_dispatch_cb(gpointer aptr)
 {
-    SfwSensorPrivate *priv = sfwsensor_priv(self);
-    if( priv && priv->sns_valid != valid ) {
-        sfwsensor_log_info("valid: %s -> %s",
-                           priv->sns_valid ? "true" : "false",
-                           valid           ? "true" : "false");
-        priv->sns_valid = valid;
-        sfwsensor_emit_signal(self, SFWSENSOR_SIGNAL_VALID_CHANGED);
+    SfwSensor        *self   = sfwsensor_ref(aptr);
+    SfwSensorPrivate *priv   = sfwsensor_priv(self);
+    gboolean          result = G_SOURCE_CONTINUE;
+
+    for( int i = 0; i < SFWSENSOR_QUEUE_BATCH; ++i ) {
+        if( !priv->sns_queue_count || !sfwsensor_is_active(self) )
+            break;
+        priv->sns_reading.sample = priv->sns_queue[priv->sns_queue_head];
+        priv->sns_queue_count--;
+        if( ++priv->sns_queue_head == priv->sns_queue_capacity )
+            priv->sns_queue_head = 0;
+
+        sfwsensor_notify_reading(self);
+    }
+    sfwsensor_worker_flush(self);
+
+    if( priv->sns_queue_count < priv->sns_queue_high_water )
+        priv->sns_queue_above_high_water = false;
+
+    /* Resume reading when the queue has drained to half */
+    if( priv->sns_socket_paused &&
+        priv->sns_queue_count <= priv->sns_queue_size / 2 ) {
+        priv->sns_socket_paused = false;
+        if( priv->sns_socket_fd != -1 && !priv->sns_socket_rx_id ) {
+            sfwsensor_log_debug("queue drained; resume reading");
+            priv->sns_socket_rx_id =
+                socket_add_notify(priv->sns_socket_fd, false, G_IO_IN,
+                                  sfwsensor_stm_socket_rx_cb, self);
+        }
+    }
+
+    if( !priv->sns_queue_count || !sfwsensor_is_active(self) ) {
+        priv->sns_queue_id = 0;
+        result = G_SOURCE_REMOVE;
     }
+
+    sfwsensor_unref(self);
+    return result;
 }
 
-bool
-sfwsensor_is_active(const SfwSensor *self)
+static void
+sfwsensor_queue_clear(SfwSensor *self)
 {
     SfwSensorPrivate *priv = sfwsensor_priv(self);
-    return priv ? priv->sns_active : false;
+    priv->sns_queue_head             = 0;
+    priv->sns_queue_count            = 0;
+    priv->sns_queue_above_high_water = false;
 }
 
-static void
-sfwsensor_eval_active(SfwSensor *self)
+/** Select policy for readings that arrive faster than they are handled
+ *
+ * @param policy      backpressure policy
+ * @param queue_size  maximum number of queued readings, or zero for default
+ * @param high_water  queue fill level at which high water signal is
+ *                    emitted, or zero for queue size
+ */
+void
+sfwsensor_set_backpressure(SfwSensor *self, SfwSensorBackpressure policy,
+                           size_t queue_size, size_t high_water)
 {
     SfwSensorPrivate *priv = sfwsensor_priv(self);
-    if( priv ) {
-        bool active = sfwreporting_is_active(priv->sns_reporting);
-        if( priv->sns_active != active ) {
-            sfwsensor_log_info("active: %s -> %s",
-                               priv->sns_active ? "true" : "false",
-                               active           ? "true" : "false");
-            priv->sns_active = active;
-            sfwsensor_emit_signal(self, SFWSENSOR_SIGNAL_ACTIVE_CHANGED);
-        }
+    if( !priv )
+        goto EXIT;
+
+    if( queue_size < 1 )
+        queue_size = SFWSENSOR_QUEUE_DEFAULT;
+    if( high_water < 1 || high_water > queue_size )
+        high_water = queue_size;
+
+    gutil_source_remove_at(&priv->sns_queue_id);
+    g_free(priv->sns_queue), priv->sns_queue = NULL;
+    sfwsensor_queue_clear(self);
+
+    priv->sns_backpressure     = policy;
+    priv->sns_queue_size       = 0;
+    priv->sns_queue_capacity   = 0;
+    priv->sns_queue_high_water = 0;
+
+    if( policy != SFW_SENSOR_BACKPRESSURE_NONE ) {
+        /* Leave room for one full frame after reading is stopped */
+        priv->sns_queue_size       = queue_size;
+        priv->sns_queue_capacity   = queue_size + SFWSENSOR_FRAME_MAX;
+        priv->sns_queue_high_water = high_water;
+        priv->sns_queue            = g_new(SfwSample, priv->sns_queue_capacity);
     }
+
+    /* Reading might have been stopped under previous policy */
+    if( priv->sns_socket_paused ) {
+        priv->sns_socket_paused = false;
+        if( priv->sns_socket_fd != -1 && !priv->sns_socket_rx_id )
+            priv->sns_socket_rx_id =
+                socket_add_notify(priv->sns_socket_fd, false, G_IO_IN,
+                                  sfwsensor_stm_socket_rx_cb, self);
+    }
+
+EXIT:
+    return;
 }
 
-/* ------------------------------------------------------------------------- *
- * SFWSENSOR_READING
- * ------------------------------------------------------------------------- */
+/** Get number of readings waiting to be delivered
+ */
+size_t
+sfwsensor_queued(const SfwSensor *self)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    return priv ? priv->sns_queue_count : 0;
+}
 
-SfwReading *
-sfwsensor_reading(SfwSensor *self)
+/** Get number of readings discarded due to full reading queue
+ */
+uint64_t
+sfwsensor_dropped(const SfwSensor *self)
 {
     SfwSensorPrivate *priv = sfwsensor_priv(self);
-    return priv ? &priv->sns_reading : NULL;
+    return priv ? priv->sns_dropped : 0;
 }
 
 /* ------------------------------------------------------------------------- *
@@ -583,6 +1686,33 @@ sfwsensor_add_reading_changed_handler(SfwSensor *self,
                                  handler, aptr);
 }
 
+/** Add handler for reading queue reaching high water mark
+ *
+ * Emitted when the number of queued readings rises to the high
+ * water mark set via sfwsensor_set_backpressure().
+ */
+gulong
+sfwsensor_add_high_water_handler(SfwSensor *self, SfwSensorHandler handler,
+                                 gpointer aptr)
+{
+    return sfwsensor_add_handler(self, SFWSENSOR_SIGNAL_HIGH_WATER,
+                                 handler, aptr);
+}
+
+/** Add handler for new spectral features
+ *
+ * Emitted after each analysis frame configured via
+ * sfwsensor_set_spectrum(), see sfwsensor_spectrum().
+ */
+gulong
+sfwsensor_add_spectrum_changed_handler(SfwSensor *self,
+                                       SfwSensorHandler handler,
+                                       gpointer aptr)
+{
+    return sfwsensor_add_handler(self, SFWSENSOR_SIGNAL_SPECTRUM_CHANGED,
+                                 handler, aptr);
+}
+
 void
 sfwsensor_remove_handler(SfwSensor *self, gulong id)
 {
@@ -607,6 +1737,319 @@ sfwsensor_emit_signal(SfwSensor *self, SfwSensorSignal signo)
     g_signal_emit(self, sfwsensor_signal_id[signo], 0);
 }
 
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_CALLBACKS
+ * ------------------------------------------------------------------------- */
+
+/** Add callback to be invoked directly for each delivered reading
+ *
+ * Lightweight alternative to sfwsensor_add_reading_changed_handler():
+ * callbacks are called from a plain array before reading changed
+ * signal is emitted, and get the reading as an argument.
+ *
+ * @return callback id, or zero if SFWSENSOR_CALLBACKS_MAX callbacks
+ *         already exist
+ */
+guint
+sfwsensor_add_reading_callback(SfwSensor *self,
+                               SfwSensorReadingCallback callback,
+                               gpointer aptr)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    guint             id   = 0;
+
+    if( !priv || !callback )
+        goto EXIT;
+
+    /* Reuse slots released by sfwsensor_remove_reading_callback() */
+    size_t slot = 0;
+    while( slot < priv->sns_callback_count && priv->sns_callbacks[slot].cb_func )
+        ++slot;
+    if( slot == SFWSENSOR_CALLBACKS_MAX ) {
+        sfwsensor_log_warning("too many reading callbacks");
+        goto EXIT;
+    }
+
+    if( ++priv->sns_callback_id == 0 )
+        ++priv->sns_callback_id;
+    id = priv->sns_callback_id;
+
+    priv->sns_callbacks[slot].cb_id   = id;
+    priv->sns_callbacks[slot].cb_func = callback;
+    priv->sns_callbacks[slot].cb_aptr = aptr;
+    if( slot == priv->sns_callback_count )
+        priv->sns_callback_count++;
+
+EXIT:
+    sfwsensor_log_debug("callback id=%u", id);
+    return id;
+}
+
+/** Remove callback added with sfwsensor_add_reading_callback()
+ *
+ * Can be called also from within the callback itself.
+ */
+void
+sfwsensor_remove_reading_callback(SfwSensor *self, guint id)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+
+    if( !priv || !id )
+        goto EXIT;
+
+    for( size_t i = 0; i < priv->sns_callback_count; ++i ) {
+        if( priv->sns_callbacks[i].cb_id == id ) {
+            sfwsensor_log_debug("callback id=%u", id);
+            priv->sns_callbacks[i].cb_id   = 0;
+            priv->sns_callbacks[i].cb_func = NULL;
+            priv->sns_callbacks[i].cb_aptr = NULL;
+            break;
+        }
+    }
+
+    /* Trim released slots from the end */
+    while( priv->sns_callback_count > 0 &&
+           !priv->sns_callbacks[priv->sns_callback_count - 1].cb_func )
+        priv->sns_callback_count--;
+
+EXIT:
+    return;
+}
+
+/** Deliver current reading to direct callbacks and signal handlers
+ */
+static void
+sfwsensor_notify_reading(SfwSensor *self)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+
+    sfwsensor_trace_data(SFWTRACE_BEGIN, "reading-changed", 0);
+    for( size_t i = 0; i < priv->sns_callback_count; ++i ) {
+        const SfwSensorCallback *cb = &priv->sns_callbacks[i];
+        if( cb->cb_func )
+            cb->cb_func(self, &priv->sns_reading, cb->cb_aptr);
+    }
+    if( priv->sns_worker )
+        sfwsensor_worker_add(self, &priv->sns_reading);
+    sfwsensor_emit_signal(self, SFWSENSOR_SIGNAL_READING_CHANGED);
+    sfwsensor_trace_data(SFWTRACE_END, "reading-changed", 0);
+}
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_WORKER
+ * ------------------------------------------------------------------------- */
+
+static GThreadPool *sfwsensor_worker_pool = NULL;
+
+static SfwSensorWorker *
+sfwsensor_worker_new(SfwSensorBatchCallback callback, gpointer aptr)
+{
+    SfwSensorWorker *worker = g_new0(SfwSensorWorker, 1);
+    worker->wrk_refcount = 1;
+    g_mutex_init(&worker->wrk_mutex);
+    g_cond_init(&worker->wrk_cond);
+    worker->wrk_callback = callback;
+    worker->wrk_aptr     = aptr;
+    return worker;
+}
+
+static SfwSensorWorker *
+sfwsensor_worker_ref(SfwSensorWorker *worker)
+{
+    g_atomic_int_inc(&worker->wrk_refcount);
+    return worker;
+}
+
+static void
+sfwsensor_batch_free_list(SfwSensorBatch *batch)
+{
+    while( batch ) {
+        SfwSensorBatch *next = batch->bat_next;
+        g_free(batch);
+        batch = next;
+    }
+}
+
+static void
+sfwsensor_worker_unref(SfwSensorWorker *worker)
+{
+    if( worker && g_atomic_int_dec_and_test(&worker->wrk_refcount) ) {
+        sfwsensor_batch_free_list(worker->wrk_head);
+        sfwsensor_batch_free_list(worker->wrk_spare);
+        g_free(worker->wrk_filling);
+        g_cond_clear(&worker->wrk_cond);
+        g_mutex_clear(&worker->wrk_mutex);
+        g_free(worker);
+    }
+}
+
+/** Stop delivery and release worker
+ *
+ * Queued batches are discarded. If the callback is running in a pool
+ * thread, waits for it to return, so that the callback is guaranteed
+ * not to be called after this.
+ */
+static void
+sfwsensor_worker_cancel_at(SfwSensorWorker **pworker)
+{
+    SfwSensorWorker *worker = *pworker;
+    if( worker ) {
+        *pworker = NULL;
+        g_mutex_lock(&worker->wrk_mutex);
+        worker->wrk_cancelled = true;
+        while( worker->wrk_running )
+            g_cond_wait(&worker->wrk_cond, &worker->wrk_mutex);
+        g_mutex_unlock(&worker->wrk_mutex);
+        sfwsensor_worker_unref(worker);
+    }
+}
+
+/** Pool task: pass queued batches to callback in order
+ */
+static void
+sfwsensor_worker_run_cb(gpointer data, gpointer aptr)
+{
+    SfwSensorWorker *worker = data;
+    (void)aptr;
+
+    g_mutex_lock(&worker->wrk_mutex);
+    while( worker->wrk_head && !worker->wrk_cancelled ) {
+        SfwSensorBatch *batch = worker->wrk_head;
+        if( !(worker->wrk_head = batch->bat_next) )
+            worker->wrk_tail = NULL;
+        worker->wrk_pending--;
+        worker->wrk_running = true;
+        g_mutex_unlock(&worker->wrk_mutex);
+
+        worker->wrk_callback(batch->bat_readings, batch->bat_count,
+                             worker->wrk_aptr);
+
+        g_mutex_lock(&worker->wrk_mutex);
+        worker->wrk_running = false;
+        batch->bat_next     = worker->wrk_spare;
+        worker->wrk_spare   = batch;
+        g_cond_broadcast(&worker->wrk_cond);
+    }
+    worker->wrk_scheduled = false;
+    g_mutex_unlock(&worker->wrk_mutex);
+
+    sfwsensor_worker_unref(worker);
+}
+
+/** Append reading to the batch being filled
+ */
+static void
+sfwsensor_worker_add(SfwSensor *self, const SfwReading *reading)
+{
+    SfwSensorPrivate *priv   = sfwsensor_priv(self);
+    SfwSensorWorker  *worker = priv->sns_worker;
+
+    if( !worker->wrk_filling ) {
+        g_mutex_lock(&worker->wrk_mutex);
+        if( (worker->wrk_filling = worker->wrk_spare) )
+            worker->wrk_spare = worker->wrk_filling->bat_next;
+        g_mutex_unlock(&worker->wrk_mutex);
+        if( !worker->wrk_filling )
+            worker->wrk_filling = g_new(SfwSensorBatch, 1);
+        worker->wrk_filling->bat_next  = NULL;
+        worker->wrk_filling->bat_count = 0;
+    }
+
+    SfwSensorBatch *batch = worker->wrk_filling;
+    batch->bat_readings[batch->bat_count++] = *reading;
+    if( batch->bat_count == SFWSENSOR_BATCH_MAX )
+        sfwsensor_worker_flush(self);
+}
+
+/** Queue the batch being filled and schedule pool task if needed
+ */
+static void
+sfwsensor_worker_flush(SfwSensor *self)
+{
+    SfwSensorPrivate *priv   = sfwsensor_priv(self);
+    SfwSensorWorker  *worker = priv->sns_worker;
+    SfwSensorBatch   *batch  = worker ? worker->wrk_filling : NULL;
+
+    if( !batch || !batch->bat_count )
+        goto EXIT;
+
+    g_mutex_lock(&worker->wrk_mutex);
+    if( worker->wrk_pending >= SFWSENSOR_WORKER_PENDING_MAX ) {
+        /* Worker is not keeping up; discard and reuse the batch */
+        priv->sns_dropped += batch->bat_count;
+        batch->bat_count = 0;
+    }
+    else {
+        worker->wrk_filling = NULL;
+        if( worker->wrk_tail )
+            worker->wrk_tail->bat_next = batch;
+        else
+            worker->wrk_head = batch;
+        worker->wrk_tail = batch;
+        worker->wrk_pending++;
+        if( !worker->wrk_scheduled ) {
+            worker->wrk_scheduled = true;
+            g_thread_pool_push(sfwsensor_worker_pool,
+                               sfwsensor_worker_ref(worker), NULL);
+        }
+    }
+    g_mutex_unlock(&worker->wrk_mutex);
+
+EXIT:
+    return;
+}
+
+/** Set callback for receiving reading batches in worker threads
+ *
+ * Delivered readings are collected into batches in the main context
+ * and passed to the callback from a shared thread pool. Batches from
+ * one sensor are delivered in order, one at a time. The callback
+ * must not use the sensor object. If the callback falls behind,
+ * batches are discarded and counted in sfwsensor_dropped().
+ *
+ * Disabling waits for a running callback to return.
+ *
+ * @param callback  batch callback, or NULL to disable
+ * @param aptr      data to pass to callback
+ *
+ * @return true if worker delivery was set up, false otherwise
+ */
+bool
+sfwsensor_set_worker(SfwSensor *self, SfwSensorBatchCallback callback,
+                     gpointer aptr)
+{
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    bool              ack  = false;
+
+    if( !priv )
+        goto EXIT;
+
+    sfwsensor_worker_cancel_at(&priv->sns_worker);
+
+    if( !callback ) {
+        ack = true;
+        goto EXIT;
+    }
+
+    if( !sfwsensor_worker_pool ) {
+        GError *err = NULL;
+        sfwsensor_worker_pool =
+            g_thread_pool_new(sfwsensor_worker_run_cb, NULL,
+                              SFWSENSOR_WORKER_THREADS, FALSE, &err);
+        if( !sfwsensor_worker_pool ) {
+            sfwsensor_log_err("worker pool: %s", error_message(err));
+            g_clear_error(&err);
+            goto EXIT;
+        }
+    }
+
+    priv->sns_worker = sfwsensor_worker_new(callback, aptr);
+    ack = true;
+
+EXIT:
+    return ack;
+}
+
 /* ------------------------------------------------------------------------- *
  * SFWSENSOR_ACCESSORS
  * ------------------------------------------------------------------------- */
@@ -643,7 +2086,9 @@ sfwsensor_service(const SfwSensor *self)
 const char *
 sfwsensor_name(const SfwSensor *self)
 {
-    return sfwplugin_name(sfwsensor_plugin(self));
+    /* Note: Replay sensors do not have a plugin */
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    return sfwsensorid_name(priv ? priv->sns_reading.sensor_id : SFW_SENSOR_ID_INVALID);
 }
 
 const char *
@@ -732,6 +2177,7 @@ sfwsensor_stm_set_state(SfwSensor *self, SfwSensorState state)
                            sfwsensorstate_repr(state));
         sfwsensor_stm_leave_state(self);
         priv->sns_state = state;
+        sfwsensor_trace_state(sfwsensorstate_repr(state));
         sfwsensor_stm_enter_state(self);
         sfwsensor_stm_eval_state_later(self);
     }
@@ -765,6 +2211,7 @@ sfwsensor_stm_enter_state(SfwSensor *self)
         sfwsensor_set_valid(self, true);
         break;
     case SFWSENSORSTATE_FAILED:
+        sfwlog_dump_flight_recorder();
         sfwsensor_stm_socket_disconnect(self);
         sfwsensor_stm_start_retry_delay(self);
         break;
@@ -939,7 +2386,8 @@ sfwsensor_stm_pending_retry_delay(const SfwSensor *self)
 static void
 sfwsensor_stm_request_session_cb(GObject *object, GAsyncResult *res, gpointer aptr)
 {
-    SfwSensor        *self       = aptr;
+    AsyncCall        *call       = aptr;
+    SfwSensor        *self       = call->ac_object;
     SfwSensorPrivate *priv       = sfwsensor_priv(self);
     GDBusConnection  *con        = G_DBUS_CONNECTION(object);
     GError           *err        = NULL;
@@ -951,6 +2399,9 @@ sfwsensor_stm_request_session_cb(GObject *object, GAsyncResult *res, gpointer ap
     else
         g_variant_get(rsp, "(i)", &session_id);
 
+    sfwsensor_trace_event(SFWTRACE_ASYNC_END, call->ac_what,
+                          (uintptr_t)call->ac_cancellable);
+
     if( cancellable_finish(&priv->sns_request_session_cancellable) ) {
         if( session_id == SESSION_ID_INVALID )
             sfwsensor_log_warning("failed to acquire sensor session");
@@ -962,6 +2413,7 @@ sfwsensor_stm_request_session_cb(GObject *object, GAsyncResult *res, gpointer ap
     gutil_variant_unref(rsp);
     g_clear_error(&err);
     sfwsensor_unref(self);
+    async_call_delete(call);
 }
 
 static void
@@ -976,6 +2428,8 @@ sfwsensor_stm_start_request_session(SfwSensor *self)
         SfwService       *service   = sfwsensor_service(self);
         GDBusConnection *connection = sfwservice_get_connection(service);
         cancellable_start(&priv->sns_request_session_cancellable);
+        sfwsensor_trace_event(SFWTRACE_ASYNC_BEGIN, SFWDBUS_MANAGER_METHOD_START_SESSION,
+                              (uintptr_t)priv->sns_request_session_cancellable);
         g_dbus_connection_call(connection,
                                SFWDBUS_SERVICE,
                                SFWDBUS_MANAGER_OBJECT,
@@ -987,7 +2441,9 @@ sfwsensor_stm_start_request_session(SfwSensor *self)
                                -1,
                                priv->sns_request_session_cancellable,
                                sfwsensor_stm_request_session_cb,
-                               sfwsensor_ref(self));
+                               async_call_new(sfwsensor_ref(self),
+                                              priv->sns_request_session_cancellable,
+                                              SFWDBUS_MANAGER_METHOD_START_SESSION));
     }
 }
 
@@ -1012,7 +2468,8 @@ sfwsensor_stm_pending_request_session(const SfwSensor *self)
 static void
 sfwsensor_stm_release_session_cb(GObject *object, GAsyncResult *res, gpointer aptr)
 {
-    SfwSensor        *self = aptr;
+    AsyncCall        *call = aptr;
+    SfwSensor        *self = call->ac_object;
     SfwSensorPrivate *priv = sfwsensor_priv(self);
     GDBusConnection *con   = G_DBUS_CONNECTION(object);
     gboolean         ack   = false;
@@ -1024,6 +2481,9 @@ sfwsensor_stm_release_session_cb(GObject *object, GAsyncResult *res, gpointer ap
     else
         g_variant_get(rsp, "(b)", &ack);
 
+    sfwsensor_trace_event(SFWTRACE_ASYNC_END, call->ac_what,
+                          (uintptr_t)call->ac_cancellable);
+
     if( cancellable_finish(&priv->sns_release_session_cancellable) ) {
         if( !ack )
             sfwsensor_log_warning("failed to release sensor session");
@@ -1033,6 +2493,7 @@ sfwsensor_stm_release_session_cb(GObject *object, GAsyncResult *res, gpointer ap
     g_clear_error(&err);
     gutil_variant_unref(rsp);
     sfwsensor_unref(self);
+    async_call_delete(call);
 }
 
 static void
@@ -1058,6 +2519,8 @@ sfwsensor_stm_start_release_session(SfwSensor *self)
     const char      *name       = sfwsensor_name(self);
     GDBusConnection *connection = sfwservice_get_connection(service);
     cancellable_start(&priv->sns_release_session_cancellable);
+    sfwsensor_trace_event(SFWTRACE_ASYNC_BEGIN, SFWDBUS_MANAGER_METHOD_STOP_SESSION,
+                          (uintptr_t)priv->sns_release_session_cancellable);
     g_dbus_connection_call(connection,
                            SFWDBUS_SERVICE,
                            SFWDBUS_MANAGER_OBJECT,
@@ -1069,7 +2532,9 @@ sfwsensor_stm_start_release_session(SfwSensor *self)
                            -1,
                            priv->sns_release_session_cancellable,
                            sfwsensor_stm_release_session_cb,
-                           sfwsensor_ref(self));
+                           async_call_new(sfwsensor_ref(self),
+                                          priv->sns_release_session_cancellable,
+                                          SFWDBUS_MANAGER_METHOD_STOP_SESSION));
 EXIT:
     return;
 }
@@ -1122,7 +2587,8 @@ sfwsensor_stm_update_property(SfwSensor *self, const char *key, GVariant *val)
 static void
 sfwsensor_stm_get_properties_cb(GObject *object, GAsyncResult *res, gpointer aptr)
 {
-    SfwSensor        *self = aptr;
+    AsyncCall        *call = aptr;
+    SfwSensor        *self = call->ac_object;
     SfwSensorPrivate *priv = sfwsensor_priv(self);
     GDBusConnection  *con  = G_DBUS_CONNECTION(object);
     GError           *err  = NULL;
@@ -1131,6 +2597,9 @@ sfwsensor_stm_get_properties_cb(GObject *object, GAsyncResult *res, gpointer apt
     if( !rsp )
         sfwsensor_log_err("err: %s", error_message(err));
 
+    sfwsensor_trace_event(SFWTRACE_ASYNC_END, call->ac_what,
+                          (uintptr_t)call->ac_cancellable);
+
     if( cancellable_finish(&priv->sns_get_properties_cancellable) ) {
         bool ack = false;
         if( rsp ) {
@@ -1158,6 +2627,7 @@ sfwsensor_stm_get_properties_cb(GObject *object, GAsyncResult *res, gpointer apt
     g_clear_error(&err);
     gutil_variant_unref(rsp);
     sfwsensor_unref(self);
+    async_call_delete(call);
 }
 
 static void
@@ -1172,6 +2642,8 @@ sfwsensor_stm_start_get_properties(SfwSensor *self)
     const char       *interface  = sfwsensorid_interface(id);
 
     cancellable_start(&priv->sns_get_properties_cancellable);
+    sfwsensor_trace_event(SFWTRACE_ASYNC_BEGIN, DBUS_PROPERTIES_METHOD_GET_ALL,
+                          (uintptr_t)priv->sns_get_properties_cancellable);
     g_dbus_connection_call(connection,
                            SFWDBUS_SERVICE,
                            object,
@@ -1183,7 +2655,9 @@ sfwsensor_stm_start_get_properties(SfwSensor *self)
                            -1,
                            priv->sns_get_properties_cancellable,
                            sfwsensor_stm_get_properties_cb,
-                           sfwsensor_ref(self));
+                           async_call_new(sfwsensor_ref(self),
+                                          priv->sns_get_properties_cancellable,
+                                          DBUS_PROPERTIES_METHOD_GET_ALL));
 }
 
 static void
@@ -1256,26 +2730,25 @@ sfwsensor_stm_socket_rx_handshake(GIOChannel *chn, GIOCondition cnd, gpointer ap
     return G_SOURCE_CONTINUE;
 }
 
-static gboolean
-sfwsensor_stm_socket_rx_reading(GIOChannel *chn, GIOCondition cnd, gpointer aptr)
+/** Read one frame of samples from data socket into sns_frame
+ */
+static bool
+sfwsensor_stm_socket_read_frame(SfwSensor *self, uint32_t *pcnt)
 {
-    (void)chn;
-    (void)cnd;
-
-    SfwSensor        *self   = aptr;
-    SfwSensorPrivate *priv   = sfwsensor_priv(self);
-    gboolean          result = G_SOURCE_REMOVE;
+    SfwSensorPrivate *priv = sfwsensor_priv(self);
+    bool              ack  = false;
 
     uint32_t cnt = 0;
     if( socket_read(priv->sns_socket_fd, &cnt, sizeof cnt) != sizeof cnt ) {
         sfwsensor_log_err("failed to read sample count");
         goto EXIT;
     }
-    if( cnt < 1 || cnt > 16 ) {
+    if( cnt < 1 || cnt > SFWSENSOR_FRAME_MAX ) {
         sfwsensor_log_err("suspicious sample count: %" PRIu32, cnt);
         goto EXIT;
     }
     sfwsensor_log_debug("sample count: %" PRIu32, cnt);
+    sfwsensor_trace_data(SFWTRACE_COUNTER, "frame-samples", cnt);
 
     const size_t blk = sfwsensorid_sample_size(priv->sns_reading.sensor_id);
     if( blk < sizeof(uint32_t) || blk > sizeof(SfwSample) ) {
@@ -1284,7 +2757,7 @@ sfwsensor_stm_socket_rx_reading(GIOChannel *chn, GIOCondition cnd, gpointer aptr
     }
     for( uint32_t i = 0; i < cnt; ++i ) {
         ssize_t done = socket_read(priv->sns_socket_fd,
-                                   &priv->sns_reading.sample, blk);
+                                   priv->sns_frame + i * blk, blk);
         if( done == -1 ) {
             sfwsensor_log_err("reading: %m");
             goto EXIT;
@@ -1297,14 +2770,48 @@ sfwsensor_stm_socket_rx_reading(GIOChannel *chn, GIOCondition cnd, gpointer aptr
             sfwsensor_log_err("reading: NAK");
             goto EXIT;
         }
-        if( sfwreporting_is_active(priv->sns_reporting) ) {
-            sfwreading_normalize(&priv->sns_reading);
-            sfwsensor_emit_signal(self, SFWSENSOR_SIGNAL_READING_CHANGED);
-        }
-        else {
-            sfwreading_normalize(&priv->sns_reading);
-            sfwsensor_log_debug("IGNORED[%"PRIu32"]: %s", i, sfwreading_repr(&priv->sns_reading));
-        }
+    }
+    *pcnt = cnt;
+    ack = true;
+EXIT:
+    return ack;
+}
+
+static gboolean
+sfwsensor_stm_socket_rx_reading(GIOChannel *chn, GIOCondition cnd, gpointer aptr)
+{
+    (void)chn;
+    (void)cnd;
+
+    SfwSensor        *self   = aptr;
+    SfwSensorPrivate *priv   = sfwsensor_priv(self);
+    gboolean          result = G_SOURCE_REMOVE;
+    int64_t           now    = g_get_monotonic_time();
+    uint32_t          cnt    = 0;
+
+    sfwsensor_trace_data(SFWTRACE_INSTANT, "socket-wakeup", 0);
+
+    if( !sfwsensor_stm_socket_read_frame(self, &cnt) )
+        goto EXIT;
+
+    /* In latest only mode, consume also frames that are already
+     * queued and deliver only from the last one */
+    for( int drained = 0; drained < SFWSENSOR_DRAIN_MAX; ++drained ) {
+        if( !priv->sns_latest_only || priv->sns_socket_paused )
+            break;
+        if( socket_pending(priv->sns_socket_fd) < (ssize_t)sizeof cnt )
+            break;
+        sfwsensor_handle_frame(self, now, cnt, priv->sns_frame, false);
+        if( !sfwsensor_stm_socket_read_frame(self, &cnt) )
+            goto EXIT;
+    }
+
+    sfwsensor_handle_frame(self, now, cnt, priv->sns_frame, true);
+
+    /* Reading queue full - leave data in socket until it drains */
+    if( priv->sns_socket_paused ) {
+        priv->sns_socket_rx_id = 0;
+        goto DONE;
     }
     result = G_SOURCE_CONTINUE;
 EXIT:
@@ -1312,6 +2819,7 @@ EXIT:
         priv->sns_socket_rx_id = 0;
         sfwsensor_stm_set_state(self, SFWSENSORSTATE_FAILED);
     }
+DONE:
     return result;
 }
 
@@ -1423,6 +2931,7 @@ sfwsensor_stm_socket_disconnect(SfwSensor *self)
     priv->sns_socket_rx_cb = sfwsensor_stm_socket_rx_unexpected;
     gutil_source_remove_at(&priv->sns_socket_tx_id);
     gutil_source_remove_at(&priv->sns_socket_rx_id);
+    priv->sns_socket_paused = false;
     if( socket_close_at(&priv->sns_socket_fd) )
         sfwsensor_log_info("data disconnect");
 }
@@ -39,6 +39,10 @@
 # define SFWSENSOR_H_
 
 # include "sfwtypes.h"
+# include "sfwfilter.h"
+# include "sfwresampler.h"
+# include "sfwspectrum.h"
+# include "sfwstats.h"
 
 # include <glib-object.h>
 
@@ -51,6 +55,51 @@ G_BEGIN_DECLS
  * ========================================================================= */
 
 typedef void (*SfwSensorHandler)(SfwSensor *sfwsensor, gpointer aptr);
+typedef void (*SfwSensorReadingCallback)(SfwSensor *sfwsensor, const SfwReading *reading, gpointer aptr);
+typedef void (*SfwSensorBatchCallback)(const SfwReading *readings, size_t count, gpointer aptr);
+
+/** Change threshold modes for reading delivery
+ *
+ * Readings that do not pass the threshold still update the cached
+ * reading available via sfwsensor_reading(), but reading changed
+ * signal is not emitted for them.
+ */
+typedef enum SfwSensorThreshold
+{
+    /** Deliver all readings */
+    SFW_SENSOR_THRESHOLD_NONE,
+
+    /** Deliver if any channel value differs from last delivered */
+    SFW_SENSOR_THRESHOLD_CHANGED,
+
+    /** Deliver if any channel changed by more than epsilon */
+    SFW_SENSOR_THRESHOLD_ABSOLUTE,
+
+    /** Deliver if any channel changed by more than epsilon * |value| */
+    SFW_SENSOR_THRESHOLD_RELATIVE,
+} SfwSensorThreshold;
+
+/** Policies for handling readings when consumers fall behind
+ *
+ * With policies other than NONE, readings are queued and delivered
+ * from idle callbacks, so that data reception is not held back by
+ * slow reading changed handlers.
+ */
+typedef enum SfwSensorBackpressure
+{
+    /** Deliver readings immediately as they are received */
+    SFW_SENSOR_BACKPRESSURE_NONE,
+
+    /** When queue is full, discard the oldest queued reading */
+    SFW_SENSOR_BACKPRESSURE_DROP_OLDEST,
+
+    /** When queue is full, discard incoming readings */
+    SFW_SENSOR_BACKPRESSURE_DROP_NEWEST,
+
+    /** When queue is full, stop reading from the data socket and let
+     *  sensord and kernel socket buffers absorb the data */
+    SFW_SENSOR_BACKPRESSURE_STOP_READING,
+} SfwSensorBackpressure;
 
 /* ========================================================================= *
  * Prototypes
@@ -60,11 +109,12 @@ typedef void (*SfwSensorHandler)(SfwSensor *sfwsensor, gpointer aptr);
  * SFWSENSOR_LIFECYCLE
  * ------------------------------------------------------------------------- */
 
-SfwSensor *sfwsensor_new     (SfwSensorId id);
-SfwSensor *sfwsensor_ref     (SfwSensor *self);
-void       sfwsensor_unref   (SfwSensor *self);
-void       sfwsensor_unref_cb(gpointer self);
-void       sfwsensor_unref_at(SfwSensor **pself);
+SfwSensor *sfwsensor_new       (SfwSensorId id);
+SfwSensor *sfwsensor_new_replay(const char *path);
+SfwSensor *sfwsensor_ref       (SfwSensor *self);
+void       sfwsensor_unref     (SfwSensor *self);
+void       sfwsensor_unref_cb  (gpointer self);
+void       sfwsensor_unref_at  (SfwSensor **pself);
 
 /* ------------------------------------------------------------------------- *
  * SFWSENSOR_CONTROL
@@ -93,15 +143,102 @@ bool sfwsensor_is_active(const SfwSensor *self);
 
 SfwReading *sfwsensor_reading(SfwSensor *self);
 
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_REPLAY
+ * ------------------------------------------------------------------------- */
+
+bool sfwsensor_is_replay       (const SfwSensor *self);
+void sfwsensor_set_replay_speed(SfwSensor *self, double speed);
+void sfwsensor_rewind_replay   (SfwSensor *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_RECORDING
+ * ------------------------------------------------------------------------- */
+
+bool sfwsensor_start_recording(SfwSensor *self, const char *path);
+void sfwsensor_stop_recording (SfwSensor *self);
+bool sfwsensor_is_recording   (const SfwSensor *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_HISTORY
+ * ------------------------------------------------------------------------- */
+
+void   sfwsensor_set_history_size (SfwSensor *self, size_t count);
+size_t sfwsensor_history_size     (const SfwSensor *self);
+size_t sfwsensor_history_query    (const SfwSensor *self, uint64_t t_begin, uint64_t t_end, SfwSample *out, size_t max);
+size_t sfwsensor_history_query_xyz(const SfwSensor *self, uint64_t t_begin, uint64_t t_end, uint64_t *t, float *x, float *y, float *z, size_t max);
+bool   sfwsensor_history_nearest  (const SfwSensor *self, uint64_t t, SfwSample *out);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_FILTERS
+ * ------------------------------------------------------------------------- */
+
+bool sfwsensor_add_filter   (SfwSensor *self, SfwFilter *filter);
+void sfwsensor_clear_filters(SfwSensor *self);
+void sfwsensor_reset_filters(SfwSensor *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_RESAMPLING
+ * ------------------------------------------------------------------------- */
+
+bool   sfwsensor_set_resampler(SfwSensor *self, SfwResamplerMethod method, double rate_hz);
+double sfwsensor_resample_rate(const SfwSensor *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_STATISTICS
+ * ------------------------------------------------------------------------- */
+
+SfwStats *sfwsensor_add_stats   (SfwSensor *self, size_t channel, size_t count, uint64_t window_us);
+bool      sfwsensor_remove_stats(SfwSensor *self, SfwStats *stats);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_SPECTRUM
+ * ------------------------------------------------------------------------- */
+
+SfwSpectrum               *sfwsensor_set_spectrum(SfwSensor *self, size_t size, size_t hop);
+const SfwSpectrumFeatures *sfwsensor_spectrum    (const SfwSensor *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_DELIVERY
+ * ------------------------------------------------------------------------- */
+
+void     sfwsensor_set_threshold  (SfwSensor *self, SfwSensorThreshold mode, double epsilon, double hysteresis);
+uint64_t sfwsensor_suppressed     (const SfwSensor *self);
+void     sfwsensor_set_latest_only(SfwSensor *self, bool latest_only);
+uint64_t sfwsensor_skipped        (const SfwSensor *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_QUEUE
+ * ------------------------------------------------------------------------- */
+
+void     sfwsensor_set_backpressure(SfwSensor *self, SfwSensorBackpressure policy, size_t queue_size, size_t high_water);
+size_t   sfwsensor_queued          (const SfwSensor *self);
+uint64_t sfwsensor_dropped         (const SfwSensor *self);
+
 /* ------------------------------------------------------------------------- *
  * SFWSENSOR_SIGNALS
  * ------------------------------------------------------------------------- */
 
-gulong sfwsensor_add_valid_changed_handler  (SfwSensor *self, SfwSensorHandler handler, gpointer aptr);
-gulong sfwsensor_add_active_changed_handler (SfwSensor *self, SfwSensorHandler handler, gpointer aptr);
-gulong sfwsensor_add_reading_changed_handler(SfwSensor *self, SfwSensorHandler handler, gpointer aptr);
-void   sfwsensor_remove_handler             (SfwSensor *self, gulong id);
-void   sfwsensor_remove_handler_at          (SfwSensor *self, gulong *pid);
+gulong sfwsensor_add_valid_changed_handler   (SfwSensor *self, SfwSensorHandler handler, gpointer aptr);
+gulong sfwsensor_add_active_changed_handler  (SfwSensor *self, SfwSensorHandler handler, gpointer aptr);
+gulong sfwsensor_add_reading_changed_handler (SfwSensor *self, SfwSensorHandler handler, gpointer aptr);
+gulong sfwsensor_add_high_water_handler      (SfwSensor *self, SfwSensorHandler handler, gpointer aptr);
+gulong sfwsensor_add_spectrum_changed_handler(SfwSensor *self, SfwSensorHandler handler, gpointer aptr);
+void   sfwsensor_remove_handler              (SfwSensor *self, gulong id);
+void   sfwsensor_remove_handler_at           (SfwSensor *self, gulong *pid);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_CALLBACKS
+ * ------------------------------------------------------------------------- */
+
+guint sfwsensor_add_reading_callback   (SfwSensor *self, SfwSensorReadingCallback callback, gpointer aptr);
+void  sfwsensor_remove_reading_callback(SfwSensor *self, guint id);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSOR_WORKER
+ * ------------------------------------------------------------------------- */
+
+bool sfwsensor_set_worker(SfwSensor *self, SfwSensorBatchCallback callback, gpointer aptr);
 
 /* ------------------------------------------------------------------------- *
  * SFWSENSOR_ACCESSORS
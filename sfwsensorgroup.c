@@ -0,0 +1,478 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "sfwsensorgroup.h"
+
+#include "sfwlogging.h"
+
+#include <math.h>
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Number of recent readings kept per non-reference sensor */
+#define SFWSENSORGROUP_HISTORY 32
+
+/** Maximum number of reference readings waiting for other sensors */
+#define SFWSENSORGROUP_PENDING_MAX 32
+
+/** Default time reference readings wait for other sensors [us] */
+#define SFWSENSORGROUP_LATENCY_DEFAULT 500000
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+typedef struct SfwSensorGroupMember
+{
+    SfwSensorGroup *mem_group;
+    SfwSensorId     mem_id;
+    SfwSensor      *mem_sensor;
+    guint           mem_callback_id;
+
+    /* Recent readings, oldest first in ring order */
+    SfwSample       mem_history[SFWSENSORGROUP_HISTORY];
+    size_t          mem_head;
+    size_t          mem_count;
+} SfwSensorGroupMember;
+
+typedef enum SfwSensorGroupMatch
+{
+    SFWSENSORGROUP_MATCH_READY,
+    SFWSENSORGROUP_MATCH_WAIT,
+    SFWSENSORGROUP_MATCH_MISS,
+} SfwSensorGroupMatch;
+
+struct SfwSensorGroup
+{
+    uint64_t                grp_tolerance;
+    uint64_t                grp_latency;
+
+    SfwSensorGroupHandler   grp_handler;
+    gpointer                grp_aptr;
+
+    SfwSensorGroupMember    grp_member[SFWSENSORGROUP_MEMBERS_MAX];
+    size_t                  grp_count;
+
+    /* Reference readings waiting for other sensors */
+    SfwSample               grp_pending[SFWSENSORGROUP_PENDING_MAX];
+    size_t                  grp_pending_head;
+    size_t                  grp_pending_count;
+    uint64_t                grp_latest;
+
+    SfwReading              grp_tuple[SFWSENSORGROUP_MEMBERS_MAX];
+    uint64_t                grp_dropped;
+};
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSORGROUP_ALIGN
+ * ------------------------------------------------------------------------- */
+
+static double              sfwsensorgroup_lerp       (double a, double b, double f);
+static void                sfwsensorgroup_interpolate(SfwSensorId id, const SfwSample *a, const SfwSample *b, uint64_t t, SfwSample *out);
+static SfwSensorGroupMatch sfwsensorgroup_match      (const SfwSensorGroup *self, const SfwSensorGroupMember *member, uint64_t t, bool forced, SfwSample *out);
+static void                sfwsensorgroup_process    (SfwSensorGroup *self);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSORGROUP
+ * ------------------------------------------------------------------------- */
+
+static void     sfwsensorgroup_reading_cb  (SfwSensor *sensor, const SfwReading *reading, gpointer aptr);
+SfwSensorGroup *sfwsensorgroup_new         (uint64_t tolerance_us);
+void            sfwsensorgroup_delete      (SfwSensorGroup *self);
+void            sfwsensorgroup_delete_at   (SfwSensorGroup **pself);
+SfwSensor      *sfwsensorgroup_add         (SfwSensorGroup *self, SfwSensorId id);
+size_t          sfwsensorgroup_count       (const SfwSensorGroup *self);
+SfwSensor      *sfwsensorgroup_sensor      (const SfwSensorGroup *self, size_t index);
+void            sfwsensorgroup_set_handler (SfwSensorGroup *self, SfwSensorGroupHandler handler, gpointer aptr);
+void            sfwsensorgroup_set_latency (SfwSensorGroup *self, uint64_t latency_us);
+void            sfwsensorgroup_set_datarate(SfwSensorGroup *self, double datarate_hz);
+void            sfwsensorgroup_start       (SfwSensorGroup *self);
+void            sfwsensorgroup_stop        (SfwSensorGroup *self);
+void            sfwsensorgroup_reset       (SfwSensorGroup *self);
+void            sfwsensorgroup_add_reading (SfwSensorGroup *self, size_t index, const SfwReading *reading);
+uint64_t        sfwsensorgroup_dropped     (const SfwSensorGroup *self);
+
+/* ========================================================================= *
+ * SFWSENSORGROUP_ALIGN
+ * ========================================================================= */
+
+static double
+sfwsensorgroup_lerp(double a, double b, double f)
+{
+    return a + (b - a) * f;
+}
+
+/** Estimate sample at time t from samples before and after it
+ *
+ * Xyz and magnetometer samples are interpolated linearly, for other
+ * sensor types the nearest sample is used.
+ */
+static void
+sfwsensorgroup_interpolate(SfwSensorId id, const SfwSample *a,
+                           const SfwSample *b, uint64_t t, SfwSample *out)
+{
+    if( !b || (a && a->timestamp == b->timestamp) ) {
+        *out = *a;
+        goto EXIT;
+    }
+    if( !a ) {
+        *out = *b;
+        goto EXIT;
+    }
+
+    double f = (double)(t - a->timestamp) / (double)(b->timestamp - a->timestamp);
+
+    *out = (f < 0.5) ? *a : *b;
+    if( sfwsensorid_is_xyz(id) ) {
+        out->xyz.x = (float)sfwsensorgroup_lerp(a->xyz.x, b->xyz.x, f);
+        out->xyz.y = (float)sfwsensorgroup_lerp(a->xyz.y, b->xyz.y, f);
+        out->xyz.z = (float)sfwsensorgroup_lerp(a->xyz.z, b->xyz.z, f);
+        out->timestamp = t;
+    }
+    else if( id == SFW_SENSOR_ID_MAGNETOMETER ) {
+        const int32_t *va = &a->magnetometer.x;
+        const int32_t *vb = &b->magnetometer.x;
+        int32_t       *vo = &out->magnetometer.x;
+        /* x, y, z, rx, ry, rz; level is taken from nearest sample */
+        for( size_t i = 0; i < 6; ++i )
+            vo[i] = (int32_t)lround(sfwsensorgroup_lerp(va[i], vb[i], f));
+        out->timestamp = t;
+    }
+
+EXIT:
+    return;
+}
+
+/** Find reading of a sensor matching reference time t
+ *
+ * @param forced  true if waiting for more readings is not an option
+ */
+static SfwSensorGroupMatch
+sfwsensorgroup_match(const SfwSensorGroup *self,
+                     const SfwSensorGroupMember *member, uint64_t t,
+                     bool forced, SfwSample *out)
+{
+    const SfwSample *a = NULL;
+    const SfwSample *b = NULL;
+
+    /* Latest sample at or before t, and first sample at or after t */
+    for( size_t i = 0; i < member->mem_count; ++i ) {
+        size_t k = (member->mem_head + SFWSENSORGROUP_HISTORY
+                    - member->mem_count + i) % SFWSENSORGROUP_HISTORY;
+        const SfwSample *s = &member->mem_history[k];
+        if( s->timestamp <= t )
+            a = s;
+        if( s->timestamp >= t ) {
+            b = s;
+            break;
+        }
+    }
+
+    if( !b && !forced )
+        return SFWSENSORGROUP_MATCH_WAIT;
+
+    /* No readings at all; tolerance check alone would let this
+     * through when tolerance is UINT64_MAX */
+    if( !a && !b )
+        return SFWSENSORGROUP_MATCH_MISS;
+
+    uint64_t da = a ? t - a->timestamp : UINT64_MAX;
+    uint64_t db = b ? b->timestamp - t : UINT64_MAX;
+    if( MIN(da, db) > self->grp_tolerance )
+        return SFWSENSORGROUP_MATCH_MISS;
+
+    sfwsensorgroup_interpolate(member->mem_id, a, b, t, out);
+    return SFWSENSORGROUP_MATCH_READY;
+}
+
+/** Emit tuples for pending reference readings that can be aligned
+ */
+static void
+sfwsensorgroup_process(SfwSensorGroup *self)
+{
+    while( self->grp_pending_count > 0 ) {
+        const SfwSample *ref = &self->grp_pending[self->grp_pending_head];
+        uint64_t         t   = ref->timestamp;
+
+        /* Stop waiting for sensors that lag too much behind */
+        bool forced = (self->grp_pending_count == SFWSENSORGROUP_PENDING_MAX ||
+                       self->grp_latest - t > self->grp_latency);
+
+        SfwSensorGroupMatch match = SFWSENSORGROUP_MATCH_READY;
+        self->grp_tuple[0].sample = *ref;
+        for( size_t i = 1; i < self->grp_count; ++i ) {
+            match = sfwsensorgroup_match(self, &self->grp_member[i], t, forced,
+                                         &self->grp_tuple[i].sample);
+            if( match != SFWSENSORGROUP_MATCH_READY )
+                break;
+        }
+
+        if( match == SFWSENSORGROUP_MATCH_WAIT )
+            break;
+
+        self->grp_pending_head = (self->grp_pending_head + 1) % SFWSENSORGROUP_PENDING_MAX;
+        self->grp_pending_count--;
+
+        if( match == SFWSENSORGROUP_MATCH_MISS )
+            self->grp_dropped++;
+        else if( self->grp_handler )
+            self->grp_handler(self, self->grp_tuple, self->grp_count,
+                              self->grp_aptr);
+    }
+}
+
+/* ========================================================================= *
+ * SFWSENSORGROUP
+ * ========================================================================= */
+
+static void
+sfwsensorgroup_reading_cb(SfwSensor *sensor, const SfwReading *reading,
+                          gpointer aptr)
+{
+    SfwSensorGroupMember *member = aptr;
+    SfwSensorGroup       *self   = member->mem_group;
+    (void)sensor;
+    sfwsensorgroup_add_reading(self, member - self->grp_member, reading);
+}
+
+/** Create sensor group
+ *
+ * @param tolerance_us  maximum distance between reference timestamp
+ *                      and matched reading of another sensor
+ */
+SfwSensorGroup *
+sfwsensorgroup_new(uint64_t tolerance_us)
+{
+    SfwSensorGroup *self = g_new0(SfwSensorGroup, 1);
+    self->grp_tolerance = tolerance_us;
+    self->grp_latency   = SFWSENSORGROUP_LATENCY_DEFAULT;
+    for( size_t i = 0; i < SFWSENSORGROUP_MEMBERS_MAX; ++i )
+        self->grp_member[i].mem_group = self;
+    return self;
+}
+
+void
+sfwsensorgroup_delete(SfwSensorGroup *self)
+{
+    if( self ) {
+        for( size_t i = 0; i < self->grp_count; ++i ) {
+            SfwSensorGroupMember *member = &self->grp_member[i];
+            sfwsensor_remove_reading_callback(member->mem_sensor,
+                                              member->mem_callback_id);
+            sfwsensor_stop(member->mem_sensor);
+            sfwsensor_unref_at(&member->mem_sensor);
+        }
+        g_free(self);
+    }
+}
+
+void
+sfwsensorgroup_delete_at(SfwSensorGroup **pself)
+{
+    sfwsensorgroup_delete(*pself), *pself = NULL;
+}
+
+/** Create sensor owned by the group
+ *
+ * The first sensor added is the reference stream. The returned
+ * sensor can be used e.g. for configuring filters, but it should
+ * be started and stopped only via the group.
+ *
+ * @return sensor, or NULL if the group is full or id is not valid
+ */
+SfwSensor *
+sfwsensorgroup_add(SfwSensorGroup *self, SfwSensorId id)
+{
+    SfwSensor *sensor = NULL;
+
+    if( !self || !sfwsensorid_is_valid(id) )
+        goto EXIT;
+
+    if( self->grp_count == SFWSENSORGROUP_MEMBERS_MAX ) {
+        sfwlog_warning("sensor group is full");
+        goto EXIT;
+    }
+
+    SfwSensorGroupMember *member = &self->grp_member[self->grp_count];
+    if( !(member->mem_sensor = sfwsensor_new(id)) )
+        goto EXIT;
+
+    member->mem_id = id;
+    member->mem_callback_id =
+        sfwsensor_add_reading_callback(member->mem_sensor,
+                                       sfwsensorgroup_reading_cb, member);
+    member->mem_head  = 0;
+    member->mem_count = 0;
+    self->grp_tuple[self->grp_count].sensor_id = id;
+    sensor = member->mem_sensor;
+    self->grp_count++;
+
+EXIT:
+    return sensor;
+}
+
+size_t
+sfwsensorgroup_count(const SfwSensorGroup *self)
+{
+    return self ? self->grp_count : 0;
+}
+
+SfwSensor *
+sfwsensorgroup_sensor(const SfwSensorGroup *self, size_t index)
+{
+    return (self && index < self->grp_count) ? self->grp_member[index].mem_sensor : NULL;
+}
+
+void
+sfwsensorgroup_set_handler(SfwSensorGroup *self, SfwSensorGroupHandler handler,
+                           gpointer aptr)
+{
+    if( self ) {
+        self->grp_handler = handler;
+        self->grp_aptr    = aptr;
+    }
+}
+
+/** Set how long reference readings wait for other sensors
+ *
+ * Tuples are emitted as soon as every sensor has a reading at or after
+ * the reference timestamp. When that does not happen before the
+ * reference stream runs ahead by more than the latency, the tuple is
+ * completed from available readings, or dropped if some sensor has
+ * none within tolerance. The latency should cover batched delivery
+ * of the slowest sensor.
+ *
+ * @param latency_us  maximum wait, default is 500 ms
+ */
+void
+sfwsensorgroup_set_latency(SfwSensorGroup *self, uint64_t latency_us)
+{
+    if( self )
+        self->grp_latency = latency_us;
+}
+
+void
+sfwsensorgroup_set_datarate(SfwSensorGroup *self, double datarate_hz)
+{
+    for( size_t i = 0; i < sfwsensorgroup_count(self); ++i )
+        sfwsensor_set_datarate(self->grp_member[i].mem_sensor, datarate_hz);
+}
+
+void
+sfwsensorgroup_start(SfwSensorGroup *self)
+{
+    sfwsensorgroup_reset(self);
+    for( size_t i = 0; i < sfwsensorgroup_count(self); ++i )
+        sfwsensor_start(self->grp_member[i].mem_sensor);
+}
+
+void
+sfwsensorgroup_stop(SfwSensorGroup *self)
+{
+    for( size_t i = 0; i < sfwsensorgroup_count(self); ++i )
+        sfwsensor_stop(self->grp_member[i].mem_sensor);
+}
+
+/** Discard buffered readings
+ */
+void
+sfwsensorgroup_reset(SfwSensorGroup *self)
+{
+    if( self ) {
+        for( size_t i = 0; i < self->grp_count; ++i ) {
+            self->grp_member[i].mem_head  = 0;
+            self->grp_member[i].mem_count = 0;
+        }
+        self->grp_pending_head  = 0;
+        self->grp_pending_count = 0;
+        self->grp_latest        = 0;
+    }
+}
+
+/** Feed one reading of a group member
+ *
+ * Readings from sensors owned by the group are fed automatically.
+ * Can be used also e.g. with readings from replayed recordings.
+ *
+ * @param index  position of the sensor in the group
+ */
+void
+sfwsensorgroup_add_reading(SfwSensorGroup *self, size_t index,
+                           const SfwReading *reading)
+{
+    if( !self || !reading || index >= self->grp_count )
+        goto EXIT;
+
+    if( index == 0 ) {
+        if( self->grp_pending_count == SFWSENSORGROUP_PENDING_MAX ) {
+            /* Not expected, full queue forces processing */
+            self->grp_pending_head = (self->grp_pending_head + 1) % SFWSENSORGROUP_PENDING_MAX;
+            self->grp_pending_count--;
+            self->grp_dropped++;
+        }
+        size_t tail = (self->grp_pending_head + self->grp_pending_count) % SFWSENSORGROUP_PENDING_MAX;
+        self->grp_pending[tail] = reading->sample;
+        self->grp_pending_count++;
+        self->grp_latest = MAX(self->grp_latest, reading->sample.timestamp);
+    }
+    else {
+        SfwSensorGroupMember *member = &self->grp_member[index];
+        member->mem_history[member->mem_head] = reading->sample;
+        member->mem_head = (member->mem_head + 1) % SFWSENSORGROUP_HISTORY;
+        if( member->mem_count < SFWSENSORGROUP_HISTORY )
+            member->mem_count++;
+    }
+
+    sfwsensorgroup_process(self);
+
+EXIT:
+    return;
+}
+
+/** Get number of reference readings for which no tuple was emitted
+ */
+uint64_t
+sfwsensorgroup_dropped(const SfwSensorGroup *self)
+{
+    return self ? self->grp_dropped : 0;
+}
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef SFWSENSORGROUP_H_
+# define SFWSENSORGROUP_H_
+
+# include "sfwsensor.h"
+
+G_BEGIN_DECLS
+
+# pragma GCC visibility push(default)
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Maximum number of sensors in a group */
+# define SFWSENSORGROUP_MEMBERS_MAX 8
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+/** Set of sensors started and stopped together, with readings
+ *  aligned by timestamp
+ *
+ * The first sensor added to the group is the reference stream. For
+ * each reference reading, a tuple with one reading per sensor is
+ * emitted. Readings of the other sensors are interpolated to the
+ * reference timestamp, or the nearest reading is used for sensor
+ * types that can not be interpolated. A tuple is held until every
+ * sensor has a reading at or after the reference timestamp, or until
+ * the reference stream runs ahead by more than the maximum latency
+ * set with sfwsensorgroup_set_latency(). Tuples for which some sensor
+ * has no reading within tolerance are dropped.
+ */
+typedef struct SfwSensorGroup SfwSensorGroup;
+
+/** Callback for receiving aligned readings
+ *
+ * Readings are in the order sensors were added to the group.
+ */
+typedef void (*SfwSensorGroupHandler)(SfwSensorGroup *group, const SfwReading *readings, size_t count, gpointer aptr);
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWSENSORGROUP
+ * ------------------------------------------------------------------------- */
+
+SfwSensorGroup *sfwsensorgroup_new         (uint64_t tolerance_us);
+void            sfwsensorgroup_delete      (SfwSensorGroup *self);
+void            sfwsensorgroup_delete_at   (SfwSensorGroup **pself);
+SfwSensor      *sfwsensorgroup_add         (SfwSensorGroup *self, SfwSensorId id);
+size_t          sfwsensorgroup_count       (const SfwSensorGroup *self);
+SfwSensor      *sfwsensorgroup_sensor      (const SfwSensorGroup *self, size_t index);
+void            sfwsensorgroup_set_handler (SfwSensorGroup *self, SfwSensorGroupHandler handler, gpointer aptr);
+void            sfwsensorgroup_set_latency (SfwSensorGroup *self, uint64_t latency_us);
+void            sfwsensorgroup_set_datarate(SfwSensorGroup *self, double datarate_hz);
+void            sfwsensorgroup_start       (SfwSensorGroup *self);
+void            sfwsensorgroup_stop        (SfwSensorGroup *self);
+void            sfwsensorgroup_reset       (SfwSensorGroup *self);
+void            sfwsensorgroup_add_reading (SfwSensorGroup *self, size_t index, const SfwReading *reading);
+uint64_t        sfwsensorgroup_dropped     (const SfwSensorGroup *self);
+
+# pragma GCC visibility pop
+
+G_END_DECLS
+
+#endif /* SFWSENSORGROUP_H_ */
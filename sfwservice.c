@@ -38,6 +38,7 @@
 #include "sfwservice.h"
 
 #include "sfwlogging.h"
+#include "sfwtrace.h"
 #include "sfwdbus.h"
 #include "utility.h"
 
@@ -102,6 +103,11 @@ typedef GObjectClass SfwServiceClass;
 # define sfwservice_log_debug(  FMT, ARGS...) sfwservice_log_emit(SFWLOG_DEBUG,   FMT, ##ARGS)
 # define sfwservice_log_trace(  FMT, ARGS...) sfwservice_log_emit(SFWLOG_TRACE,   FMT, ##ARGS)
 
+# define sfwservice_trace_state(STATE)\
+     sfwtrace_state(self, "sfservice", NULL, STATE)
+# define sfwservice_trace_event(TYPE, WHAT, VALUE)\
+     sfwtrace_event(self, "sfservice", NULL, TYPE, WHAT, VALUE)
+
 /* ========================================================================= *
  * Prototypes
  * ========================================================================= */
@@ -304,6 +310,8 @@ sfwservice_finalize(GObject *object)
     g_hash_table_unref(priv->srv_available_sensors),
         priv->srv_available_sensors = NULL;
 
+    sfwtrace_forget(self);
+
     G_OBJECT_CLASS(sfwservice_parent_class)->finalize(object);
 }
 
@@ -587,6 +595,7 @@ sfwservice_stm_set_state(SfwService *self, SfwServiceState state)
 
         sfwservice_stm_leave_state(self);
         priv->srv_state = state;
+        sfwservice_trace_state(sfwservicestate_repr(state));
         sfwservice_stm_enter_state(self);
 
         sfwservice_stm_eval_state_later(self);
@@ -608,6 +617,7 @@ sfwservice_stm_enter_state(SfwService *self)
         sfwservice_set_valid(self, true);
         break;
     case SFWSERVICESTATE_FAILED:
+        sfwlog_dump_flight_recorder();
         sfwservice_stm_start_retry_delay(self);
         break;
     case SFWSERVICESTATE_FINAL:
@@ -752,7 +762,8 @@ sfwservice_stm_connect_cb(GObject *object, GAsyncResult *res, gpointer aptr)
 {
     (void)object;
 
-    SfwService        *self = aptr;
+    AsyncCall         *call = aptr;
+    SfwService        *self = call->ac_object;
     SfwServicePrivate *priv = sfwservice_priv(self);
     GError            *err  = NULL;
     GDBusConnection   *con  = g_bus_get_finish(res, &err);
@@ -761,6 +772,9 @@ sfwservice_stm_connect_cb(GObject *object, GAsyncResult *res, gpointer aptr)
         sfwservice_log_warning("systembus connect failed: %s",
                                error_message(err));
 
+    sfwservice_trace_event(SFWTRACE_ASYNC_END, call->ac_what,
+                           (uintptr_t)call->ac_cancellable);
+
     if( cancellable_finish(&priv->srv_bus_get_cancellable) )
         sfwservice_set_connection(self, con);
 
@@ -768,6 +782,7 @@ sfwservice_stm_connect_cb(GObject *object, GAsyncResult *res, gpointer aptr)
     if( con )
         g_object_unref(con);
     sfwservice_unref(self);
+    async_call_delete(call);
 }
 
 static void
@@ -776,10 +791,14 @@ sfwservice_stm_connect(SfwService *self)
     SfwServicePrivate *priv = sfwservice_priv(self);
     sfwservice_stm_disconnect(self);
     cancellable_start(&priv->srv_bus_get_cancellable);
+    sfwservice_trace_event(SFWTRACE_ASYNC_BEGIN, "g_bus_get",
+                           (uintptr_t)priv->srv_bus_get_cancellable);
     g_bus_get(G_BUS_TYPE_SYSTEM,
               priv->srv_bus_get_cancellable,
               sfwservice_stm_connect_cb,
-              sfwservice_ref(self));
+              async_call_new(sfwservice_ref(self),
+                             priv->srv_bus_get_cancellable,
+                             "g_bus_get"));
 }
 static void
 sfwservice_stm_disconnect(SfwService *self)
@@ -796,7 +815,8 @@ sfwservice_stm_disconnect(SfwService *self)
 static void
 sfwservice_stm_enumerate_cb(GObject *object, GAsyncResult *res, gpointer aptr)
 {
-    SfwService        *self = aptr;
+    AsyncCall         *call = aptr;
+    SfwService        *self = call->ac_object;
     SfwServicePrivate *priv = sfwservice_priv(self);
     GDBusConnection   *con  = G_DBUS_CONNECTION(object);
     GError            *err  = NULL;
@@ -805,6 +825,9 @@ sfwservice_stm_enumerate_cb(GObject *object, GAsyncResult *res, gpointer aptr)
     if( !rsp )
         sfwservice_log_err("err: %s", error_message(err));
 
+    sfwservice_trace_event(SFWTRACE_ASYNC_END, call->ac_what,
+                           (uintptr_t)call->ac_cancellable);
+
     if( cancellable_finish(&priv->srv_enumerate_cancellable) ) {
         g_hash_table_remove_all(priv->srv_available_sensors);
         if( rsp ) {
@@ -825,6 +848,7 @@ sfwservice_stm_enumerate_cb(GObject *object, GAsyncResult *res, gpointer aptr)
     gutil_variant_unref(rsp);
     g_clear_error(&err);
     sfwservice_unref(self);
+    async_call_delete(call);
 }
 
 static void
@@ -833,6 +857,8 @@ sfwservice_stm_start_enumerate(SfwService *self)
     SfwServicePrivate *priv       = sfwservice_priv(self);
     GDBusConnection   *connection = sfwservice_get_connection(self);
     cancellable_start(&priv->srv_enumerate_cancellable);
+    sfwservice_trace_event(SFWTRACE_ASYNC_BEGIN, SFWDBUS_MANAGER_METHOD_AVAILABLE_PLUGINS,
+                           (uintptr_t)priv->srv_enumerate_cancellable);
     g_dbus_connection_call(connection,
                            SFWDBUS_SERVICE,
                            SFWDBUS_MANAGER_OBJECT,
@@ -844,7 +870,9 @@ sfwservice_stm_start_enumerate(SfwService *self)
                            -1,
                            priv->srv_enumerate_cancellable,
                            sfwservice_stm_enumerate_cb,
-                           sfwservice_ref(self));
+                           async_call_new(sfwservice_ref(self),
+                                          priv->srv_enumerate_cancellable,
+                                          SFWDBUS_MANAGER_METHOD_AVAILABLE_PLUGINS));
 }
 
 static void
@@ -0,0 +1,457 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "sfwspectrum.h"
+
+#include "sfwlogging.h"
+
+#include <math.h>
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+struct SfwSpectrum
+{
+    /** Frame size N, a power of two */
+    size_t               spc_size;
+
+    /** Number of new samples between frames */
+    size_t               spc_hop;
+
+    /* Sample ring, one row per axis */
+    float               *spc_ring[3];
+    uint64_t            *spc_times;
+    size_t               spc_head;
+    size_t               spc_fill;
+    size_t               spc_pending;
+
+    /* Hann window and its energy */
+    float               *spc_window;
+    double               spc_window_energy;
+
+    /* Complex FFT of size N/2 */
+    float               *spc_re;
+    float               *spc_im;
+    float               *spc_tw_re;
+    float               *spc_tw_im;
+    uint32_t            *spc_bitrev;
+
+    /** One-sided power spectrum, N/2 + 1 bins */
+    double              *spc_power;
+
+    double               spc_band_lo[SFWSPECTRUM_BANDS_MAX];
+    double               spc_band_hi[SFWSPECTRUM_BANDS_MAX];
+
+    SfwSpectrumFeatures  spc_features;
+};
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWSPECTRUM
+ * ------------------------------------------------------------------------- */
+
+static void                sfwspectrum_fft      (SfwSpectrum *self);
+static void                sfwspectrum_axis     (SfwSpectrum *self, const float *ring);
+static void                sfwspectrum_evaluate (SfwSpectrum *self);
+static bool                sfwspectrum_analyze  (SfwSpectrum *self);
+SfwSpectrum               *sfwspectrum_new      (size_t size, size_t hop);
+void                       sfwspectrum_delete   (SfwSpectrum *self);
+void                       sfwspectrum_delete_at(SfwSpectrum **pself);
+void                       sfwspectrum_reset    (SfwSpectrum *self);
+size_t                     sfwspectrum_size     (const SfwSpectrum *self);
+size_t                     sfwspectrum_hop      (const SfwSpectrum *self);
+bool                       sfwspectrum_add_band (SfwSpectrum *self, double lo_hz, double hi_hz);
+bool                       sfwspectrum_add      (SfwSpectrum *self, const SfwSample *sample);
+const SfwSpectrumFeatures *sfwspectrum_features (const SfwSpectrum *self);
+size_t                     sfwspectrum_power    (const SfwSpectrum *self, double *out, size_t max);
+
+/* ========================================================================= *
+ * SFWSPECTRUM
+ * ========================================================================= */
+
+/** In-place iterative radix-2 complex FFT of size N/2
+ */
+static void
+sfwspectrum_fft(SfwSpectrum *self)
+{
+    const size_t m  = self->spc_size / 2;
+    float       *re = self->spc_re;
+    float       *im = self->spc_im;
+
+    for( size_t i = 0; i < m; ++i ) {
+        size_t j = self->spc_bitrev[i];
+        if( i < j ) {
+            float t;
+            t = re[i], re[i] = re[j], re[j] = t;
+            t = im[i], im[i] = im[j], im[j] = t;
+        }
+    }
+
+    /* Twiddle table is for size N, stride converts to size len */
+    for( size_t len = 2; len <= m; len *= 2 ) {
+        size_t half   = len / 2;
+        size_t stride = self->spc_size / len;
+        for( size_t i = 0; i < m; i += len ) {
+            for( size_t j = 0; j < half; ++j ) {
+                float wr = self->spc_tw_re[j * stride];
+                float wi = self->spc_tw_im[j * stride];
+                size_t a = i + j, b = a + half;
+                float tr = re[b] * wr - im[b] * wi;
+                float ti = re[b] * wi + im[b] * wr;
+                re[b] = re[a] - tr, im[b] = im[a] - ti;
+                re[a] += tr,        im[a] += ti;
+            }
+        }
+    }
+}
+
+/** Accumulate power spectrum of one axis
+ *
+ * Even and odd samples of the real input are packed into real and
+ * imaginary parts of a half size complex FFT, and the real spectrum
+ * is then separated from the result.
+ */
+static void
+sfwspectrum_axis(SfwSpectrum *self, const float *ring)
+{
+    const size_t n = self->spc_size;
+    const size_t m = n / 2;
+
+    double mean = 0.0;
+    for( size_t i = 0; i < n; ++i )
+        mean += ring[i];
+    mean /= n;
+
+    /* Oldest sample is at head when ring is full */
+    size_t pos = self->spc_head;
+    for( size_t i = 0; i < m; ++i ) {
+        self->spc_re[i] = self->spc_window[2 * i] * (float)(ring[pos] - mean);
+        if( ++pos == n )
+            pos = 0;
+        self->spc_im[i] = self->spc_window[2 * i + 1] * (float)(ring[pos] - mean);
+        if( ++pos == n )
+            pos = 0;
+    }
+
+    sfwspectrum_fft(self);
+
+    for( size_t k = 0; k <= m; ++k ) {
+        size_t a = (k == m) ? 0 : k;
+        size_t b = (k == 0) ? 0 : m - k;
+        double er = 0.5 * (self->spc_re[a] + self->spc_re[b]);
+        double ei = 0.5 * (self->spc_im[a] - self->spc_im[b]);
+        double or = 0.5 * (self->spc_im[a] + self->spc_im[b]);
+        double oi = -0.5 * (self->spc_re[a] - self->spc_re[b]);
+        double xr = er + self->spc_tw_re[k] * or - self->spc_tw_im[k] * oi;
+        double xi = ei + self->spc_tw_re[k] * oi + self->spc_tw_im[k] * or;
+        self->spc_power[k] += xr * xr + xi * xi;
+    }
+}
+
+static void
+sfwspectrum_evaluate(SfwSpectrum *self)
+{
+    SfwSpectrumFeatures *feat = &self->spc_features;
+    const size_t         m    = self->spc_size / 2;
+    const double         bin  = feat->rate / self->spc_size;
+
+    size_t peak = 1;
+    feat->total_energy = 0.0;
+    for( size_t k = 1; k <= m; ++k ) {
+        feat->total_energy += self->spc_power[k];
+        if( self->spc_power[peak] < self->spc_power[k] )
+            peak = k;
+    }
+
+    /* Parabolic interpolation for sub-bin peak position */
+    double delta = 0.0;
+    if( peak < m ) {
+        double p0 = self->spc_power[peak - 1];
+        double p1 = self->spc_power[peak];
+        double p2 = self->spc_power[peak + 1];
+        double den = p0 - 2.0 * p1 + p2;
+        if( den < 0.0 )
+            delta = 0.5 * (p0 - p2) / den;
+    }
+    feat->peak_frequency = (peak + delta) * bin;
+    feat->peak_energy    = self->spc_power[peak];
+
+    for( size_t b = 0; b < feat->band_count; ++b ) {
+        double sum = 0.0;
+        for( size_t k = 1; k <= m; ++k ) {
+            double f = k * bin;
+            if( f >= self->spc_band_lo[b] && f < self->spc_band_hi[b] )
+                sum += self->spc_power[k];
+        }
+        feat->band_energy[b] = sum;
+    }
+}
+
+static bool
+sfwspectrum_analyze(SfwSpectrum *self)
+{
+    const size_t n = self->spc_size;
+    const size_t m = n / 2;
+
+    uint64_t t_newest = self->spc_times[(self->spc_head + n - 1) % n];
+    uint64_t t_oldest = self->spc_times[self->spc_head];
+    if( t_newest <= t_oldest )
+        return false;
+
+    for( size_t k = 0; k <= m; ++k )
+        self->spc_power[k] = 0.0;
+    for( size_t axis = 0; axis < 3; ++axis )
+        sfwspectrum_axis(self, self->spc_ring[axis]);
+
+    /* Scale to one-sided mean square, compensating for window */
+    double scale = 1.0 / (n * self->spc_window_energy);
+    for( size_t k = 0; k <= m; ++k )
+        self->spc_power[k] *= (k == 0 || k == m) ? scale : 2.0 * scale;
+
+    self->spc_features.timestamp = t_newest;
+    self->spc_features.rate      = (n - 1) * 1e6 / (t_newest - t_oldest);
+    sfwspectrum_evaluate(self);
+    return true;
+}
+
+/** Create spectral analyzer
+ *
+ * @param size  frame size, power of two within SFWSPECTRUM_SIZE_MIN
+ *              and SFWSPECTRUM_SIZE_MAX
+ * @param hop   number of samples between frames, 1 ... size
+ *
+ * @return analyzer, or NULL on invalid parameters
+ */
+SfwSpectrum *
+sfwspectrum_new(size_t size, size_t hop)
+{
+    SfwSpectrum *self = NULL;
+
+    if( size < SFWSPECTRUM_SIZE_MIN || size > SFWSPECTRUM_SIZE_MAX ||
+        (size & (size - 1)) ) {
+        sfwlog_warning("invalid spectrum size: %zu", size);
+        goto EXIT;
+    }
+    if( hop < 1 || hop > size ) {
+        sfwlog_warning("invalid spectrum hop: %zu", hop);
+        goto EXIT;
+    }
+
+    const size_t m = size / 2;
+
+    self = g_new0(SfwSpectrum, 1);
+    self->spc_size   = size;
+    self->spc_hop    = hop;
+    for( size_t axis = 0; axis < 3; ++axis )
+        self->spc_ring[axis] = g_new0(float, size);
+    self->spc_times  = g_new0(uint64_t, size);
+    self->spc_window = g_new0(float, size);
+    self->spc_re     = g_new0(float, m);
+    self->spc_im     = g_new0(float, m);
+    self->spc_tw_re  = g_new0(float, m + 1);
+    self->spc_tw_im  = g_new0(float, m + 1);
+    self->spc_bitrev = g_new0(uint32_t, m);
+    self->spc_power  = g_new0(double, m + 1);
+
+    for( size_t i = 0; i < size; ++i ) {
+        double w = 0.5 * (1.0 - cos(2.0 * M_PI * i / size));
+        self->spc_window[i] = (float)w;
+        self->spc_window_energy += w * w;
+    }
+
+    for( size_t k = 0; k <= m; ++k ) {
+        self->spc_tw_re[k] = (float)cos(-2.0 * M_PI * k / size);
+        self->spc_tw_im[k] = (float)sin(-2.0 * M_PI * k / size);
+    }
+
+    size_t bits = 0;
+    while( (1u << bits) < m )
+        ++bits;
+    for( uint32_t i = 0; i < m; ++i ) {
+        uint32_t r = 0;
+        for( size_t b = 0; b < bits; ++b )
+            r |= ((i >> b) & 1u) << (bits - 1 - b);
+        self->spc_bitrev[i] = r;
+    }
+
+EXIT:
+    return self;
+}
+
+void
+sfwspectrum_delete(SfwSpectrum *self)
+{
+    if( self ) {
+        for( size_t axis = 0; axis < 3; ++axis )
+            g_free(self->spc_ring[axis]);
+        g_free(self->spc_times);
+        g_free(self->spc_window);
+        g_free(self->spc_re);
+        g_free(self->spc_im);
+        g_free(self->spc_tw_re);
+        g_free(self->spc_tw_im);
+        g_free(self->spc_bitrev);
+        g_free(self->spc_power);
+        g_free(self);
+    }
+}
+
+void
+sfwspectrum_delete_at(SfwSpectrum **pself)
+{
+    sfwspectrum_delete(*pself), *pself = NULL;
+}
+
+/** Discard collected samples; configured bands are retained
+ */
+void
+sfwspectrum_reset(SfwSpectrum *self)
+{
+    if( self ) {
+        self->spc_head    = 0;
+        self->spc_fill    = 0;
+        self->spc_pending = 0;
+    }
+}
+
+size_t
+sfwspectrum_size(const SfwSpectrum *self)
+{
+    return self ? self->spc_size : 0;
+}
+
+size_t
+sfwspectrum_hop(const SfwSpectrum *self)
+{
+    return self ? self->spc_hop : 0;
+}
+
+/** Add frequency band [lo_hz, hi_hz) for energy evaluation
+ *
+ * @return true if band was added, false otherwise
+ */
+bool
+sfwspectrum_add_band(SfwSpectrum *self, double lo_hz, double hi_hz)
+{
+    bool ack = false;
+
+    if( !self || !(lo_hz >= 0.0 && lo_hz < hi_hz) )
+        goto EXIT;
+
+    SfwSpectrumFeatures *feat = &self->spc_features;
+    if( feat->band_count >= SFWSPECTRUM_BANDS_MAX ) {
+        sfwlog_warning("too many spectrum bands");
+        goto EXIT;
+    }
+
+    self->spc_band_lo[feat->band_count] = lo_hz;
+    self->spc_band_hi[feat->band_count] = hi_hz;
+    feat->band_energy[feat->band_count] = 0.0;
+    feat->band_count++;
+    ack = true;
+
+EXIT:
+    return ack;
+}
+
+/** Add xyz sample
+ *
+ * @return true if a new frame was analyzed, false otherwise
+ */
+bool
+sfwspectrum_add(SfwSpectrum *self, const SfwSample *sample)
+{
+    bool ack = false;
+
+    if( !self )
+        goto EXIT;
+
+    /* Time going backwards invalidates collected frame */
+    if( self->spc_fill > 0 ) {
+        size_t prev = (self->spc_head + self->spc_size - 1) % self->spc_size;
+        if( sample->timestamp < self->spc_times[prev] )
+            sfwspectrum_reset(self);
+    }
+
+    self->spc_ring[0][self->spc_head] = sample->xyz.x;
+    self->spc_ring[1][self->spc_head] = sample->xyz.y;
+    self->spc_ring[2][self->spc_head] = sample->xyz.z;
+    self->spc_times[self->spc_head]   = sample->timestamp;
+    if( ++self->spc_head == self->spc_size )
+        self->spc_head = 0;
+    if( self->spc_fill < self->spc_size )
+        self->spc_fill++;
+
+    if( ++self->spc_pending < self->spc_hop || self->spc_fill < self->spc_size )
+        goto EXIT;
+
+    self->spc_pending = 0;
+    ack = sfwspectrum_analyze(self);
+
+EXIT:
+    return ack;
+}
+
+/** Get features from the latest analyzed frame
+ */
+const SfwSpectrumFeatures *
+sfwspectrum_features(const SfwSpectrum *self)
+{
+    return self ? &self->spc_features : NULL;
+}
+
+/** Copy power spectrum of the latest analyzed frame
+ *
+ * Bin k corresponds to frequency k * rate / size.
+ *
+ * @return number of bins copied, at most size / 2 + 1
+ */
+size_t
+sfwspectrum_power(const SfwSpectrum *self, double *out, size_t max)
+{
+    size_t cnt = 0;
+    if( self ) {
+        cnt = MIN(max, self->spc_size / 2 + 1);
+        for( size_t k = 0; k < cnt; ++k )
+            out[k] = self->spc_power[k];
+    }
+    return cnt;
+}
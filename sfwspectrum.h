@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef SFWSPECTRUM_H_
+# define SFWSPECTRUM_H_
+
+# include "sfwtypes.h"
+
+G_BEGIN_DECLS
+
+# pragma GCC visibility push(default)
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Smallest supported analysis frame size */
+# define SFWSPECTRUM_SIZE_MIN 8
+
+/** Largest supported analysis frame size */
+# define SFWSPECTRUM_SIZE_MAX 4096
+
+/** Maximum number of energy bands */
+# define SFWSPECTRUM_BANDS_MAX 8
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+/** Features derived from one analysis frame
+ *
+ * Energies are mean square values in squared sample units, summed
+ * over x, y and z axes, i.e. band energies of all bands covering the
+ * whole spectrum add up to total energy.
+ */
+typedef struct SfwSpectrumFeatures
+{
+    /** Timestamp of the newest sample in the frame [us] */
+    uint64_t timestamp;
+
+    /** Sample rate estimated from frame timestamps [Hz] */
+    double   rate;
+
+    /** Frequency of the strongest non-DC component [Hz] */
+    double   peak_frequency;
+
+    /** Energy at the peak frequency bin */
+    double   peak_energy;
+
+    /** Energy over all non-DC frequencies */
+    double   total_energy;
+
+    /** Number of valid entries in band_energy */
+    size_t   band_count;
+
+    /** Energy within each band, in order of sfwspectrum_add_band() */
+    double   band_energy[SFWSPECTRUM_BANDS_MAX];
+} SfwSpectrumFeatures;
+
+/** Spectral analysis of xyz samples over overlapping frames
+ *
+ * Samples are collected to a ring buffer. Once the buffer is full,
+ * and after every hop samples from there on, the frame is Hann
+ * windowed, the mean of each axis removed, and power spectrum
+ * evaluated with a built-in real FFT.
+ */
+typedef struct SfwSpectrum SfwSpectrum;
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWSPECTRUM
+ * ------------------------------------------------------------------------- */
+
+SfwSpectrum               *sfwspectrum_new      (size_t size, size_t hop);
+void                       sfwspectrum_delete   (SfwSpectrum *self);
+void                       sfwspectrum_delete_at(SfwSpectrum **pself);
+void                       sfwspectrum_reset    (SfwSpectrum *self);
+size_t                     sfwspectrum_size     (const SfwSpectrum *self);
+size_t                     sfwspectrum_hop      (const SfwSpectrum *self);
+bool                       sfwspectrum_add_band (SfwSpectrum *self, double lo_hz, double hi_hz);
+bool                       sfwspectrum_add      (SfwSpectrum *self, const SfwSample *sample);
+const SfwSpectrumFeatures *sfwspectrum_features (const SfwSpectrum *self);
+size_t                     sfwspectrum_power    (const SfwSpectrum *self, double *out, size_t max);
+
+# pragma GCC visibility pop
+
+G_END_DECLS
+
+#endif /* SFWSPECTRUM_H_ */
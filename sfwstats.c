@@ -0,0 +1,407 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "sfwstats.h"
+
+#include "sfwlogging.h"
+
+#include <math.h>
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Initial window capacity; grown in powers of two as needed */
+#define SFWSTATS_INITIAL_CAPACITY 64
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+typedef struct SfwStatsEntry
+{
+    uint64_t se_timestamp;
+    double   se_value;
+} SfwStatsEntry;
+
+/** Monotonic deque of window sequence numbers
+ *
+ * Values at the stored sequence numbers are kept strictly ordered, so
+ * that the front entry is always the extreme value within the window.
+ */
+typedef struct SfwStatsDeque
+{
+    uint64_t  sd_head;
+    uint64_t  sd_tail;
+    uint64_t *sd_seq;
+} SfwStatsDeque;
+
+struct SfwStats
+{
+    SfwSensorId    sts_sensor_id;
+    size_t         sts_channel;
+    size_t         sts_limit;
+    uint64_t       sts_window;
+
+    /* Window entries, indexed by sequence number modulo capacity */
+    size_t         sts_capacity;
+    uint64_t       sts_head;
+    uint64_t       sts_tail;
+    SfwStatsEntry *sts_entries;
+
+    /* Running aggregates (Welford) */
+    double         sts_mean;
+    double         sts_m2;
+
+    SfwStatsDeque  sts_min;
+    SfwStatsDeque  sts_max;
+};
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWSTATS
+ * ------------------------------------------------------------------------- */
+
+static inline SfwStatsEntry *sfwstats_entry       (const SfwStats *self, uint64_t seq);
+static double                sfwstats_value       (const SfwStats *self, const SfwSample *sample);
+static void                  sfwstats_grow        (SfwStats *self);
+static void                  sfwstats_deque_push  (SfwStats *self, SfwStatsDeque *deque, uint64_t seq, bool is_max);
+static void                  sfwstats_pop         (SfwStats *self);
+SfwStats                    *sfwstats_new         (SfwSensorId id, size_t channel, size_t count, uint64_t window_us);
+void                         sfwstats_delete      (SfwStats *self);
+void                         sfwstats_delete_at   (SfwStats **pself);
+void                         sfwstats_delete_cb   (void *self);
+void                         sfwstats_reset       (SfwStats *self);
+void                         sfwstats_add         (SfwStats *self, const SfwSample *sample);
+void                         sfwstats_expire      (SfwStats *self, uint64_t now);
+size_t                       sfwstats_channel     (const SfwStats *self);
+size_t                       sfwstats_count       (const SfwStats *self);
+double                       sfwstats_mean        (const SfwStats *self);
+double                       sfwstats_variance    (const SfwStats *self);
+double                       sfwstats_stddev      (const SfwStats *self);
+double                       sfwstats_rms         (const SfwStats *self);
+double                       sfwstats_min         (const SfwStats *self);
+double                       sfwstats_max         (const SfwStats *self);
+
+/* ========================================================================= *
+ * SFWSTATS
+ * ========================================================================= */
+
+static inline SfwStatsEntry *
+sfwstats_entry(const SfwStats *self, uint64_t seq)
+{
+    return &self->sts_entries[seq & (self->sts_capacity - 1)];
+}
+
+static double
+sfwstats_value(const SfwStats *self, const SfwSample *sample)
+{
+    if( self->sts_channel != SFWSTATS_MAGNITUDE )
+        return sfwsample_channel(self->sts_sensor_id, sample, self->sts_channel);
+
+    double sum = 0.0;
+    for( size_t i = 0; i < 3; ++i ) {
+        double val = sfwsample_channel(self->sts_sensor_id, sample, i);
+        sum += val * val;
+    }
+    return sqrt(sum);
+}
+
+/** Double capacity, keeping sequence number to slot mapping valid
+ */
+static void
+sfwstats_grow(SfwStats *self)
+{
+    size_t         capacity = self->sts_capacity * 2;
+    SfwStatsEntry *entries  = g_new0(SfwStatsEntry, capacity);
+    uint64_t      *mins     = g_new0(uint64_t, capacity);
+    uint64_t      *maxs     = g_new0(uint64_t, capacity);
+
+    for( uint64_t seq = self->sts_head; seq != self->sts_tail; ++seq )
+        entries[seq & (capacity - 1)] = *sfwstats_entry(self, seq);
+
+    for( uint64_t i = self->sts_min.sd_head; i != self->sts_min.sd_tail; ++i )
+        mins[i & (capacity - 1)] = self->sts_min.sd_seq[i & (self->sts_capacity - 1)];
+    for( uint64_t i = self->sts_max.sd_head; i != self->sts_max.sd_tail; ++i )
+        maxs[i & (capacity - 1)] = self->sts_max.sd_seq[i & (self->sts_capacity - 1)];
+
+    g_free(self->sts_entries), self->sts_entries = entries;
+    g_free(self->sts_min.sd_seq), self->sts_min.sd_seq = mins;
+    g_free(self->sts_max.sd_seq), self->sts_max.sd_seq = maxs;
+    self->sts_capacity = capacity;
+}
+
+static void
+sfwstats_deque_push(SfwStats *self, SfwStatsDeque *deque, uint64_t seq, bool is_max)
+{
+    const size_t mask  = self->sts_capacity - 1;
+    double       value = sfwstats_entry(self, seq)->se_value;
+
+    /* Entries that can no longer become the extreme value are dropped */
+    while( deque->sd_tail != deque->sd_head ) {
+        double prev = sfwstats_entry(self, deque->sd_seq[(deque->sd_tail - 1) & mask])->se_value;
+        if( is_max ? (prev > value) : (prev < value) )
+            break;
+        deque->sd_tail--;
+    }
+    deque->sd_seq[deque->sd_tail++ & mask] = seq;
+}
+
+/** Remove the oldest entry from the window
+ */
+static void
+sfwstats_pop(SfwStats *self)
+{
+    const size_t mask = self->sts_capacity - 1;
+    uint64_t     seq  = self->sts_head++;
+    double       val  = sfwstats_entry(self, seq)->se_value;
+    size_t       cnt  = self->sts_tail - self->sts_head;
+
+    if( cnt == 0 ) {
+        self->sts_mean = 0.0;
+        self->sts_m2   = 0.0;
+    }
+    else {
+        double delta = val - self->sts_mean;
+        self->sts_mean -= delta / cnt;
+        self->sts_m2   -= delta * (val - self->sts_mean);
+        if( self->sts_m2 < 0.0 )
+            self->sts_m2 = 0.0;
+    }
+
+    if( self->sts_min.sd_head != self->sts_min.sd_tail &&
+        self->sts_min.sd_seq[self->sts_min.sd_head & mask] == seq )
+        self->sts_min.sd_head++;
+    if( self->sts_max.sd_head != self->sts_max.sd_tail &&
+        self->sts_max.sd_seq[self->sts_max.sd_head & mask] == seq )
+        self->sts_max.sd_head++;
+}
+
+/** Create sliding window statistics
+ *
+ * @param id         sensor type of samples that are going to be added
+ * @param channel    value channel, or SFWSTATS_MAGNITUDE
+ * @param count      maximum number of samples in window, or zero
+ * @param window_us  maximum time span of window, or zero
+ *
+ * @return statistics object, or NULL on invalid parameters
+ */
+SfwStats *
+sfwstats_new(SfwSensorId id, size_t channel, size_t count, uint64_t window_us)
+{
+    SfwStats *self = NULL;
+
+    if( channel == SFWSTATS_MAGNITUDE ) {
+        if( !sfwsensorid_is_xyz(id) && id != SFW_SENSOR_ID_MAGNETOMETER ) {
+            sfwlog_warning("%s: magnitude not applicable",
+                           sfwsensorid_name(id));
+            goto EXIT;
+        }
+    }
+    else if( channel >= sfwsensorid_channel_count(id) ) {
+        sfwlog_warning("%s: invalid channel %zu", sfwsensorid_name(id), channel);
+        goto EXIT;
+    }
+
+    if( count == 0 && window_us == 0 ) {
+        sfwlog_warning("unbounded statistics window");
+        goto EXIT;
+    }
+
+    self = g_new0(SfwStats, 1);
+    self->sts_sensor_id  = id;
+    self->sts_channel    = channel;
+    self->sts_limit      = count;
+    self->sts_window     = window_us;
+    self->sts_capacity   = SFWSTATS_INITIAL_CAPACITY;
+    self->sts_entries    = g_new0(SfwStatsEntry, self->sts_capacity);
+    self->sts_min.sd_seq = g_new0(uint64_t, self->sts_capacity);
+    self->sts_max.sd_seq = g_new0(uint64_t, self->sts_capacity);
+
+EXIT:
+    return self;
+}
+
+void
+sfwstats_delete(SfwStats *self)
+{
+    if( self ) {
+        g_free(self->sts_entries);
+        g_free(self->sts_min.sd_seq);
+        g_free(self->sts_max.sd_seq);
+        g_free(self);
+    }
+}
+
+void
+sfwstats_delete_at(SfwStats **pself)
+{
+    sfwstats_delete(*pself), *pself = NULL;
+}
+
+void
+sfwstats_delete_cb(void *self)
+{
+    sfwstats_delete(self);
+}
+
+void
+sfwstats_reset(SfwStats *self)
+{
+    if( self ) {
+        self->sts_head = self->sts_tail = 0;
+        self->sts_mean = self->sts_m2   = 0.0;
+        self->sts_min.sd_head = self->sts_min.sd_tail = 0;
+        self->sts_max.sd_head = self->sts_max.sd_tail = 0;
+    }
+}
+
+/** Add sample to window, expiring old entries as needed
+ */
+void
+sfwstats_add(SfwStats *self, const SfwSample *sample)
+{
+    if( !self )
+        goto EXIT;
+
+    /* Time going backwards invalidates the window */
+    if( self->sts_tail != self->sts_head &&
+        sample->timestamp < sfwstats_entry(self, self->sts_tail - 1)->se_timestamp )
+        sfwstats_reset(self);
+
+    if( self->sts_limit && self->sts_tail - self->sts_head == self->sts_limit )
+        sfwstats_pop(self);
+
+    if( self->sts_tail - self->sts_head == self->sts_capacity )
+        sfwstats_grow(self);
+
+    uint64_t       seq   = self->sts_tail++;
+    SfwStatsEntry *entry = sfwstats_entry(self, seq);
+    entry->se_timestamp  = sample->timestamp;
+    entry->se_value      = sfwstats_value(self, sample);
+
+    double delta = entry->se_value - self->sts_mean;
+    self->sts_mean += delta / (self->sts_tail - self->sts_head);
+    self->sts_m2   += delta * (entry->se_value - self->sts_mean);
+
+    sfwstats_deque_push(self, &self->sts_min, seq, false);
+    sfwstats_deque_push(self, &self->sts_max, seq, true);
+
+    sfwstats_expire(self, sample->timestamp);
+
+EXIT:
+    return;
+}
+
+/** Drop entries older than window time span from given time
+ *
+ * @param now  reference time, in sample timestamp domain
+ */
+void
+sfwstats_expire(SfwStats *self, uint64_t now)
+{
+    if( !self || !self->sts_window || now < self->sts_window )
+        goto EXIT;
+
+    uint64_t limit = now - self->sts_window;
+    while( self->sts_tail != self->sts_head &&
+           sfwstats_entry(self, self->sts_head)->se_timestamp <= limit )
+        sfwstats_pop(self);
+
+EXIT:
+    return;
+}
+
+size_t
+sfwstats_channel(const SfwStats *self)
+{
+    return self->sts_channel;
+}
+
+size_t
+sfwstats_count(const SfwStats *self)
+{
+    return self ? self->sts_tail - self->sts_head : 0;
+}
+
+double
+sfwstats_mean(const SfwStats *self)
+{
+    return self ? self->sts_mean : 0.0;
+}
+
+/** Get population variance of values within window
+ */
+double
+sfwstats_variance(const SfwStats *self)
+{
+    size_t cnt = sfwstats_count(self);
+    return cnt ? self->sts_m2 / cnt : 0.0;
+}
+
+double
+sfwstats_stddev(const SfwStats *self)
+{
+    return sqrt(sfwstats_variance(self));
+}
+
+double
+sfwstats_rms(const SfwStats *self)
+{
+    return self ? sqrt(self->sts_mean * self->sts_mean + sfwstats_variance(self)) : 0.0;
+}
+
+double
+sfwstats_min(const SfwStats *self)
+{
+    if( !self || self->sts_min.sd_head == self->sts_min.sd_tail )
+        return 0.0;
+    uint64_t seq = self->sts_min.sd_seq[self->sts_min.sd_head & (self->sts_capacity - 1)];
+    return sfwstats_entry(self, seq)->se_value;
+}
+
+double
+sfwstats_max(const SfwStats *self)
+{
+    if( !self || self->sts_max.sd_head == self->sts_max.sd_tail )
+        return 0.0;
+    uint64_t seq = self->sts_max.sd_seq[self->sts_max.sd_head & (self->sts_capacity - 1)];
+    return sfwstats_entry(self, seq)->se_value;
+}
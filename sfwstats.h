@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef SFWSTATS_H_
+# define SFWSTATS_H_
+
+# include "sfwtypes.h"
+
+G_BEGIN_DECLS
+
+# pragma GCC visibility push(default)
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Pseudo channel for vector magnitude of xyz / magnetometer data */
+# define SFWSTATS_MAGNITUDE ((size_t)-1)
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+/** Sliding window aggregates over one sample channel
+ *
+ * Mean, variance, RMS, minimum and maximum are maintained
+ * incrementally as samples are added and expire from the window,
+ * so that adding a sample and querying aggregates are both
+ * amortized constant time operations.
+ *
+ * The window can be limited by sample count, by time span, or both.
+ * Time based expiry is evaluated against the newest sample, or
+ * explicitly via sfwstats_expire().
+ */
+typedef struct SfwStats SfwStats;
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWSTATS
+ * ------------------------------------------------------------------------- */
+
+SfwStats *sfwstats_new      (SfwSensorId id, size_t channel, size_t count, uint64_t window_us);
+void      sfwstats_delete   (SfwStats *self);
+void      sfwstats_delete_at(SfwStats **pself);
+void      sfwstats_delete_cb(void *self);
+void      sfwstats_reset    (SfwStats *self);
+void      sfwstats_add      (SfwStats *self, const SfwSample *sample);
+void      sfwstats_expire   (SfwStats *self, uint64_t now);
+size_t    sfwstats_channel  (const SfwStats *self);
+size_t    sfwstats_count    (const SfwStats *self);
+double    sfwstats_mean     (const SfwStats *self);
+double    sfwstats_variance (const SfwStats *self);
+double    sfwstats_stddev   (const SfwStats *self);
+double    sfwstats_rms      (const SfwStats *self);
+double    sfwstats_min      (const SfwStats *self);
+double    sfwstats_max      (const SfwStats *self);
+
+# pragma GCC visibility pop
+
+G_END_DECLS
+
+#endif /* SFWSTATS_H_ */
@@ -0,0 +1,504 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "sfwtrace.h"
+
+#include "sfwlogging.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <inttypes.h>
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+/** Fixed size trace ring entry
+ *
+ * Only pointers to static strings are stored, formatting is
+ * postponed until the ring is written to file.
+ */
+typedef struct SfwTraceEvent
+{
+    int64_t      tev_time;
+    const char  *tev_what;
+    uint64_t     tev_value;
+    guint        tev_track;
+    SfwTraceType tev_type;
+} SfwTraceEvent;
+
+/** Timeline track - one per traced object
+ */
+typedef struct SfwTraceTrack
+{
+    const void  *trk_object;
+    gchar       *trk_name;
+
+    /** Ring head after the latest event on this track */
+    uint64_t     trk_last;
+} SfwTraceTrack;
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWTRACE_TRACK
+ * ------------------------------------------------------------------------- */
+
+static guint sfwtrace_track_lookup(const void *object, const char *cls, const char *name);
+static void  sfwtrace_track_clear (void);
+
+/* ------------------------------------------------------------------------- *
+ * SFWTRACE_RING
+ * ------------------------------------------------------------------------- */
+
+static void sfwtrace_ring_add(guint track, SfwTraceType type, const char *what, uint64_t value);
+
+/* ------------------------------------------------------------------------- *
+ * SFWTRACE_EXPORT
+ * ------------------------------------------------------------------------- */
+
+static void sfwtrace_export_string(FILE *file, const char *str);
+static void sfwtrace_export_header(FILE *file, bool *first, const char *ph, guint track, int64_t time);
+static bool sfwtrace_export      (const char *path);
+
+/* ------------------------------------------------------------------------- *
+ * SFWTRACE
+ * ------------------------------------------------------------------------- */
+
+static void sfwtrace_probe_environment(void);
+static void sfwtrace_atexit_cb        (void);
+bool        sfwtrace_start            (const char *path, size_t events);
+void        sfwtrace_stop             (void);
+bool        sfwtrace_flush            (void);
+bool        sfwtrace_is_enabled       (void);
+void        sfwtrace_state_           (const void *object, const char *cls, const char *name, const char *state);
+void        sfwtrace_event_           (const void *object, const char *cls, const char *name, SfwTraceType type, const char *what, uint64_t value);
+void        sfwtrace_forget           (const void *object);
+
+/* ========================================================================= *
+ * Data
+ * ========================================================================= */
+
+/** Lock for ring and track bookkeeping */
+static GMutex         sfwtrace_mutex;
+
+/** Tracing state: -1 = environment not probed yet, 0 = off, 1 = on */
+static int            sfwtrace_enabled     = -1;
+
+/** Path to trace file */
+static gchar         *sfwtrace_path        = NULL;
+
+/** Event ring and its capacity */
+static SfwTraceEvent *sfwtrace_ring        = NULL;
+static size_t         sfwtrace_ring_size   = 0;
+
+/** Number of events recorded since start; ring index = head % size */
+static uint64_t       sfwtrace_ring_head   = 0;
+
+/** Timeline tracks; track id = array index + 1 */
+static SfwTraceTrack *sfwtrace_track_lut   = NULL;
+static guint          sfwtrace_track_count = 0;
+
+/** Whether flush at exit has been registered */
+static bool           sfwtrace_atexit_done = false;
+
+/* ========================================================================= *
+ * SFWTRACE_TRACK
+ * ========================================================================= */
+
+/** Get track for object, creating one if needed
+ *
+ * Tracks retired via sfwtrace_forget() are reused, so that the table
+ * does not grow when objects are repeatedly created and destroyed. A
+ * retired track with the same name is preferred, so that e.g. a
+ * recreated sensor continues on the same timeline. Otherwise a retired
+ * track is reused only after all its events have left the ring.
+ */
+static guint
+sfwtrace_track_lookup(const void *object, const char *cls, const char *name)
+{
+    SfwTraceTrack *track = NULL;
+    guint          idle  = 0;
+
+    for( guint i = 0; i < sfwtrace_track_count; ++i ) {
+        if( sfwtrace_track_lut[i].trk_object == object )
+            return i + 1;
+    }
+
+    gchar *full = (name
+                   ? g_strdup_printf("%s(%s)", cls, name)
+                   : g_strdup(cls));
+
+    for( guint i = 0; i < sfwtrace_track_count; ++i ) {
+        SfwTraceTrack *retired = &sfwtrace_track_lut[i];
+        if( retired->trk_object )
+            continue;
+        if( !strcmp(retired->trk_name, full) ) {
+            track = retired;
+            break;
+        }
+        if( !idle && retired->trk_last + sfwtrace_ring_size <= sfwtrace_ring_head )
+            idle = i + 1;
+    }
+
+    if( !track && idle )
+        track = &sfwtrace_track_lut[idle - 1];
+
+    if( !track ) {
+        sfwtrace_track_lut = g_renew(SfwTraceTrack, sfwtrace_track_lut,
+                                     sfwtrace_track_count + 1);
+        track = &sfwtrace_track_lut[sfwtrace_track_count++];
+        track->trk_name = NULL;
+    }
+
+    track->trk_object = object;
+    g_free(track->trk_name), track->trk_name = full;
+    return (guint)(track - sfwtrace_track_lut) + 1;
+}
+
+static void
+sfwtrace_track_clear(void)
+{
+    for( guint i = 0; i < sfwtrace_track_count; ++i )
+        g_free(sfwtrace_track_lut[i].trk_name);
+    g_free(sfwtrace_track_lut),
+        sfwtrace_track_lut = NULL;
+    sfwtrace_track_count = 0;
+}
+
+/* ========================================================================= *
+ * SFWTRACE_RING
+ * ========================================================================= */
+
+static void
+sfwtrace_ring_add(guint track, SfwTraceType type, const char *what,
+                  uint64_t value)
+{
+    SfwTraceEvent *event = &sfwtrace_ring[sfwtrace_ring_head++ % sfwtrace_ring_size];
+    event->tev_time  = g_get_monotonic_time();
+    event->tev_what  = what;
+    event->tev_value = value;
+    event->tev_track = track;
+    event->tev_type  = type;
+}
+
+/* ========================================================================= *
+ * SFWTRACE_EXPORT
+ * ========================================================================= */
+
+static void
+sfwtrace_export_string(FILE *file, const char *str)
+{
+    fputc('"', file);
+    for( const char *pos = str ?: "unknown"; *pos; ++pos ) {
+        int ch = (unsigned char)*pos;
+        if( ch == '"' || ch == '\\' )
+            fprintf(file, "\\%c", ch);
+        else if( ch < 32 )
+            fprintf(file, "\\u%04x", ch);
+        else
+            fputc(ch, file);
+    }
+    fputc('"', file);
+}
+
+static void
+sfwtrace_export_header(FILE *file, bool *first, const char *ph, guint track,
+                       int64_t time)
+{
+    fprintf(file, "%s{\"ph\":\"%s\",\"pid\":%d,\"tid\":%u,\"ts\":%" PRId64,
+            *first ? "" : ",\n", ph, (int)getpid(), track, time);
+    *first = false;
+}
+
+static bool
+sfwtrace_export(const char *path)
+{
+    bool         ack         = false;
+    gchar       *temp        = g_strdup_printf("%s.tmp", path);
+    FILE        *file        = NULL;
+    bool         first       = true;
+    int64_t      now         = g_get_monotonic_time();
+    const char **state_name  = g_new0(const char *, sfwtrace_track_count + 1);
+    int64_t     *state_time  = g_new0(int64_t, sfwtrace_track_count + 1);
+    uint64_t     tail        = 0;
+
+    if( !(file = fopen(temp, "w")) ) {
+        sfwlog_err("%s: can't open: %m", temp);
+        goto EXIT;
+    }
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    /* Name the timeline tracks */
+    for( guint i = 0; i < sfwtrace_track_count; ++i ) {
+        sfwtrace_export_header(file, &first, "M", i + 1, 0);
+        fprintf(file, ",\"name\":\"thread_name\",\"args\":{\"name\":");
+        sfwtrace_export_string(file, sfwtrace_track_lut[i].trk_name);
+        fprintf(file, "}}");
+    }
+
+    /* Oldest to newest event still held in the ring */
+    if( sfwtrace_ring_head > sfwtrace_ring_size )
+        tail = sfwtrace_ring_head - sfwtrace_ring_size;
+
+    for( uint64_t i = tail; i < sfwtrace_ring_head; ++i ) {
+        const SfwTraceEvent *event = &sfwtrace_ring[i % sfwtrace_ring_size];
+        guint                track = event->tev_track;
+
+        switch( event->tev_type ) {
+        case SFWTRACE_STATE:
+            /* State slice lasts until the next state change */
+            if( state_name[track] ) {
+                sfwtrace_export_header(file, &first, "X", track, state_time[track]);
+                fprintf(file, ",\"dur\":%" PRId64 ",\"cat\":\"state\",\"name\":",
+                        event->tev_time - state_time[track]);
+                sfwtrace_export_string(file, state_name[track]);
+                fprintf(file, "}");
+            }
+            state_name[track] = event->tev_what;
+            state_time[track] = event->tev_time;
+            break;
+        case SFWTRACE_ASYNC_BEGIN:
+        case SFWTRACE_ASYNC_END:
+            sfwtrace_export_header(file, &first,
+                                   event->tev_type == SFWTRACE_ASYNC_BEGIN ? "b" : "e",
+                                   track, event->tev_time);
+            fprintf(file, ",\"cat\":\"dbus\",\"id\":\"0x%" PRIx64 "\",\"name\":",
+                    event->tev_value);
+            sfwtrace_export_string(file, event->tev_what);
+            fprintf(file, "}");
+            break;
+        case SFWTRACE_BEGIN:
+        case SFWTRACE_END:
+            sfwtrace_export_header(file, &first,
+                                   event->tev_type == SFWTRACE_BEGIN ? "B" : "E",
+                                   track, event->tev_time);
+            fprintf(file, ",\"cat\":\"dispatch\",\"name\":");
+            sfwtrace_export_string(file, event->tev_what);
+            fprintf(file, "}");
+            break;
+        case SFWTRACE_INSTANT:
+            sfwtrace_export_header(file, &first, "i", track, event->tev_time);
+            fprintf(file, ",\"s\":\"t\",\"cat\":\"io\",\"name\":");
+            sfwtrace_export_string(file, event->tev_what);
+            fprintf(file, "}");
+            break;
+        case SFWTRACE_COUNTER:
+            sfwtrace_export_header(file, &first, "C", track, event->tev_time);
+            fprintf(file, ",\"name\":");
+            sfwtrace_export_string(file, event->tev_what);
+            fprintf(file, ",\"args\":{\"value\":%" PRIu64 "}}", event->tev_value);
+            break;
+        default:
+            break;
+        }
+    }
+
+    /* States that are still in effect */
+    for( guint track = 1; track <= sfwtrace_track_count; ++track ) {
+        if( !state_name[track] )
+            continue;
+        sfwtrace_export_header(file, &first, "X", track, state_time[track]);
+        fprintf(file, ",\"dur\":%" PRId64 ",\"cat\":\"state\",\"name\":",
+                now - state_time[track]);
+        sfwtrace_export_string(file, state_name[track]);
+        fprintf(file, "}");
+    }
+
+    fprintf(file, "\n]}\n");
+
+    if( ferror(file) ) {
+        sfwlog_err("%s: write error", temp);
+        goto EXIT;
+    }
+
+    if( fclose(file) == EOF ) {
+        file = NULL;
+        sfwlog_err("%s: can't close: %m", temp);
+        goto EXIT;
+    }
+    file = NULL;
+
+    if( rename(temp, path) == -1 ) {
+        sfwlog_err("%s: can't rename to %s: %m", temp, path);
+        goto EXIT;
+    }
+
+    ack = true;
+
+EXIT:
+    if( file )
+        fclose(file);
+    if( !ack )
+        unlink(temp);
+    g_free(state_time);
+    g_free(state_name);
+    g_free(temp);
+    return ack;
+}
+
+/* ========================================================================= *
+ * SFWTRACE
+ * ========================================================================= */
+
+static void
+sfwtrace_probe_environment(void)
+{
+    sfwtrace_enabled = 0;
+
+    const char *path = getenv(SFWTRACE_ENV_PATH);
+    if( path && *path ) {
+        const char *text   = getenv(SFWTRACE_ENV_EVENTS);
+        size_t      events = text ? strtoul(text, NULL, 0) : 0;
+        sfwtrace_start(path, events);
+    }
+}
+
+static void
+sfwtrace_atexit_cb(void)
+{
+    sfwtrace_stop();
+}
+
+bool
+sfwtrace_start(const char *path, size_t events)
+{
+    if( !path || !*path )
+        return false;
+
+    if( events < 1 )
+        events = SFWTRACE_DEFAULT_EVENTS;
+
+    g_mutex_lock(&sfwtrace_mutex);
+
+    g_free(sfwtrace_path),
+        sfwtrace_path = g_strdup(path);
+    g_free(sfwtrace_ring),
+        sfwtrace_ring = g_new0(SfwTraceEvent, events);
+    sfwtrace_ring_size = events;
+    sfwtrace_ring_head = 0;
+    sfwtrace_track_clear();
+    sfwtrace_enabled = 1;
+
+    if( !sfwtrace_atexit_done ) {
+        sfwtrace_atexit_done = true;
+        atexit(sfwtrace_atexit_cb);
+    }
+
+    g_mutex_unlock(&sfwtrace_mutex);
+
+    sfwlog_info("tracing to %s, ring size %zu events", path, events);
+    return true;
+}
+
+void
+sfwtrace_stop(void)
+{
+    if( sfwtrace_enabled <= 0 )
+        return;
+
+    sfwtrace_flush();
+
+    g_mutex_lock(&sfwtrace_mutex);
+    sfwtrace_enabled = 0;
+    g_free(sfwtrace_ring),
+        sfwtrace_ring = NULL;
+    sfwtrace_ring_size = 0;
+    sfwtrace_ring_head = 0;
+    sfwtrace_track_clear();
+    g_free(sfwtrace_path),
+        sfwtrace_path = NULL;
+    g_mutex_unlock(&sfwtrace_mutex);
+}
+
+bool
+sfwtrace_flush(void)
+{
+    bool ack = false;
+    g_mutex_lock(&sfwtrace_mutex);
+    if( sfwtrace_enabled > 0 )
+        ack = sfwtrace_export(sfwtrace_path);
+    g_mutex_unlock(&sfwtrace_mutex);
+    return ack;
+}
+
+bool
+sfwtrace_is_enabled(void)
+{
+    if( G_UNLIKELY(sfwtrace_enabled < 0) )
+        sfwtrace_probe_environment();
+    return sfwtrace_enabled > 0;
+}
+
+void
+sfwtrace_state_(const void *object, const char *cls, const char *name,
+                const char *state)
+{
+    sfwtrace_event_(object, cls, name, SFWTRACE_STATE, state, 0);
+}
+
+void
+sfwtrace_event_(const void *object, const char *cls, const char *name,
+                SfwTraceType type, const char *what, uint64_t value)
+{
+    g_mutex_lock(&sfwtrace_mutex);
+    if( sfwtrace_enabled > 0 ) {
+        guint track = sfwtrace_track_lookup(object, cls, name);
+        sfwtrace_ring_add(track, type, what, value);
+        sfwtrace_track_lut[track - 1].trk_last = sfwtrace_ring_head;
+    }
+    g_mutex_unlock(&sfwtrace_mutex);
+}
+
+void
+sfwtrace_forget(const void *object)
+{
+    /* Retire the track, so that a new object allocated at the
+     * same address does not continue on it by accident. The
+     * track can be reused, see sfwtrace_track_lookup(). */
+    g_mutex_lock(&sfwtrace_mutex);
+    for( guint i = 0; i < sfwtrace_track_count; ++i ) {
+        if( sfwtrace_track_lut[i].trk_object == object )
+            sfwtrace_track_lut[i].trk_object = NULL;
+    }
+    g_mutex_unlock(&sfwtrace_mutex);
+}
@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef SFWTRACE_H_
+# define SFWTRACE_H_
+
+# include "sfwtypes.h"
+
+G_BEGIN_DECLS
+
+# pragma GCC visibility push(default)
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Environment variable: path of trace file to write at exit */
+# define SFWTRACE_ENV_PATH   "SFW_TRACE"
+
+/** Environment variable: maximum number of events held in memory */
+# define SFWTRACE_ENV_EVENTS "SFW_TRACE_EVENTS"
+
+/** Default trace ring size [events] */
+# define SFWTRACE_DEFAULT_EVENTS (64 * 1024)
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+/** Trace event types
+ *
+ * These map to Trace Event Format phases when the ring is written out.
+ */
+typedef enum SfwTraceType
+{
+    /** Track enters a state; exported as complete ("X") slices */
+    SFWTRACE_STATE,
+
+    /** Asynchronous span begin ("b"), e.g. a D-Bus method call */
+    SFWTRACE_ASYNC_BEGIN,
+
+    /** Asynchronous span end ("e") */
+    SFWTRACE_ASYNC_END,
+
+    /** Synchronous span begin ("B"), e.g. signal handler dispatch */
+    SFWTRACE_BEGIN,
+
+    /** Synchronous span end ("E") */
+    SFWTRACE_END,
+
+    /** Instant event ("i"), e.g. socket wakeup */
+    SFWTRACE_INSTANT,
+
+    /** Counter value ("C"), e.g. frame size */
+    SFWTRACE_COUNTER,
+} SfwTraceType;
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWTRACE
+ * ------------------------------------------------------------------------- */
+
+bool sfwtrace_start     (const char *path, size_t events);
+void sfwtrace_stop      (void);
+bool sfwtrace_flush     (void);
+bool sfwtrace_is_enabled(void);
+void sfwtrace_state_    (const void *object, const char *cls, const char *name, const char *state);
+void sfwtrace_event_    (const void *object, const char *cls, const char *name, SfwTraceType type, const char *what, uint64_t value);
+void sfwtrace_forget    (const void *object);
+
+/* ========================================================================= *
+ * Macros
+ * ========================================================================= */
+
+# define sfwtrace_state(OBJ, CLS, NAME, STATE)\
+     do {\
+         if( sfwtrace_is_enabled() )\
+             sfwtrace_state_(OBJ, CLS, NAME, STATE);\
+     } while( 0 )
+
+# define sfwtrace_event(OBJ, CLS, NAME, TYPE, WHAT, VALUE)\
+     do {\
+         if( sfwtrace_is_enabled() )\
+             sfwtrace_event_(OBJ, CLS, NAME, TYPE, WHAT, VALUE);\
+     } while( 0 )
+
+# pragma GCC visibility pop
+
+G_END_DECLS
+
+#endif /* SFWTRACE_H_ */
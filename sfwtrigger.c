@@ -0,0 +1,472 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "sfwtrigger.h"
+
+#include "sfwlogging.h"
+
+#include <string.h>
+#include <math.h>
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Initial size of rule table */
+#define SFWTRIGGER_INITIAL_CAPACITY 4
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+/** Rule table entry
+ */
+typedef struct SfwTriggerEntry
+{
+    guint               te_id;
+    SfwTriggerRule      te_rule;
+    SfwTriggerHandler   te_handler;
+    gpointer            te_aptr;
+
+    bool                te_primed;
+    bool                te_state;
+    bool                te_pending;
+    uint64_t            te_since;
+} SfwTriggerEntry;
+
+struct SfwTrigger
+{
+    SfwSensorId         trg_sensor_id;
+
+    SfwTriggerEntry    *trg_rules;
+    size_t              trg_count;
+    size_t              trg_capacity;
+    guint               trg_id;
+
+    /* Rules removed while evaluating are compacted afterwards */
+    bool                trg_busy;
+    bool                trg_removed;
+
+    SfwSensor          *trg_source;
+    guint               trg_source_id;
+};
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWTRIGGER_ENTRY
+ * ------------------------------------------------------------------------- */
+
+static bool sfwtrigger_entry_eval(SfwTriggerEntry *entry, double value, uint64_t t);
+
+/* ------------------------------------------------------------------------- *
+ * SFWTRIGGER
+ * ------------------------------------------------------------------------- */
+
+static void sfwtrigger_compact    (SfwTrigger *self);
+static void sfwtrigger_evaluate   (SfwTrigger *self, const SfwReading *reading);
+static void sfwtrigger_reading_cb (SfwSensor *sensor, const SfwReading *reading, gpointer aptr);
+SfwTrigger *sfwtrigger_new        (SfwSensorId id);
+void        sfwtrigger_delete     (SfwTrigger *self);
+void        sfwtrigger_delete_at  (SfwTrigger **pself);
+SfwSensorId sfwtrigger_sensor_id  (const SfwTrigger *self);
+guint       sfwtrigger_add_rule   (SfwTrigger *self, const SfwTriggerRule *rule, SfwTriggerHandler handler, gpointer aptr);
+void        sfwtrigger_remove_rule(SfwTrigger *self, guint id);
+size_t      sfwtrigger_rule_count (const SfwTrigger *self);
+void        sfwtrigger_reset      (SfwTrigger *self);
+bool        sfwtrigger_attach     (SfwTrigger *self, SfwSensor *sensor);
+void        sfwtrigger_detach     (SfwTrigger *self);
+void        sfwtrigger_add        (SfwTrigger *self, const SfwReading *reading);
+void        sfwtrigger_add_batch  (SfwTrigger *self, const SfwReading *readings, size_t count);
+
+/* ========================================================================= *
+ * SFWTRIGGER_ENTRY
+ * ========================================================================= */
+
+/** Update rule state with a new value
+ *
+ * @return true if handler should be called, false otherwise
+ */
+static bool
+sfwtrigger_entry_eval(SfwTriggerEntry *entry, double value, uint64_t t)
+{
+    const SfwTriggerRule *rule = &entry->te_rule;
+    bool                  met  = false;
+
+    if( rule->condition == SFW_TRIGGER_BELOW ) {
+        met = entry->te_state
+            ? value < rule->threshold + rule->hysteresis
+            : value < rule->threshold;
+    }
+    else {
+        met = entry->te_state
+            ? value > rule->threshold - rule->hysteresis
+            : value > rule->threshold;
+    }
+
+    /* Crossing rules start from whatever side the value is on */
+    if( !entry->te_primed ) {
+        entry->te_primed = true;
+        if( rule->condition == SFW_TRIGGER_CROSSING ) {
+            entry->te_state = met;
+            return false;
+        }
+    }
+
+    if( met == entry->te_state ) {
+        entry->te_pending = false;
+        return false;
+    }
+
+    if( !entry->te_pending || t < entry->te_since ) {
+        entry->te_pending = true;
+        entry->te_since   = t;
+    }
+
+    if( t - entry->te_since < rule->duration )
+        return false;
+
+    entry->te_pending = false;
+    entry->te_state   = met;
+    return met || rule->condition == SFW_TRIGGER_CROSSING;
+}
+
+/* ========================================================================= *
+ * SFWTRIGGER
+ * ========================================================================= */
+
+static void
+sfwtrigger_compact(SfwTrigger *self)
+{
+    size_t n = 0;
+    for( size_t i = 0; i < self->trg_count; ++i ) {
+        if( self->trg_rules[i].te_id )
+            self->trg_rules[n++] = self->trg_rules[i];
+    }
+    self->trg_count   = n;
+    self->trg_removed = false;
+}
+
+/** Evaluate all rules against one reading
+ *
+ * Channel values are fetched once per reading, handlers are called
+ * only for rules that change state.
+ */
+static void
+sfwtrigger_evaluate(SfwTrigger *self, const SfwReading *reading)
+{
+    SfwSensorId      id     = self->trg_sensor_id;
+    const SfwSample *sample = &reading->sample;
+    size_t           cnt    = sfwsensorid_channel_count(id);
+    double           val[SFW_SAMPLE_CHANNELS_MAX + 1];
+    bool             have[SFW_SAMPLE_CHANNELS_MAX + 1] = { false };
+
+    for( size_t i = 0; i < self->trg_count; ++i ) {
+        SfwTriggerEntry *entry = &self->trg_rules[i];
+        if( !entry->te_id )
+            continue;
+
+        /* Magnitude is cached after the real channels */
+        size_t ch = entry->te_rule.channel;
+        if( ch == SFWSTATS_MAGNITUDE )
+            ch = cnt;
+
+        if( !have[ch] ) {
+            if( ch == cnt ) {
+                double sum = 0.0;
+                for( size_t j = 0; j < 3; ++j ) {
+                    double v = sfwsample_channel(id, sample, j);
+                    sum += v * v;
+                }
+                val[ch] = sqrt(sum);
+            }
+            else {
+                val[ch] = sfwsample_channel(id, sample, ch);
+            }
+            have[ch] = true;
+        }
+
+        if( !sfwtrigger_entry_eval(entry, val[ch], sample->timestamp) )
+            continue;
+
+        /* Handler may add or remove rules; do not cache entry */
+        guint             rule    = entry->te_id;
+        bool              state   = entry->te_state;
+        SfwTriggerHandler handler = entry->te_handler;
+        gpointer          aptr    = entry->te_aptr;
+        handler(self, rule, reading, state, aptr);
+    }
+}
+
+static void
+sfwtrigger_reading_cb(SfwSensor *sensor, const SfwReading *reading,
+                      gpointer aptr)
+{
+    (void)sensor;
+    sfwtrigger_add(aptr, reading);
+}
+
+/** Create empty rule table for readings of given sensor type
+ */
+SfwTrigger *
+sfwtrigger_new(SfwSensorId id)
+{
+    SfwTrigger *self = NULL;
+
+    if( !sfwsensorid_is_valid(id) )
+        goto EXIT;
+
+    self = g_new0(SfwTrigger, 1);
+    self->trg_sensor_id = id;
+    self->trg_capacity  = SFWTRIGGER_INITIAL_CAPACITY;
+    self->trg_rules     = g_new0(SfwTriggerEntry, self->trg_capacity);
+
+EXIT:
+    return self;
+}
+
+void
+sfwtrigger_delete(SfwTrigger *self)
+{
+    if( self ) {
+        sfwtrigger_detach(self);
+        g_free(self->trg_rules);
+        g_free(self);
+    }
+}
+
+void
+sfwtrigger_delete_at(SfwTrigger **pself)
+{
+    sfwtrigger_delete(*pself), *pself = NULL;
+}
+
+SfwSensorId
+sfwtrigger_sensor_id(const SfwTrigger *self)
+{
+    return self ? self->trg_sensor_id : SFW_SENSOR_ID_INVALID;
+}
+
+/** Add rule to table
+ *
+ * @return rule id, or 0 on failure
+ */
+guint
+sfwtrigger_add_rule(SfwTrigger *self, const SfwTriggerRule *rule,
+                    SfwTriggerHandler handler, gpointer aptr)
+{
+    guint id = 0;
+
+    if( !self || !rule || !handler )
+        goto EXIT;
+
+    SfwSensorId sensor_id = self->trg_sensor_id;
+    if( rule->channel == SFWSTATS_MAGNITUDE ) {
+        if( !sfwsensorid_is_xyz(sensor_id) &&
+            sensor_id != SFW_SENSOR_ID_MAGNETOMETER ) {
+            sfwlog_warning("%s: magnitude not applicable",
+                           sfwsensorid_name(sensor_id));
+            goto EXIT;
+        }
+    }
+    else if( rule->channel >= sfwsensorid_channel_count(sensor_id) ) {
+        sfwlog_warning("%s: invalid channel %zu",
+                       sfwsensorid_name(sensor_id), rule->channel);
+        goto EXIT;
+    }
+
+    if( rule->hysteresis < 0.0 ) {
+        sfwlog_warning("negative hysteresis");
+        goto EXIT;
+    }
+
+    if( self->trg_count == self->trg_capacity ) {
+        self->trg_capacity *= 2;
+        self->trg_rules = g_renew(SfwTriggerEntry, self->trg_rules,
+                                  self->trg_capacity);
+    }
+
+    if( ++self->trg_id == 0 )
+        ++self->trg_id;
+    id = self->trg_id;
+
+    SfwTriggerEntry *entry = &self->trg_rules[self->trg_count++];
+    memset(entry, 0, sizeof *entry);
+    entry->te_id      = id;
+    entry->te_rule    = *rule;
+    entry->te_handler = handler;
+    entry->te_aptr    = aptr;
+
+EXIT:
+    return id;
+}
+
+/** Remove rule from table
+ *
+ * Can be called from trigger handlers.
+ */
+void
+sfwtrigger_remove_rule(SfwTrigger *self, guint id)
+{
+    if( !self || !id )
+        goto EXIT;
+
+    for( size_t i = 0; i < self->trg_count; ++i ) {
+        if( self->trg_rules[i].te_id == id ) {
+            self->trg_rules[i].te_id = 0;
+            self->trg_removed = true;
+            break;
+        }
+    }
+
+    if( self->trg_removed && !self->trg_busy )
+        sfwtrigger_compact(self);
+
+EXIT:
+    return;
+}
+
+size_t
+sfwtrigger_rule_count(const SfwTrigger *self)
+{
+    size_t count = 0;
+    if( self ) {
+        for( size_t i = 0; i < self->trg_count; ++i )
+            if( self->trg_rules[i].te_id )
+                ++count;
+    }
+    return count;
+}
+
+/** Forget rule states, e.g. after sensor has been restarted
+ */
+void
+sfwtrigger_reset(SfwTrigger *self)
+{
+    if( self ) {
+        for( size_t i = 0; i < self->trg_count; ++i ) {
+            SfwTriggerEntry *entry = &self->trg_rules[i];
+            entry->te_primed  = false;
+            entry->te_state   = false;
+            entry->te_pending = false;
+        }
+    }
+}
+
+/** Start evaluating rules for readings of an already open sensor
+ *
+ * Rules are evaluated in the sensor reading callback context, so that
+ * the application is woken up only when some rule fires.
+ *
+ * @return true if sensor was attached, false otherwise
+ */
+bool
+sfwtrigger_attach(SfwTrigger *self, SfwSensor *sensor)
+{
+    bool ack = false;
+
+    if( !self || !sensor )
+        goto EXIT;
+
+    if( sfwreading_sensor_id(sfwsensor_reading(sensor)) != self->trg_sensor_id ) {
+        sfwlog_warning("%s: not applicable for %s trigger",
+                       sfwsensor_name(sensor),
+                       sfwsensorid_name(self->trg_sensor_id));
+        goto EXIT;
+    }
+
+    sfwtrigger_detach(self);
+    self->trg_source_id =
+        sfwsensor_add_reading_callback(sensor, sfwtrigger_reading_cb, self);
+    if( !self->trg_source_id )
+        goto EXIT;
+    self->trg_source = sfwsensor_ref(sensor);
+    ack = true;
+
+EXIT:
+    return ack;
+}
+
+/** Stop evaluating rules for attached sensor
+ */
+void
+sfwtrigger_detach(SfwTrigger *self)
+{
+    if( self && self->trg_source ) {
+        sfwsensor_remove_reading_callback(self->trg_source,
+                                          self->trg_source_id);
+        self->trg_source_id = 0;
+        sfwsensor_unref_at(&self->trg_source);
+    }
+}
+
+/** Evaluate rules against one reading
+ */
+void
+sfwtrigger_add(SfwTrigger *self, const SfwReading *reading)
+{
+    if( self && reading )
+        sfwtrigger_add_batch(self, reading, 1);
+}
+
+/** Evaluate rules against an array of readings
+ *
+ * Suitable for use from sfwsensor_set_worker() batch callbacks, in
+ * which case handlers are called from the worker thread.
+ */
+void
+sfwtrigger_add_batch(SfwTrigger *self, const SfwReading *readings,
+                     size_t count)
+{
+    if( !self || !readings || self->trg_busy )
+        goto EXIT;
+
+    self->trg_busy = true;
+    for( size_t i = 0; i < count; ++i ) {
+        if( readings[i].sensor_id == self->trg_sensor_id )
+            sfwtrigger_evaluate(self, &readings[i]);
+    }
+    self->trg_busy = false;
+
+    if( self->trg_removed )
+        sfwtrigger_compact(self);
+
+EXIT:
+    return;
+}
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef SFWTRIGGER_H_
+# define SFWTRIGGER_H_
+
+# include "sfwsensor.h"
+
+G_BEGIN_DECLS
+
+# pragma GCC visibility push(default)
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+/** Trigger rule conditions
+ */
+typedef enum SfwTriggerCondition
+{
+    /** Value is above threshold; fires when condition starts */
+    SFW_TRIGGER_ABOVE,
+
+    /** Value is below threshold; fires when condition starts */
+    SFW_TRIGGER_BELOW,
+
+    /** Value crosses threshold; fires on both rising and falling
+     *  edges, but not for the value seen initially */
+    SFW_TRIGGER_CROSSING,
+} SfwTriggerCondition;
+
+/** Threshold / duration rule evaluated for every reading
+ *
+ * For example "|accel| > 2g for 50 ms" is channel SFWSTATS_MAGNITUDE,
+ * condition SFW_TRIGGER_ABOVE, threshold 2 * 9.80665 and duration
+ * 50000, while "proximity becomes covered" is channel 1 of proximity
+ * sensor, condition SFW_TRIGGER_ABOVE and threshold 0.5.
+ */
+typedef struct SfwTriggerRule
+{
+    /** Value channel, or SFWSTATS_MAGNITUDE */
+    size_t              channel;
+
+    /** How value is compared against threshold */
+    SfwTriggerCondition condition;
+
+    /** Threshold value */
+    double              threshold;
+
+    /** Distance from threshold the value needs to move back
+     *  before condition is considered ended */
+    double              hysteresis;
+
+    /** Time condition must persist before it is reported [us] */
+    uint64_t            duration;
+} SfwTriggerRule;
+
+/** Table of trigger rules evaluated over readings of one sensor
+ */
+typedef struct SfwTrigger SfwTrigger;
+
+/** Callback for receiving trigger events
+ *
+ * @param id       rule id from sfwtrigger_add_rule()
+ * @param reading  reading that completed the condition
+ * @param state    true if condition started, false if it ended
+ */
+typedef void (*SfwTriggerHandler)(SfwTrigger *trigger, guint id, const SfwReading *reading, bool state, gpointer aptr);
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWTRIGGER
+ * ------------------------------------------------------------------------- */
+
+SfwTrigger *sfwtrigger_new        (SfwSensorId id);
+void        sfwtrigger_delete     (SfwTrigger *self);
+void        sfwtrigger_delete_at  (SfwTrigger **pself);
+SfwSensorId sfwtrigger_sensor_id  (const SfwTrigger *self);
+guint       sfwtrigger_add_rule   (SfwTrigger *self, const SfwTriggerRule *rule, SfwTriggerHandler handler, gpointer aptr);
+void        sfwtrigger_remove_rule(SfwTrigger *self, guint id);
+size_t      sfwtrigger_rule_count (const SfwTrigger *self);
+void        sfwtrigger_reset      (SfwTrigger *self);
+bool        sfwtrigger_attach     (SfwTrigger *self, SfwSensor *sensor);
+void        sfwtrigger_detach     (SfwTrigger *self);
+void        sfwtrigger_add        (SfwTrigger *self, const SfwReading *reading);
+void        sfwtrigger_add_batch  (SfwTrigger *self, const SfwReading *readings, size_t count);
+
+# pragma GCC visibility pop
+
+G_END_DECLS
+
+#endif /* SFWTRIGGER_H_ */
@@ -41,7 +41,16 @@
 #include "sfwdbus.h"
 
 #include <stdio.h>
+#include <stddef.h>
+#include <stdarg.h>
 #include <inttypes.h>
+#include <math.h>
+
+#if defined(__SSE__)
+# include <xmmintrin.h>
+#elif defined(__ARM_NEON)
+# include <arm_neon.h>
+#endif
 
 /* ========================================================================= *
  * Constants
@@ -55,8 +64,8 @@
  * Types
  * ========================================================================= */
 
-typedef const char *(*SfwSampleReprFunc)(const void *aptr);
-typedef void (*SfwReadingNormalizeFunc)(SfwReading *reading);
+typedef char *(*SfwSampleReprFunc)(const void *aptr, char *buf, size_t len);
+typedef void (*SfwSampleNormalizeFunc)(SfwSample *samples, size_t count);
 
 typedef struct SfwSensorInfo
 {
@@ -65,8 +74,10 @@ typedef struct SfwSensorInfo
     const char             *sti_sensor_interface;
     const char             *sti_value_method;
     size_t                  sti_sample_size;
+    size_t                  sti_channel_count;
+    bool                    sti_channel_float;
     SfwSampleReprFunc       sti_sample_repr_cb;
-    SfwReadingNormalizeFunc sti_normalize_cb;
+    SfwSampleNormalizeFunc  sti_normalize_cb;
 } SfwSensorInfo;
 
 /* ========================================================================= *
@@ -77,12 +88,15 @@ typedef struct SfwSensorInfo
  * SFWSENSORID
  * ------------------------------------------------------------------------- */
 
-bool                        sfwsensorid_is_valid   (SfwSensorId id);
-static const SfwSensorInfo *sfwsensorid_info       (SfwSensorId id);
-const char                 *sfwsensorid_name       (SfwSensorId id);
-size_t                      sfwsensorid_sample_size(SfwSensorId id);
-const char                 *sfwsensorid_interface  (SfwSensorId id);
-const char                 *sfwsensorid_object     (SfwSensorId id);
+bool                        sfwsensorid_is_valid     (SfwSensorId id);
+static const SfwSensorInfo *sfwsensorid_info         (SfwSensorId id);
+const char                 *sfwsensorid_name         (SfwSensorId id);
+size_t                      sfwsensorid_sample_size  (SfwSensorId id);
+size_t                      sfwsensorid_channel_count(SfwSensorId id);
+bool                        sfwsensorid_channel_float(SfwSensorId id);
+bool                        sfwsensorid_is_xyz       (SfwSensorId id);
+const char                 *sfwsensorid_interface    (SfwSensorId id);
+const char                 *sfwsensorid_object       (SfwSensorId id);
 
 /* ------------------------------------------------------------------------- *
  * SFWREADING
@@ -90,11 +104,11 @@ const char                 *sfwsensorid_object     (SfwSensorId id);
 
 SfwSensorId                   sfwreading_sensor_id       (const SfwReading *self);
 const char                   *sfwreading_repr            (const SfwReading *self);
+char                         *sfwreading_repr_to_buf     (const SfwReading *self, char *buf, size_t len);
+static bool                   sfwreading_append          (char *buf, size_t size, size_t *pos, const char *fmt, ...) __attribute__((format(printf, 4, 5)));
+static bool                   sfwreading_format_line     (const SfwReading *self, SfwReadingFormat format, char *buf, size_t size, size_t *pos);
+size_t                        sfwreading_format_batch    (const SfwReading *readings, size_t count, SfwReadingFormat format, char *buf, size_t size, size_t *used);
 void                          sfwreading_normalize       (SfwReading *self);
-static void                   sfwreading_accelerometer_cb(SfwReading *reading);
-static void                   sfwreading_gyroscope_cb    (SfwReading *reading);
-static void                   sfwreading_magnetometer_cb (SfwReading *reading);
-static void                   sfwreading_compass_cb      (SfwReading *reading);
 const SfwSampleXyz           *sfwreading_xyz             (const SfwReading *self);
 const SfwSampleAls           *sfwreading_als             (const SfwReading *self);
 const SfwSampleProximity     *sfwreading_proximity       (const SfwReading *self);
@@ -111,24 +125,58 @@ const SfwSampleStepcounter   *sfwreading_stepcounter     (const SfwReading *self
 const SfwSampleTap           *sfwreading_tap             (const SfwReading *self);
 const SfwSampleTemperature   *sfwreading_temperature     (const SfwReading *self);
 
+/* ------------------------------------------------------------------------- *
+ * SFWSAMPLE_NORMALIZE
+ * ------------------------------------------------------------------------- */
+
+static inline void sfwsample_normalize_level           (int32_t *plevel);
+static void        sfwsample_scale_xyz                 (SfwSample *samples, size_t count, float scale);
+void               sfwsample_normalize                 (SfwSensorId id, SfwSample *samples, size_t count);
+double             sfwsample_channel                   (SfwSensorId id, const SfwSample *sample, size_t channel);
+static void        sfwsample_normalize_accelerometer_cb(SfwSample *samples, size_t count);
+static void        sfwsample_normalize_gyroscope_cb    (SfwSample *samples, size_t count);
+static void        sfwsample_normalize_magnetometer_cb (SfwSample *samples, size_t count);
+static void        sfwsample_normalize_compass_cb      (SfwSample *samples, size_t count);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSAMPLE_SOA
+ * ------------------------------------------------------------------------- */
+
+void sfwsample_xyz_to_soa       (const SfwSample *samples, size_t count, uint64_t *t, float *x, float *y, float *z);
+void sfwsample_xyz_to_soa_double(const SfwSample *samples, size_t count, uint64_t *t, double *x, double *y, double *z);
+
 /* ------------------------------------------------------------------------- *
  * SFWSAMPLE
  * ------------------------------------------------------------------------- */
 
-const char *sfwsampleals_repr          (const SfwSampleAls *self);
-const char *sfwsampleproximity_repr    (const SfwSampleProximity *self);
-const char *sfwsampleorientation_repr  (const SfwSampleOrientation *self);
-const char *sfwsampleaccelerometer_repr(const SfwSampleAccelerometer *self);
-const char *sfwsamplecompass_repr      (const SfwSampleCompass *self);
-const char *sfwsamplegyroscope_repr    (const SfwSampleGyroscope *self);
-const char *sfwsamplelid_repr          (const SfwSampleLid *self);
-const char *sfwsamplehumidity_repr     (const SfwSampleHumidity *self);
-const char *sfwsamplemagnetometer_repr (const SfwSampleMagnetometer *self);
-const char *sfwsamplepressure_repr     (const SfwSamplePressure *self);
-const char *sfwsamplerotation_repr     (const SfwSampleRotation *self);
-const char *sfwsamplestepcounter_repr  (const SfwSampleStepcounter *self);
-const char *sfwsampletap_repr          (const SfwSampleTap *self);
-const char *sfwsampletemperature_repr  (const SfwSampleTemperature *self);
+const char *sfwsampleals_repr                 (const SfwSampleAls *self);
+char       *sfwsampleals_repr_to_buf          (const SfwSampleAls *self, char *buf, size_t len);
+const char *sfwsampleproximity_repr           (const SfwSampleProximity *self);
+char       *sfwsampleproximity_repr_to_buf    (const SfwSampleProximity *self, char *buf, size_t len);
+const char *sfwsampleorientation_repr         (const SfwSampleOrientation *self);
+char       *sfwsampleorientation_repr_to_buf  (const SfwSampleOrientation *self, char *buf, size_t len);
+const char *sfwsampleaccelerometer_repr       (const SfwSampleAccelerometer *self);
+char       *sfwsampleaccelerometer_repr_to_buf(const SfwSampleAccelerometer *self, char *buf, size_t len);
+const char *sfwsamplecompass_repr             (const SfwSampleCompass *self);
+char       *sfwsamplecompass_repr_to_buf      (const SfwSampleCompass *self, char *buf, size_t len);
+const char *sfwsamplegyroscope_repr           (const SfwSampleGyroscope *self);
+char       *sfwsamplegyroscope_repr_to_buf    (const SfwSampleGyroscope *self, char *buf, size_t len);
+const char *sfwsamplelid_repr                 (const SfwSampleLid *self);
+char       *sfwsamplelid_repr_to_buf          (const SfwSampleLid *self, char *buf, size_t len);
+const char *sfwsamplehumidity_repr            (const SfwSampleHumidity *self);
+char       *sfwsamplehumidity_repr_to_buf     (const SfwSampleHumidity *self, char *buf, size_t len);
+const char *sfwsamplemagnetometer_repr        (const SfwSampleMagnetometer *self);
+char       *sfwsamplemagnetometer_repr_to_buf (const SfwSampleMagnetometer *self, char *buf, size_t len);
+const char *sfwsamplepressure_repr            (const SfwSamplePressure *self);
+char       *sfwsamplepressure_repr_to_buf     (const SfwSamplePressure *self, char *buf, size_t len);
+const char *sfwsamplerotation_repr            (const SfwSampleRotation *self);
+char       *sfwsamplerotation_repr_to_buf     (const SfwSampleRotation *self, char *buf, size_t len);
+const char *sfwsamplestepcounter_repr         (const SfwSampleStepcounter *self);
+char       *sfwsamplestepcounter_repr_to_buf  (const SfwSampleStepcounter *self, char *buf, size_t len);
+const char *sfwsampletap_repr                 (const SfwSampleTap *self);
+char       *sfwsampletap_repr_to_buf          (const SfwSampleTap *self, char *buf, size_t len);
+const char *sfwsampletemperature_repr         (const SfwSampleTemperature *self);
+char       *sfwsampletemperature_repr_to_buf  (const SfwSampleTemperature *self, char *buf, size_t len);
 
 /* ------------------------------------------------------------------------- *
  * SFWORIENTATIONSTATE
@@ -172,7 +220,9 @@ static const SfwSensorInfo typeinfo_lut[SFW_SENSOR_ID_COUNT] = {
         .sti_sensor_interface = SFWDBUS_SENSOR_INTERFACE_PROXIMITY,
         .sti_value_method     = SFWDBUS_SENSOR_METHOD_GET_PROXIMITY,
         .sti_sample_size      = sizeof(SfwSampleProximity),
-        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsampleproximity_repr),
+        .sti_channel_count    = 2,
+        .sti_channel_float    = false,
+        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsampleproximity_repr_to_buf),
         .sti_normalize_cb     = NULL, // if needed: reading_proximity_cb,
     },
     [SFW_SENSOR_ID_ALS] = {
@@ -181,7 +231,9 @@ static const SfwSensorInfo typeinfo_lut[SFW_SENSOR_ID_COUNT] = {
         .sti_sensor_interface = SFWDBUS_SENSOR_INTERFACE_ALS,
         .sti_value_method     = SFWDBUS_SENSOR_METHOD_GET_ALS,
         .sti_sample_size      = sizeof(SfwSampleAls),
-        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsampleals_repr),
+        .sti_channel_count    = 1,
+        .sti_channel_float    = false,
+        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsampleals_repr_to_buf),
         .sti_normalize_cb     = NULL, // if needed: reading_als_cb,
     },
     [SFW_SENSOR_ID_ORIENTATION] = {
@@ -190,7 +242,9 @@ static const SfwSensorInfo typeinfo_lut[SFW_SENSOR_ID_COUNT] = {
         .sti_sensor_interface = SFWDBUS_SENSOR_INTERFACE_ORIENTATION,
         .sti_value_method     = SFWDBUS_SENSOR_METHOD_GET_ORIENTATION,
         .sti_sample_size      = sizeof(SfwSampleOrientation),
-        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsampleorientation_repr),
+        .sti_channel_count    = 1,
+        .sti_channel_float    = false,
+        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsampleorientation_repr_to_buf),
         .sti_normalize_cb     = NULL, // if needed: reading_orientation_cb,
     },
     [SFW_SENSOR_ID_ACCELEROMETER] = {
@@ -199,8 +253,10 @@ static const SfwSensorInfo typeinfo_lut[SFW_SENSOR_ID_COUNT] = {
         .sti_sensor_interface = SFWDBUS_SENSOR_INTERFACE_ACCELEROMETER,
         .sti_value_method     = SFWDBUS_SENSOR_METHOD_GET_ACCELEROMETER,
         .sti_sample_size      = sizeof(SfwSampleAccelerometer),
-        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsampleaccelerometer_repr),
-        .sti_normalize_cb     = sfwreading_accelerometer_cb,
+        .sti_channel_count    = 3,
+        .sti_channel_float    = true,
+        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsampleaccelerometer_repr_to_buf),
+        .sti_normalize_cb     = sfwsample_normalize_accelerometer_cb,
     },
     [SFW_SENSOR_ID_COMPASS] = {
         .sti_sensor_name      = SFWDBUS_SENSOR_NAME_COMPASS,
@@ -208,8 +264,10 @@ static const SfwSensorInfo typeinfo_lut[SFW_SENSOR_ID_COUNT] = {
         .sti_sensor_interface = SFWDBUS_SENSOR_INTERFACE_COMPASS,
         .sti_value_method     = SFWDBUS_SENSOR_METHOD_GET_COMPASS,
         .sti_sample_size      = sizeof(SfwSampleCompass),
-        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsamplecompass_repr),
-        .sti_normalize_cb     = sfwreading_compass_cb,
+        .sti_channel_count    = 4,
+        .sti_channel_float    = false,
+        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsamplecompass_repr_to_buf),
+        .sti_normalize_cb     = sfwsample_normalize_compass_cb,
     },
     [SFW_SENSOR_ID_GYROSCOPE] = {
         .sti_sensor_name      = SFWDBUS_SENSOR_NAME_GYROSCOPE,
@@ -217,8 +275,10 @@ static const SfwSensorInfo typeinfo_lut[SFW_SENSOR_ID_COUNT] = {
         .sti_sensor_interface = SFWDBUS_SENSOR_INTERFACE_GYROSCOPE,
         .sti_value_method     = SFWDBUS_SENSOR_METHOD_GET_GYROSCOPE,
         .sti_sample_size      = sizeof(SfwSampleGyroscope),
-        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsamplegyroscope_repr),
-        .sti_normalize_cb     = sfwreading_gyroscope_cb,
+        .sti_channel_count    = 3,
+        .sti_channel_float    = true,
+        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsamplegyroscope_repr_to_buf),
+        .sti_normalize_cb     = sfwsample_normalize_gyroscope_cb,
     },
     [SFW_SENSOR_ID_LID] = {
         .sti_sensor_name      = SFWDBUS_SENSOR_NAME_LID,
@@ -226,7 +286,9 @@ static const SfwSensorInfo typeinfo_lut[SFW_SENSOR_ID_COUNT] = {
         .sti_sensor_interface = SFWDBUS_SENSOR_INTERFACE_LID,
         .sti_value_method     = SFWDBUS_SENSOR_METHOD_GET_LID,
         .sti_sample_size      = sizeof(SfwSampleLid),
-        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsamplelid_repr),
+        .sti_channel_count    = 2,
+        .sti_channel_float    = false,
+        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsamplelid_repr_to_buf),
         .sti_normalize_cb     = NULL, // if needed: reading_lid_cb,
     },
     [SFW_SENSOR_ID_HUMIDITY] = {
@@ -235,7 +297,9 @@ static const SfwSensorInfo typeinfo_lut[SFW_SENSOR_ID_COUNT] = {
         .sti_sensor_interface = SFWDBUS_SENSOR_INTERFACE_HUMIDITY,
         .sti_value_method     = SFWDBUS_SENSOR_METHOD_GET_HUMIDITY,
         .sti_sample_size      = sizeof(SfwSampleHumidity),
-        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsamplehumidity_repr),
+        .sti_channel_count    = 1,
+        .sti_channel_float    = false,
+        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsamplehumidity_repr_to_buf),
         .sti_normalize_cb     = NULL, // if needed: reading_humidity_cb,
     },
     [SFW_SENSOR_ID_MAGNETOMETER] = {
@@ -244,8 +308,10 @@ static const SfwSensorInfo typeinfo_lut[SFW_SENSOR_ID_COUNT] = {
         .sti_sensor_interface = SFWDBUS_SENSOR_INTERFACE_MAGNETOMETER,
         .sti_value_method     = SFWDBUS_SENSOR_METHOD_GET_MAGNETOMETER,
         .sti_sample_size      = sizeof(SfwSampleMagnetometer),
-        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsamplemagnetometer_repr),
-        .sti_normalize_cb     = sfwreading_magnetometer_cb,
+        .sti_channel_count    = 7,
+        .sti_channel_float    = false,
+        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsamplemagnetometer_repr_to_buf),
+        .sti_normalize_cb     = sfwsample_normalize_magnetometer_cb,
     },
     [SFW_SENSOR_ID_PRESSURE] = {
         .sti_sensor_name      = SFWDBUS_SENSOR_NAME_PRESSURE,
@@ -253,7 +319,9 @@ static const SfwSensorInfo typeinfo_lut[SFW_SENSOR_ID_COUNT] = {
         .sti_sensor_interface = SFWDBUS_SENSOR_INTERFACE_PRESSURE,
         .sti_value_method     = SFWDBUS_SENSOR_METHOD_GET_PRESSURE,
         .sti_sample_size      = sizeof(SfwSamplePressure),
-        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsamplepressure_repr),
+        .sti_channel_count    = 1,
+        .sti_channel_float    = false,
+        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsamplepressure_repr_to_buf),
         .sti_normalize_cb     = NULL, // if needed: reading_pressure_cb,
     },
     [SFW_SENSOR_ID_ROTATION] = {
@@ -262,7 +330,9 @@ static const SfwSensorInfo typeinfo_lut[SFW_SENSOR_ID_COUNT] = {
         .sti_sensor_interface = SFWDBUS_SENSOR_INTERFACE_ROTATION,
         .sti_value_method     = SFWDBUS_SENSOR_METHOD_GET_ROTATION,
         .sti_sample_size      = sizeof(SfwSampleRotation),
-        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsamplerotation_repr),
+        .sti_channel_count    = 3,
+        .sti_channel_float    = true,
+        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsamplerotation_repr_to_buf),
         .sti_normalize_cb     = NULL, // if needed: reading_rotation_cb,
     },
     [SFW_SENSOR_ID_STEPCOUNTER] = {
@@ -271,7 +341,9 @@ static const SfwSensorInfo typeinfo_lut[SFW_SENSOR_ID_COUNT] = {
         .sti_sensor_interface = SFWDBUS_SENSOR_INTERFACE_STEPCOUNTER,
         .sti_value_method     = SFWDBUS_SENSOR_METHOD_GET_STEPCOUNTER,
         .sti_sample_size      = sizeof(SfwSampleStepcounter),
-        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsamplestepcounter_repr),
+        .sti_channel_count    = 1,
+        .sti_channel_float    = false,
+        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsamplestepcounter_repr_to_buf),
         .sti_normalize_cb     = NULL, // if needed: reading_stepcounter_cb,
     },
     [SFW_SENSOR_ID_TAP] = {
@@ -280,7 +352,9 @@ static const SfwSensorInfo typeinfo_lut[SFW_SENSOR_ID_COUNT] = {
         .sti_sensor_interface = SFWDBUS_SENSOR_INTERFACE_TAP,
         .sti_value_method     = SFWDBUS_SENSOR_METHOD_GET_TAP,
         .sti_sample_size      = sizeof(SfwSampleTap),
-        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsampletap_repr),
+        .sti_channel_count    = 2,
+        .sti_channel_float    = false,
+        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsampletap_repr_to_buf),
         .sti_normalize_cb     = NULL, // if needed: reading_tap_cb,
     },
     [SFW_SENSOR_ID_TEMPERATURE] = {
@@ -289,7 +363,9 @@ static const SfwSensorInfo typeinfo_lut[SFW_SENSOR_ID_COUNT] = {
         .sti_sensor_interface = SFWDBUS_SENSOR_INTERFACE_TEMPERATURE,
         .sti_value_method     = SFWDBUS_SENSOR_METHOD_GET_TEMPERATURE,
         .sti_sample_size      = sizeof(SfwSampleTemperature),
-        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsampletemperature_repr),
+        .sti_channel_count    = 1,
+        .sti_channel_float    = false,
+        .sti_sample_repr_cb   = SAMPLE_REPR(sfwsampletemperature_repr_to_buf),
         .sti_normalize_cb     = NULL, // if needed: reading_temperature_cb,
     },
 };
@@ -320,6 +396,35 @@ sfwsensorid_sample_size(SfwSensorId id)
     return info ? info->sti_sample_size : 0;
 }
 
+size_t
+sfwsensorid_channel_count(SfwSensorId id)
+{
+    const SfwSensorInfo *info = sfwsensorid_info(id);
+    return info ? info->sti_channel_count : 0;
+}
+
+bool
+sfwsensorid_channel_float(SfwSensorId id)
+{
+    const SfwSensorInfo *info = sfwsensorid_info(id);
+    return info ? info->sti_channel_float : false;
+}
+
+/** Check if sensor data uses SfwSampleXyz layout
+ */
+bool
+sfwsensorid_is_xyz(SfwSensorId id)
+{
+    switch( id ) {
+    case SFW_SENSOR_ID_ACCELEROMETER:
+    case SFW_SENSOR_ID_GYROSCOPE:
+    case SFW_SENSOR_ID_ROTATION:
+        return true;
+    default:
+        return false;
+    }
+}
+
 const char *
 sfwsensorid_interface(SfwSensorId id)
 {
@@ -338,13 +443,6 @@ sfwsensorid_object(SfwSensorId id)
  * SFWREADING
  * ========================================================================= */
 
-static inline void sfwreading_normalize_level(int32_t *plevel)
-{
-    int32_t level = *plevel;
-
-    *plevel = (level <= 0) ? 0 : (level >= 3) ? 100 : (level * 100 / 3);
-}
-
 SfwSensorId
 sfwreading_sensor_id(const SfwReading *self)
 {
@@ -354,61 +452,139 @@ sfwreading_sensor_id(const SfwReading *self)
 const char *
 sfwreading_repr(const SfwReading *self)
 {
-    const SfwSensorInfo *info = sfwsensorid_info(sfwreading_sensor_id(self));
-    if( info ) {
-        static char buf[128];
-        snprintf(buf, sizeof buf, "%s(%s)",
-                 info->sti_sensor_name,
-                 info->sti_sample_repr_cb(&self->sample));
-        return buf;
-    }
-    return "???";
+    static __thread char buf[128];
+    return sfwreading_repr_to_buf(self, buf, sizeof buf);
 }
 
-void
-sfwreading_normalize(SfwReading *self)
+char *
+sfwreading_repr_to_buf(const SfwReading *self, char *buf, size_t len)
 {
-    /* The idea here is to perform similar scaling and unit conversion
-     * operations as what qtsensors is already doing.
-     */
     const SfwSensorInfo *info = sfwsensorid_info(sfwreading_sensor_id(self));
     if( info ) {
-        if( info->sti_normalize_cb )
-            info->sti_normalize_cb(self);
+        char sample[96];
+        snprintf(buf, len, "%s(%s)",
+                 info->sti_sensor_name,
+                 info->sti_sample_repr_cb(&self->sample, sample, sizeof sample));
+    }
+    else {
+        snprintf(buf, len, "???");
     }
+    return buf;
 }
 
-static void
-sfwreading_accelerometer_cb(SfwReading *reading)
+/** Append formatted text to buffer
+ *
+ * @return true if text fit in the buffer, false otherwise
+ */
+static bool
+sfwreading_append(char *buf, size_t size, size_t *pos, const char *fmt, ...)
 {
-    reading->sample.accelerometer.x *= GRAVITY_EARTH_THOUSANDTH;
-    reading->sample.accelerometer.y *= GRAVITY_EARTH_THOUSANDTH;
-    reading->sample.accelerometer.z *= GRAVITY_EARTH_THOUSANDTH;
+    va_list va;
+    va_start(va, fmt);
+    int n = vsnprintf(buf + *pos, size - *pos, fmt, va);
+    va_end(va);
+    if( n < 0 || (size_t)n >= size - *pos )
+        return false;
+    *pos += n;
+    return true;
 }
 
-static void
-sfwreading_gyroscope_cb(SfwReading *reading)
+/** Append one reading as CSV / JSON line
+ *
+ * @return true if the whole line fit in the buffer, false otherwise
+ */
+static bool
+sfwreading_format_line(const SfwReading *self, SfwReadingFormat format,
+                       char *buf, size_t size, size_t *pos)
 {
-    reading->sample.gyroscope.x *= MILLI;
-    reading->sample.gyroscope.y *= MILLI;
-    reading->sample.gyroscope.z *= MILLI;
+    bool        ack   = false;
+    bool        json  = (format == SFW_READING_FORMAT_JSON);
+    SfwSensorId id    = self->sensor_id;
+    size_t      count = sfwsensorid_channel_count(id);
+    bool        fp    = sfwsensorid_channel_float(id);
+    size_t      used  = *pos;
+
+    if( !sfwreading_append(buf, size, &used,
+                           json ? "{\"sensor\":\"%s\",\"time\":%"PRIu64",\"values\":["
+                                : "%s,%"PRIu64,
+                           sfwsensorid_name(id), self->sample.timestamp) )
+        goto EXIT;
+
+    for( size_t i = 0; i < count; ++i ) {
+        double      val = sfwsample_channel(id, &self->sample, i);
+        const char *sep = (json && i == 0) ? "" : ",";
+        bool        fit;
+        if( !fp )
+            fit = sfwreading_append(buf, size, &used, "%s%"PRId64,
+                                    sep, (int64_t)val);
+        else if( json && !isfinite(val) )
+            fit = sfwreading_append(buf, size, &used, "%snull", sep);
+        else
+            fit = sfwreading_append(buf, size, &used, "%s%.9g", sep, val);
+        if( !fit )
+            goto EXIT;
+    }
+
+    if( !sfwreading_append(buf, size, &used, json ? "]}\n" : "\n") )
+        goto EXIT;
+
+    *pos = used;
+    ack = true;
+
+EXIT:
+    return ack;
 }
 
-static void
-sfwreading_magnetometer_cb(SfwReading *reading)
+/** Serialize readings as CSV or JSON lines
+ *
+ * CSV lines contain sensor name, timestamp and channel values. JSON
+ * lines contain the same as object with "sensor", "time" and "values"
+ * members. Only complete lines are written and the output is always
+ * nul terminated; invalid readings are skipped.
+ *
+ * @param readings  array of readings
+ * @param count     number of readings
+ * @param format    SFW_READING_FORMAT_CSV or SFW_READING_FORMAT_JSON
+ * @param buf       output buffer
+ * @param size      size of output buffer
+ * @param used      where to store length of output, or NULL
+ *
+ * @return number of readings consumed, less than count if buffer
+ *         filled up
+ */
+size_t
+sfwreading_format_batch(const SfwReading *readings, size_t count,
+                        SfwReadingFormat format, char *buf, size_t size,
+                        size_t *used)
 {
-#if 0 // FIXME check datatype - int or float?
-    reading->sample.magnetometer.x *= NANO;
-    reading->sample.magnetometer.y *= NANO;
-    reading->sample.magnetometer.z *= NANO;
-#endif
-    sfwreading_normalize_level(&reading->sample.magnetometer.level);
+    size_t done = 0;
+    size_t pos  = 0;
+
+    if( size == 0 )
+        goto EXIT;
+
+    for( ; done < count; ++done ) {
+        if( !sfwsensorid_is_valid(readings[done].sensor_id) )
+            continue;
+        if( !sfwreading_format_line(&readings[done], format, buf, size, &pos) )
+            break;
+    }
+    buf[pos] = 0;
+
+EXIT:
+    if( used )
+        *used = pos;
+    return done;
 }
 
-static void
-sfwreading_compass_cb(SfwReading *reading)
+void
+sfwreading_normalize(SfwReading *self)
 {
-    sfwreading_normalize_level(&reading->sample.compass.level);
+    /* The idea here is to perform similar scaling and unit conversion
+     * operations as what qtsensors is already doing.
+     */
+    if( self )
+        sfwsample_normalize(self->sensor_id, &self->sample, 1);
 }
 
 const SfwSampleXyz *
@@ -597,6 +773,236 @@ sfwreading_temperature(const SfwReading *self)
     return temperature;
 }
 
+/* ========================================================================= *
+ * SFWSAMPLE_NORMALIZE
+ * ========================================================================= */
+
+/* Vector kernels operate on x, y, z and the padding that follows */
+G_STATIC_ASSERT(offsetof(SfwSampleXyz, x) + 4 * sizeof(float) <= sizeof(SfwSample));
+
+static inline void
+sfwsample_normalize_level(int32_t *plevel)
+{
+    int32_t level = *plevel;
+
+    *plevel = (level <= 0) ? 0 : (level >= 3) ? 100 : (level * 100 / 3);
+}
+
+static void
+sfwsample_scale_xyz(SfwSample *samples, size_t count, float scale)
+{
+#if defined(__SSE__)
+    const __m128 mul = _mm_setr_ps(scale, scale, scale, 1.0f);
+    for( size_t i = 0; i < count; ++i ) {
+        float *pos = &samples[i].xyz.x;
+        _mm_storeu_ps(pos, _mm_mul_ps(_mm_loadu_ps(pos), mul));
+    }
+#elif defined(__ARM_NEON)
+    const float32x4_t mul = { scale, scale, scale, 1.0f };
+    for( size_t i = 0; i < count; ++i ) {
+        float *pos = &samples[i].xyz.x;
+        vst1q_f32(pos, vmulq_f32(vld1q_f32(pos), mul));
+    }
+#else
+    for( size_t i = 0; i < count; ++i ) {
+        samples[i].xyz.x *= scale;
+        samples[i].xyz.y *= scale;
+        samples[i].xyz.z *= scale;
+    }
+#endif
+}
+
+/** Normalize an array of samples in place
+ *
+ * Applies the same scaling and unit conversions as
+ * sfwreading_normalize(), but with one lookup per array
+ * rather than per sample.
+ */
+void
+sfwsample_normalize(SfwSensorId id, SfwSample *samples, size_t count)
+{
+    /* The idea here is to perform similar scaling and unit conversion
+     * operations as what qtsensors is already doing.
+     */
+    const SfwSensorInfo *info = sfwsensorid_info(id);
+    if( info && info->sti_normalize_cb && count > 0 )
+        info->sti_normalize_cb(samples, count);
+}
+
+/** Get value channel of a sample as double
+ *
+ * Channels are numbered in the order they appear in the data
+ * block, see sfwsensorid_channel_count().
+ *
+ * @return channel value, or zero if channel does not exist
+ */
+double
+sfwsample_channel(SfwSensorId id, const SfwSample *sample, size_t channel)
+{
+    double val = 0.0;
+
+    if( channel >= sfwsensorid_channel_count(id) )
+        goto EXIT;
+
+    switch( id ) {
+    case SFW_SENSOR_ID_PROXIMITY:
+        val = channel ? sample->proximity.proximity : sample->proximity.distance;
+        break;
+    case SFW_SENSOR_ID_ALS:
+        val = sample->als.value;
+        break;
+    case SFW_SENSOR_ID_ORIENTATION:
+        val = sample->orientation.state;
+        break;
+    case SFW_SENSOR_ID_ACCELEROMETER:
+    case SFW_SENSOR_ID_GYROSCOPE:
+    case SFW_SENSOR_ID_ROTATION:
+        val = (&sample->xyz.x)[channel];
+        break;
+    case SFW_SENSOR_ID_COMPASS:
+        val = (&sample->compass.degrees)[channel];
+        break;
+    case SFW_SENSOR_ID_LID:
+        val = channel ? (double)sample->lid.value : (double)sample->lid.type;
+        break;
+    case SFW_SENSOR_ID_HUMIDITY:
+        val = sample->humidity.value;
+        break;
+    case SFW_SENSOR_ID_MAGNETOMETER:
+        val = (&sample->magnetometer.x)[channel];
+        break;
+    case SFW_SENSOR_ID_PRESSURE:
+        val = sample->pressure.value;
+        break;
+    case SFW_SENSOR_ID_STEPCOUNTER:
+        val = sample->stepcounter.value;
+        break;
+    case SFW_SENSOR_ID_TAP:
+        val = channel ? (double)sample->tap.type : (double)sample->tap.direction;
+        break;
+    case SFW_SENSOR_ID_TEMPERATURE:
+        val = sample->temperature.temperature_value;
+        break;
+    default:
+        break;
+    }
+
+EXIT:
+    return val;
+}
+
+static void
+sfwsample_normalize_accelerometer_cb(SfwSample *samples, size_t count)
+{
+    sfwsample_scale_xyz(samples, count, GRAVITY_EARTH_THOUSANDTH);
+}
+
+static void
+sfwsample_normalize_gyroscope_cb(SfwSample *samples, size_t count)
+{
+    sfwsample_scale_xyz(samples, count, MILLI);
+}
+
+static void
+sfwsample_normalize_magnetometer_cb(SfwSample *samples, size_t count)
+{
+    for( size_t i = 0; i < count; ++i ) {
+#if 0 // FIXME check datatype - int or float?
+        samples[i].magnetometer.x *= NANO;
+        samples[i].magnetometer.y *= NANO;
+        samples[i].magnetometer.z *= NANO;
+#endif
+        sfwsample_normalize_level(&samples[i].magnetometer.level);
+    }
+}
+
+static void
+sfwsample_normalize_compass_cb(SfwSample *samples, size_t count)
+{
+    for( size_t i = 0; i < count; ++i )
+        sfwsample_normalize_level(&samples[i].compass.level);
+}
+
+/* ========================================================================= *
+ * SFWSAMPLE_SOA
+ * ========================================================================= */
+
+/** Split xyz samples into separate timestamp and channel arrays
+ *
+ * Any of the output arrays can be NULL, in which case that channel
+ * is skipped. Channel data is written with aligned vector stores
+ * when x, y and z are all 16 byte aligned.
+ */
+void
+sfwsample_xyz_to_soa(const SfwSample *samples, size_t count,
+                     uint64_t *t, float *x, float *y, float *z)
+{
+    size_t i = 0;
+
+    if( t ) {
+        for( size_t k = 0; k < count; ++k )
+            t[k] = samples[k].timestamp;
+    }
+
+#if defined(__SSE__) || defined(__ARM_NEON)
+    if( x && y && z ) {
+        for( ; i + 4 <= count; i += 4 ) {
+# if defined(__SSE__)
+            __m128 r0 = _mm_loadu_ps(&samples[i + 0].xyz.x);
+            __m128 r1 = _mm_loadu_ps(&samples[i + 1].xyz.x);
+            __m128 r2 = _mm_loadu_ps(&samples[i + 2].xyz.x);
+            __m128 r3 = _mm_loadu_ps(&samples[i + 3].xyz.x);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            if( (((uintptr_t)x | (uintptr_t)y | (uintptr_t)z) & 15) == 0 ) {
+                _mm_store_ps(x + i, r0);
+                _mm_store_ps(y + i, r1);
+                _mm_store_ps(z + i, r2);
+            }
+            else {
+                _mm_storeu_ps(x + i, r0);
+                _mm_storeu_ps(y + i, r1);
+                _mm_storeu_ps(z + i, r2);
+            }
+# else
+            float32x4x2_t p01 = vtrnq_f32(vld1q_f32(&samples[i + 0].xyz.x),
+                                          vld1q_f32(&samples[i + 1].xyz.x));
+            float32x4x2_t p23 = vtrnq_f32(vld1q_f32(&samples[i + 2].xyz.x),
+                                          vld1q_f32(&samples[i + 3].xyz.x));
+            vst1q_f32(x + i, vcombine_f32(vget_low_f32(p01.val[0]),
+                                          vget_low_f32(p23.val[0])));
+            vst1q_f32(y + i, vcombine_f32(vget_low_f32(p01.val[1]),
+                                          vget_low_f32(p23.val[1])));
+            vst1q_f32(z + i, vcombine_f32(vget_high_f32(p01.val[0]),
+                                          vget_high_f32(p23.val[0])));
+# endif
+        }
+    }
+#endif
+
+    for( ; i < count; ++i ) {
+        if( x ) x[i] = samples[i].xyz.x;
+        if( y ) y[i] = samples[i].xyz.y;
+        if( z ) z[i] = samples[i].xyz.z;
+    }
+}
+
+/** Split xyz samples into separate timestamp and double precision arrays
+ *
+ * Any of the output arrays can be NULL, in which case that channel
+ * is skipped.
+ */
+void
+sfwsample_xyz_to_soa_double(const SfwSample *samples, size_t count,
+                            uint64_t *t, double *x, double *y, double *z)
+{
+    for( size_t i = 0; i < count; ++i ) {
+        if( t ) t[i] = samples[i].timestamp;
+        if( x ) x[i] = samples[i].xyz.x;
+        if( y ) y[i] = samples[i].xyz.y;
+        if( z ) z[i] = samples[i].xyz.z;
+    }
+}
+
 /* ========================================================================= *
  * SFWSAMPLE
  * ========================================================================= */
@@ -604,8 +1010,14 @@ sfwreading_temperature(const SfwReading *self)
 const char *
 sfwsampleals_repr(const SfwSampleAls *self)
 {
-    static char buf[80];
-    snprintf(buf, sizeof buf,
+    static __thread char buf[80];
+    return sfwsampleals_repr_to_buf(self, buf, sizeof buf);
+}
+
+char *
+sfwsampleals_repr_to_buf(const SfwSampleAls *self, char *buf, size_t len)
+{
+    snprintf(buf, len,
              "time=%"PRIu64" lux=%"PRIu32,
              self->timestamp,
              self->value);
@@ -615,8 +1027,14 @@ sfwsampleals_repr(const SfwSampleAls *self)
 const char *
 sfwsampleproximity_repr(const SfwSampleProximity *self)
 {
-    static char buf[80];
-    snprintf(buf, sizeof buf,
+    static __thread char buf[80];
+    return sfwsampleproximity_repr_to_buf(self, buf, sizeof buf);
+}
+
+char *
+sfwsampleproximity_repr_to_buf(const SfwSampleProximity *self, char *buf, size_t len)
+{
+    snprintf(buf, len,
              "time=%"PRIu64" distance=%"PRIu32" proximity=%s",
              self->timestamp,
              self->distance,
@@ -627,8 +1045,14 @@ sfwsampleproximity_repr(const SfwSampleProximity *self)
 const char *
 sfwsampleorientation_repr(const SfwSampleOrientation *self)
 {
-    static char buf[80];
-    snprintf(buf, sizeof buf,
+    static __thread char buf[80];
+    return sfwsampleorientation_repr_to_buf(self, buf, sizeof buf);
+}
+
+char *
+sfwsampleorientation_repr_to_buf(const SfwSampleOrientation *self, char *buf, size_t len)
+{
+    snprintf(buf, len,
              "time=%"PRIu64" state=%s",
              self->timestamp,
              sfworientationstate_repr(self->state));
@@ -638,8 +1062,14 @@ sfwsampleorientation_repr(const SfwSampleOrientation *self)
 const char *
 sfwsampleaccelerometer_repr(const SfwSampleAccelerometer *self)
 {
-    static char buf[80];
-    snprintf(buf, sizeof buf,
+    static __thread char buf[80];
+    return sfwsampleaccelerometer_repr_to_buf(self, buf, sizeof buf);
+}
+
+char *
+sfwsampleaccelerometer_repr_to_buf(const SfwSampleAccelerometer *self, char *buf, size_t len)
+{
+    snprintf(buf, len,
              "time=%"PRIu64" x=%g y=%g z=%g",
              self->timestamp,
              self->x,
@@ -651,8 +1081,14 @@ sfwsampleaccelerometer_repr(const SfwSampleAccelerometer *self)
 const char *
 sfwsamplecompass_repr(const SfwSampleCompass *self)
 {
-    static char buf[80];
-    snprintf(buf, sizeof buf,
+    static __thread char buf[80];
+    return sfwsamplecompass_repr_to_buf(self, buf, sizeof buf);
+}
+
+char *
+sfwsamplecompass_repr_to_buf(const SfwSampleCompass *self, char *buf, size_t len)
+{
+    snprintf(buf, len,
              "time=%"PRIu64" deg=%"PRId32" raw=%"PRId32" cor=%"PRId32" lev=%"PRId32,
              self->timestamp,
              self->degrees,
@@ -665,8 +1101,14 @@ sfwsamplecompass_repr(const SfwSampleCompass *self)
 const char *
 sfwsamplegyroscope_repr(const SfwSampleGyroscope *self)
 {
-    static char buf[80];
-    snprintf(buf, sizeof buf,
+    static __thread char buf[80];
+    return sfwsamplegyroscope_repr_to_buf(self, buf, sizeof buf);
+}
+
+char *
+sfwsamplegyroscope_repr_to_buf(const SfwSampleGyroscope *self, char *buf, size_t len)
+{
+    snprintf(buf, len,
              "time=%"PRIu64" x=%g y=%g z=%g",
              self->timestamp,
              self->x,
@@ -678,8 +1120,14 @@ sfwsamplegyroscope_repr(const SfwSampleGyroscope *self)
 const char *
 sfwsamplelid_repr(const SfwSampleLid *self)
 {
-    static char buf[80];
-    snprintf(buf, sizeof buf,
+    static __thread char buf[80];
+    return sfwsamplelid_repr_to_buf(self, buf, sizeof buf);
+}
+
+char *
+sfwsamplelid_repr_to_buf(const SfwSampleLid *self, char *buf, size_t len)
+{
+    snprintf(buf, len,
              "time=%"PRIu64" type=%s value=%"PRIu32,
              self->timestamp,
              sfwlidtype_repr(self->type),
@@ -690,8 +1138,14 @@ sfwsamplelid_repr(const SfwSampleLid *self)
 const char *
 sfwsamplehumidity_repr(const SfwSampleHumidity *self)
 {
-    static char buf[80];
-    snprintf(buf, sizeof buf,
+    static __thread char buf[80];
+    return sfwsamplehumidity_repr_to_buf(self, buf, sizeof buf);
+}
+
+char *
+sfwsamplehumidity_repr_to_buf(const SfwSampleHumidity *self, char *buf, size_t len)
+{
+    snprintf(buf, len,
              "time=%"PRIu64" humidity=%"PRIu32,
              self->timestamp,
              self->value);
@@ -701,8 +1155,14 @@ sfwsamplehumidity_repr(const SfwSampleHumidity *self)
 const char *
 sfwsamplemagnetometer_repr(const SfwSampleMagnetometer *self)
 {
-    static char buf[80];
-    snprintf(buf, sizeof buf,
+    static __thread char buf[80];
+    return sfwsamplemagnetometer_repr_to_buf(self, buf, sizeof buf);
+}
+
+char *
+sfwsamplemagnetometer_repr_to_buf(const SfwSampleMagnetometer *self, char *buf, size_t len)
+{
+    snprintf(buf, len,
              "time=%"PRIu64
              " x=%"PRId32" y=%"PRId32" z=%"PRId32
              " rx=%"PRId32" ry=%"PRId32" rz=%"PRId32
@@ -721,8 +1181,14 @@ sfwsamplemagnetometer_repr(const SfwSampleMagnetometer *self)
 const char *
 sfwsamplepressure_repr(const SfwSamplePressure *self)
 {
-    static char buf[80];
-    snprintf(buf, sizeof buf,
+    static __thread char buf[80];
+    return sfwsamplepressure_repr_to_buf(self, buf, sizeof buf);
+}
+
+char *
+sfwsamplepressure_repr_to_buf(const SfwSamplePressure *self, char *buf, size_t len)
+{
+    snprintf(buf, len,
              "time=%"PRIu64" pressure=%"PRIu32,
              self->timestamp,
              self->value);
@@ -732,8 +1198,14 @@ sfwsamplepressure_repr(const SfwSamplePressure *self)
 const char *
 sfwsamplerotation_repr(const SfwSampleRotation *self)
 {
-    static char buf[80];
-    snprintf(buf, sizeof buf,
+    static __thread char buf[80];
+    return sfwsamplerotation_repr_to_buf(self, buf, sizeof buf);
+}
+
+char *
+sfwsamplerotation_repr_to_buf(const SfwSampleRotation *self, char *buf, size_t len)
+{
+    snprintf(buf, len,
              "time=%"PRIu64" x=%g y=%g z=%g",
              self->timestamp,
              self->x,
@@ -745,8 +1217,14 @@ sfwsamplerotation_repr(const SfwSampleRotation *self)
 const char *
 sfwsamplestepcounter_repr(const SfwSampleStepcounter *self)
 {
-    static char buf[80];
-    snprintf(buf, sizeof buf,
+    static __thread char buf[80];
+    return sfwsamplestepcounter_repr_to_buf(self, buf, sizeof buf);
+}
+
+char *
+sfwsamplestepcounter_repr_to_buf(const SfwSampleStepcounter *self, char *buf, size_t len)
+{
+    snprintf(buf, len,
              "time=%"PRIu64" stepcount=%"PRIu32,
              self->timestamp,
              self->value);
@@ -756,8 +1234,14 @@ sfwsamplestepcounter_repr(const SfwSampleStepcounter *self)
 const char *
 sfwsampletap_repr(const SfwSampleTap *self)
 {
-    static char buf[80];
-    snprintf(buf, sizeof buf, "time=%"PRIu64" direction=%s type=%s",
+    static __thread char buf[80];
+    return sfwsampletap_repr_to_buf(self, buf, sizeof buf);
+}
+
+char *
+sfwsampletap_repr_to_buf(const SfwSampleTap *self, char *buf, size_t len)
+{
+    snprintf(buf, len, "time=%"PRIu64" direction=%s type=%s",
              self->timestamp,
              sfwtapdirection_repr(self->direction),
              sfwtaptype_repr(self->type));
@@ -767,8 +1251,14 @@ sfwsampletap_repr(const SfwSampleTap *self)
 const char *
 sfwsampletemperature_repr(const SfwSampleTemperature *self)
 {
-    static char buf[80];
-    snprintf(buf, sizeof buf,
+    static __thread char buf[80];
+    return sfwsampletemperature_repr_to_buf(self, buf, sizeof buf);
+}
+
+char *
+sfwsampletemperature_repr_to_buf(const SfwSampleTemperature *self, char *buf, size_t len)
+{
+    snprintf(buf, len,
              "time=%"PRIu64" temperature=%"PRIu32,
              self->temperature_timestamp,
              self->temperature_value);
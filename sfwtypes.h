@@ -47,6 +47,13 @@ G_BEGIN_DECLS
 
 # pragma GCC visibility push(default)
 
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Maximum value of sfwsensorid_channel_count() */
+# define SFW_SAMPLE_CHANNELS_MAX 7
+
 /* ========================================================================= *
  * Types
  * ========================================================================= */
@@ -189,6 +196,16 @@ typedef enum SfwTapType
     SFW_TAP_TYPE_SINGLE_TAP = 1,
 } SfwTapType;
 
+/** Output formats for sfwreading_format_batch()
+ */
+typedef enum SfwReadingFormat
+{
+    /** sensor,time,value,... */
+    SFW_READING_FORMAT_CSV,
+    /** {"sensor":...,"time":...,"values":[...]} */
+    SFW_READING_FORMAT_JSON,
+} SfwReadingFormat;
+
 /** Common XYZ data block used by sensord for several sensors
  */
 struct SfwSampleXyz
@@ -392,11 +409,14 @@ struct SfwReading
  * SFWSENSORID
  * ------------------------------------------------------------------------- */
 
-bool        sfwsensorid_is_valid   (SfwSensorId id);
-const char *sfwsensorid_name       (SfwSensorId id);
-size_t      sfwsensorid_sample_size(SfwSensorId id);
-const char *sfwsensorid_interface  (SfwSensorId id);
-const char *sfwsensorid_object     (SfwSensorId id);
+bool        sfwsensorid_is_valid     (SfwSensorId id);
+const char *sfwsensorid_name         (SfwSensorId id);
+size_t      sfwsensorid_sample_size  (SfwSensorId id);
+size_t      sfwsensorid_channel_count(SfwSensorId id);
+bool        sfwsensorid_channel_float(SfwSensorId id);
+bool        sfwsensorid_is_xyz       (SfwSensorId id);
+const char *sfwsensorid_interface    (SfwSensorId id);
+const char *sfwsensorid_object       (SfwSensorId id);
 
 /* ------------------------------------------------------------------------- *
  * SFWREADING
@@ -404,6 +424,8 @@ const char *sfwsensorid_object     (SfwSensorId id);
 
 SfwSensorId                   sfwreading_sensor_id    (const SfwReading *self);
 const char                   *sfwreading_repr         (const SfwReading *self);
+char                         *sfwreading_repr_to_buf  (const SfwReading *self, char *buf, size_t len);
+size_t                        sfwreading_format_batch (const SfwReading *readings, size_t count, SfwReadingFormat format, char *buf, size_t size, size_t *used);
 void                          sfwreading_normalize    (SfwReading *self);
 const SfwSampleXyz           *sfwreading_xyz          (const SfwReading *self);
 const SfwSampleAls           *sfwreading_als          (const SfwReading *self);
@@ -421,24 +443,52 @@ const SfwSampleStepcounter   *sfwreading_stepcounter  (const SfwReading *self);
 const SfwSampleTap           *sfwreading_tap          (const SfwReading *self);
 const SfwSampleTemperature   *sfwreading_temperature  (const SfwReading *self);
 
+/* ------------------------------------------------------------------------- *
+ * SFWSAMPLE_NORMALIZE
+ * ------------------------------------------------------------------------- */
+
+void   sfwsample_normalize(SfwSensorId id, SfwSample *samples, size_t count);
+double sfwsample_channel  (SfwSensorId id, const SfwSample *sample, size_t channel);
+
+/* ------------------------------------------------------------------------- *
+ * SFWSAMPLE_SOA
+ * ------------------------------------------------------------------------- */
+
+void sfwsample_xyz_to_soa       (const SfwSample *samples, size_t count, uint64_t *t, float *x, float *y, float *z);
+void sfwsample_xyz_to_soa_double(const SfwSample *samples, size_t count, uint64_t *t, double *x, double *y, double *z);
+
 /* ------------------------------------------------------------------------- *
  * SFWSAMPLE
  * ------------------------------------------------------------------------- */
 
-const char *sfwsampleals_repr          (const SfwSampleAls *self);
-const char *sfwsampleproximity_repr    (const SfwSampleProximity *self);
-const char *sfwsampleorientation_repr  (const SfwSampleOrientation *self);
-const char *sfwsampleaccelerometer_repr(const SfwSampleAccelerometer *self);
-const char *sfwsamplecompass_repr      (const SfwSampleCompass *self);
-const char *sfwsamplegyroscope_repr    (const SfwSampleGyroscope *self);
-const char *sfwsamplelid_repr          (const SfwSampleLid *self);
-const char *sfwsamplehumidity_repr     (const SfwSampleHumidity *self);
-const char *sfwsamplemagnetometer_repr (const SfwSampleMagnetometer *self);
-const char *sfwsamplepressure_repr     (const SfwSamplePressure *self);
-const char *sfwsamplerotation_repr     (const SfwSampleRotation *self);
-const char *sfwsamplestepcounter_repr  (const SfwSampleStepcounter *self);
-const char *sfwsampletap_repr          (const SfwSampleTap *self);
-const char *sfwsampletemperature_repr  (const SfwSampleTemperature *self);
+const char *sfwsampleals_repr                 (const SfwSampleAls *self);
+char       *sfwsampleals_repr_to_buf          (const SfwSampleAls *self, char *buf, size_t len);
+const char *sfwsampleproximity_repr           (const SfwSampleProximity *self);
+char       *sfwsampleproximity_repr_to_buf    (const SfwSampleProximity *self, char *buf, size_t len);
+const char *sfwsampleorientation_repr         (const SfwSampleOrientation *self);
+char       *sfwsampleorientation_repr_to_buf  (const SfwSampleOrientation *self, char *buf, size_t len);
+const char *sfwsampleaccelerometer_repr       (const SfwSampleAccelerometer *self);
+char       *sfwsampleaccelerometer_repr_to_buf(const SfwSampleAccelerometer *self, char *buf, size_t len);
+const char *sfwsamplecompass_repr             (const SfwSampleCompass *self);
+char       *sfwsamplecompass_repr_to_buf      (const SfwSampleCompass *self, char *buf, size_t len);
+const char *sfwsamplegyroscope_repr           (const SfwSampleGyroscope *self);
+char       *sfwsamplegyroscope_repr_to_buf    (const SfwSampleGyroscope *self, char *buf, size_t len);
+const char *sfwsamplelid_repr                 (const SfwSampleLid *self);
+char       *sfwsamplelid_repr_to_buf          (const SfwSampleLid *self, char *buf, size_t len);
+const char *sfwsamplehumidity_repr            (const SfwSampleHumidity *self);
+char       *sfwsamplehumidity_repr_to_buf     (const SfwSampleHumidity *self, char *buf, size_t len);
+const char *sfwsamplemagnetometer_repr        (const SfwSampleMagnetometer *self);
+char       *sfwsamplemagnetometer_repr_to_buf (const SfwSampleMagnetometer *self, char *buf, size_t len);
+const char *sfwsamplepressure_repr            (const SfwSamplePressure *self);
+char       *sfwsamplepressure_repr_to_buf     (const SfwSamplePressure *self, char *buf, size_t len);
+const char *sfwsamplerotation_repr            (const SfwSampleRotation *self);
+char       *sfwsamplerotation_repr_to_buf     (const SfwSampleRotation *self, char *buf, size_t len);
+const char *sfwsamplestepcounter_repr         (const SfwSampleStepcounter *self);
+char       *sfwsamplestepcounter_repr_to_buf  (const SfwSampleStepcounter *self, char *buf, size_t len);
+const char *sfwsampletap_repr                 (const SfwSampleTap *self);
+char       *sfwsampletap_repr_to_buf          (const SfwSampleTap *self, char *buf, size_t len);
+const char *sfwsampletemperature_repr         (const SfwSampleTemperature *self);
+char       *sfwsampletemperature_repr_to_buf  (const SfwSampleTemperature *self, char *buf, size_t len);
 
 /* ------------------------------------------------------------------------- *
  * SFWORIENTATIONSTATE
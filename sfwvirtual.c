@@ -0,0 +1,573 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#include "sfwvirtual.h"
+
+#include "sfwlogging.h"
+
+#include <math.h>
+
+/* ========================================================================= *
+ * Constants
+ * ========================================================================= */
+
+/** Standard gravity [m/s^2] */
+#define SFWVIRTUAL_GRAVITY 9.80665
+
+/** Time constant of gravity low pass filter [s] */
+#define SFWVIRTUAL_GRAVITY_TC 0.2
+
+/** Gravity axis component needed for entering orientation state,
+ *  relative to gravity magnitude; 0.8 = about 37 degrees from axis */
+#define SFWVIRTUAL_ORIENTATION_ENTER 0.8
+
+/** Minimum change of tilt angles that is reported [deg] */
+#define SFWVIRTUAL_TILT_STEP 0.5
+
+/** High pass acceleration that triggers tap detection [m/s^2] */
+#define SFWVIRTUAL_TAP_THRESHOLD 8.0
+
+/** High pass acceleration below which tap detection is rearmed [m/s^2] */
+#define SFWVIRTUAL_TAP_RELEASE 3.0
+
+/** Maximum duration of a tap [us] */
+#define SFWVIRTUAL_TAP_DURATION_MAX 100000
+
+/** Minimum and maximum distance between taps of a double tap [us] */
+#define SFWVIRTUAL_DOUBLE_TAP_MIN  80000
+#define SFWVIRTUAL_DOUBLE_TAP_MAX 400000
+
+/** High pass acceleration counted as shake peak [m/s^2] */
+#define SFWVIRTUAL_SHAKE_THRESHOLD 12.0
+
+/** Number of alternating peaks within window needed for shake */
+#define SFWVIRTUAL_SHAKE_PEAKS 4
+
+/** Time window for shake peaks, and quiet time after a shake [us] */
+#define SFWVIRTUAL_SHAKE_WINDOW 1000000
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+struct SfwVirtual
+{
+    SfwVirtualId        vrt_id;
+    SfwSensorId         vrt_output_id;
+    SfwVirtualFunc      vrt_func;
+    gpointer            vrt_func_aptr;
+
+    SfwVirtualHandler   vrt_handler;
+    gpointer            vrt_aptr;
+
+    SfwSensor          *vrt_source;
+    guint               vrt_source_id;
+
+    SfwReading          vrt_reading;
+
+    /* Gravity estimate shared by built-in sensors */
+    bool                vrt_primed;
+    uint64_t            vrt_time;
+    double              vrt_gravity[3];
+    double              vrt_linear[3];
+
+    /* Orientation and tilt */
+    SfwOrientationState vrt_orientation;
+    bool                vrt_tilt_valid;
+
+    /* Tap detection */
+    bool                vrt_tap_armed;
+    uint64_t            vrt_tap_trigger;
+    bool                vrt_tap_pending;
+    uint64_t            vrt_tap_time;
+    SfwTapDirection     vrt_tap_direction;
+
+    /* Shake detection */
+    size_t              vrt_shake_axis;
+    int                 vrt_shake_sign;
+    size_t              vrt_shake_peaks;
+    uint64_t            vrt_shake_start;
+    uint64_t            vrt_shake_quiet;
+};
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWVIRTUAL_BUILTIN
+ * ------------------------------------------------------------------------- */
+
+static bool   sfwvirtual_gravity_update (SfwVirtual *self, const SfwReading *input);
+static size_t sfwvirtual_dominant_axis  (const double *v);
+static bool   sfwvirtual_orientation_cb (SfwVirtual *self, const SfwReading *input, SfwReading *output, gpointer aptr);
+static bool   sfwvirtual_tilt_cb        (SfwVirtual *self, const SfwReading *input, SfwReading *output, gpointer aptr);
+static bool   sfwvirtual_tap_cb         (SfwVirtual *self, const SfwReading *input, SfwReading *output, gpointer aptr);
+static bool   sfwvirtual_shake_cb       (SfwVirtual *self, const SfwReading *input, SfwReading *output, gpointer aptr);
+
+/* ------------------------------------------------------------------------- *
+ * SFWVIRTUAL
+ * ------------------------------------------------------------------------- */
+
+static void       sfwvirtual_reading_cb (SfwSensor *sensor, const SfwReading *reading, gpointer aptr);
+static SfwVirtual *sfwvirtual_create    (SfwVirtualId id, SfwSensorId output, SfwVirtualFunc func, gpointer aptr);
+SfwVirtual       *sfwvirtual_new        (SfwVirtualId id);
+SfwVirtual       *sfwvirtual_new_custom (SfwSensorId output, SfwVirtualFunc func, gpointer aptr);
+void              sfwvirtual_delete     (SfwVirtual *self);
+void              sfwvirtual_delete_at  (SfwVirtual **pself);
+SfwVirtualId      sfwvirtual_id         (const SfwVirtual *self);
+SfwSensorId       sfwvirtual_sensor_id  (const SfwVirtual *self);
+void              sfwvirtual_set_handler(SfwVirtual *self, SfwVirtualHandler handler, gpointer aptr);
+void              sfwvirtual_reset      (SfwVirtual *self);
+bool              sfwvirtual_attach     (SfwVirtual *self, SfwSensor *sensor);
+void              sfwvirtual_detach     (SfwVirtual *self);
+void              sfwvirtual_add        (SfwVirtual *self, const SfwReading *reading);
+const SfwReading *sfwvirtual_reading    (const SfwVirtual *self);
+
+/* ========================================================================= *
+ * SFWVIRTUAL_BUILTIN
+ * ========================================================================= */
+
+/** Split accelerometer reading into gravity and linear acceleration
+ *
+ * @return true if input was accelerometer reading, false otherwise
+ */
+static bool
+sfwvirtual_gravity_update(SfwVirtual *self, const SfwReading *input)
+{
+    const SfwSampleXyz *xyz = sfwreading_accelerometer(input);
+    if( !xyz )
+        return false;
+
+    double a[3] = { xyz->x, xyz->y, xyz->z };
+
+    if( !self->vrt_primed || xyz->timestamp < self->vrt_time ) {
+        self->vrt_primed = true;
+        for( size_t i = 0; i < 3; ++i )
+            self->vrt_gravity[i] = a[i];
+    }
+    else {
+        double dt    = (xyz->timestamp - self->vrt_time) * 1e-6;
+        double alpha = dt / (SFWVIRTUAL_GRAVITY_TC + dt);
+        for( size_t i = 0; i < 3; ++i )
+            self->vrt_gravity[i] += alpha * (a[i] - self->vrt_gravity[i]);
+    }
+    for( size_t i = 0; i < 3; ++i )
+        self->vrt_linear[i] = a[i] - self->vrt_gravity[i];
+    self->vrt_time = xyz->timestamp;
+    return true;
+}
+
+static size_t
+sfwvirtual_dominant_axis(const double *v)
+{
+    size_t axis = 0;
+    for( size_t i = 1; i < 3; ++i )
+        if( fabs(v[i]) > fabs(v[axis]) )
+            axis = i;
+    return axis;
+}
+
+static bool
+sfwvirtual_orientation_cb(SfwVirtual *self, const SfwReading *input,
+                          SfwReading *output, gpointer aptr)
+{
+    (void)aptr;
+
+    if( !sfwvirtual_gravity_update(self, input) )
+        return false;
+
+    const double *g   = self->vrt_gravity;
+    double        mag = sqrt(g[0] * g[0] + g[1] * g[1] + g[2] * g[2]);
+
+    /* Gravity estimate is unreliable during strong movement */
+    if( mag < 0.5 * SFWVIRTUAL_GRAVITY || mag > 1.5 * SFWVIRTUAL_GRAVITY )
+        return false;
+
+    /* States are entered only when close to an axis, which leaves
+     * a dead band between states as hysteresis */
+    size_t axis = sfwvirtual_dominant_axis(g);
+    if( fabs(g[axis]) < SFWVIRTUAL_ORIENTATION_ENTER * mag )
+        return false;
+
+    static const SfwOrientationState lut[3][2] = {
+        { SFW_ORIENTATION_LEFT_UP,   SFW_ORIENTATION_RIGHT_UP    },
+        { SFW_ORIENTATION_BOTTOM_UP, SFW_ORIENTATION_BOTTOM_DOWN },
+        { SFW_ORIENTATION_FACE_DOWN, SFW_ORIENTATION_FACE_UP     },
+    };
+    SfwOrientationState state = lut[axis][g[axis] > 0.0];
+    if( state == self->vrt_orientation )
+        return false;
+
+    self->vrt_orientation = state;
+    output->sample.orientation.timestamp = self->vrt_time;
+    output->sample.orientation.state     = state;
+    return true;
+}
+
+static bool
+sfwvirtual_tilt_cb(SfwVirtual *self, const SfwReading *input,
+                   SfwReading *output, gpointer aptr)
+{
+    (void)aptr;
+
+    if( !sfwvirtual_gravity_update(self, input) )
+        return false;
+
+    const double *g     = self->vrt_gravity;
+    float         pitch = (float)(atan2(g[1], hypot(g[0], g[2])) * 180.0 / M_PI);
+    float         roll  = (float)(atan2(-g[0], hypot(g[1], g[2])) * 180.0 / M_PI);
+
+    if( self->vrt_tilt_valid &&
+        fabsf(pitch - output->sample.rotation.x) < SFWVIRTUAL_TILT_STEP &&
+        fabsf(roll  - output->sample.rotation.y) < SFWVIRTUAL_TILT_STEP )
+        return false;
+
+    self->vrt_tilt_valid = true;
+    output->sample.rotation.timestamp = self->vrt_time;
+    output->sample.rotation.x         = pitch;
+    output->sample.rotation.y         = roll;
+    output->sample.rotation.z         = 0.0f;
+    return true;
+}
+
+/** Detect taps as short spikes in linear acceleration
+ *
+ * Single taps are reported only after the double tap window has
+ * passed, i.e. on the first reading after it.
+ */
+static bool
+sfwvirtual_tap_cb(SfwVirtual *self, const SfwReading *input,
+                  SfwReading *output, gpointer aptr)
+{
+    bool emit = false;
+    (void)aptr;
+
+    if( !sfwvirtual_gravity_update(self, input) )
+        goto EXIT;
+
+    uint64_t      t    = self->vrt_time;
+    const double *v    = self->vrt_linear;
+    size_t        axis = sfwvirtual_dominant_axis(v);
+    double        peak = fabs(v[axis]);
+
+    output->sample.tap.timestamp = t;
+
+    /* Pending tap that was not followed by another one */
+    if( self->vrt_tap_pending &&
+        t - self->vrt_tap_time > SFWVIRTUAL_DOUBLE_TAP_MAX ) {
+        self->vrt_tap_pending      = false;
+        output->sample.tap.direction = self->vrt_tap_direction;
+        output->sample.tap.type      = SFW_TAP_TYPE_SINGLE_TAP;
+        emit = true;
+    }
+
+    if( self->vrt_tap_armed && peak >= SFWVIRTUAL_TAP_THRESHOLD ) {
+        self->vrt_tap_armed   = false;
+        self->vrt_tap_trigger = t;
+        if( !self->vrt_tap_pending ) {
+            self->vrt_tap_pending   = true;
+            self->vrt_tap_time      = t;
+            self->vrt_tap_direction = (SfwTapDirection)(SFW_TAP_DIRECTION_X + axis);
+        }
+        else if( t - self->vrt_tap_time >= SFWVIRTUAL_DOUBLE_TAP_MIN ) {
+            self->vrt_tap_pending        = false;
+            output->sample.tap.direction = self->vrt_tap_direction;
+            output->sample.tap.type      = SFW_TAP_TYPE_DOUBLE_TAP;
+            emit = true;
+        }
+    }
+    else if( !self->vrt_tap_armed ) {
+        if( peak < SFWVIRTUAL_TAP_RELEASE ) {
+            self->vrt_tap_armed = true;
+        }
+        else if( t - self->vrt_tap_trigger > SFWVIRTUAL_TAP_DURATION_MAX ) {
+            /* Sustained acceleration is movement, not a tap */
+            if( self->vrt_tap_pending && self->vrt_tap_time == self->vrt_tap_trigger )
+                self->vrt_tap_pending = false;
+        }
+    }
+
+EXIT:
+    return emit;
+}
+
+/** Detect shaking as alternating linear acceleration peaks
+ */
+static bool
+sfwvirtual_shake_cb(SfwVirtual *self, const SfwReading *input,
+                    SfwReading *output, gpointer aptr)
+{
+    bool emit = false;
+    (void)aptr;
+
+    if( !sfwvirtual_gravity_update(self, input) )
+        goto EXIT;
+
+    uint64_t      t    = self->vrt_time;
+    const double *v    = self->vrt_linear;
+    size_t        axis = sfwvirtual_dominant_axis(v);
+
+    if( fabs(v[axis]) < SFWVIRTUAL_SHAKE_THRESHOLD || t < self->vrt_shake_quiet )
+        goto EXIT;
+
+    int sign = (v[axis] > 0.0) ? 1 : -1;
+    if( axis != self->vrt_shake_axis ||
+        t - self->vrt_shake_start > SFWVIRTUAL_SHAKE_WINDOW ) {
+        self->vrt_shake_axis  = axis;
+        self->vrt_shake_sign  = sign;
+        self->vrt_shake_peaks = 1;
+        self->vrt_shake_start = t;
+        goto EXIT;
+    }
+
+    if( sign == self->vrt_shake_sign )
+        goto EXIT;
+
+    self->vrt_shake_sign = sign;
+    if( ++self->vrt_shake_peaks < SFWVIRTUAL_SHAKE_PEAKS )
+        goto EXIT;
+
+    self->vrt_shake_peaks = 0;
+    self->vrt_shake_start = 0;
+    self->vrt_shake_quiet = t + SFWVIRTUAL_SHAKE_WINDOW;
+    output->sample.tap.timestamp = t;
+    output->sample.tap.direction = (SfwTapDirection)(SFW_TAP_DIRECTION_X + axis);
+    output->sample.tap.type      = SFW_TAP_TYPE_NONE;
+    emit = true;
+
+EXIT:
+    return emit;
+}
+
+/* ========================================================================= *
+ * SFWVIRTUAL
+ * ========================================================================= */
+
+static void
+sfwvirtual_reading_cb(SfwSensor *sensor, const SfwReading *reading,
+                      gpointer aptr)
+{
+    (void)sensor;
+    sfwvirtual_add(aptr, reading);
+}
+
+static SfwVirtual *
+sfwvirtual_create(SfwVirtualId id, SfwSensorId output, SfwVirtualFunc func,
+                  gpointer aptr)
+{
+    SfwVirtual *self = g_new0(SfwVirtual, 1);
+    self->vrt_id                = id;
+    self->vrt_output_id         = output;
+    self->vrt_func              = func;
+    self->vrt_func_aptr         = aptr;
+    self->vrt_reading.sensor_id = output;
+    sfwvirtual_reset(self);
+    return self;
+}
+
+/** Create built-in virtual sensor
+ *
+ * @return virtual sensor, or NULL if id is not a built-in type
+ */
+SfwVirtual *
+sfwvirtual_new(SfwVirtualId id)
+{
+    SfwVirtual *self = NULL;
+
+    switch( id ) {
+    case SFW_VIRTUAL_ORIENTATION:
+        self = sfwvirtual_create(id, SFW_SENSOR_ID_ORIENTATION,
+                                 sfwvirtual_orientation_cb, NULL);
+        break;
+    case SFW_VIRTUAL_TILT:
+        self = sfwvirtual_create(id, SFW_SENSOR_ID_ROTATION,
+                                 sfwvirtual_tilt_cb, NULL);
+        break;
+    case SFW_VIRTUAL_TAP:
+        self = sfwvirtual_create(id, SFW_SENSOR_ID_TAP,
+                                 sfwvirtual_tap_cb, NULL);
+        break;
+    case SFW_VIRTUAL_SHAKE:
+        self = sfwvirtual_create(id, SFW_SENSOR_ID_TAP,
+                                 sfwvirtual_shake_cb, NULL);
+        break;
+    default:
+        sfwlog_warning("virtual sensor %d: not a built-in type", id);
+        break;
+    }
+
+    return self;
+}
+
+/** Create virtual sensor computed by application supplied function
+ *
+ * @param output  sensor id, i.e. sample type, of the produced readings
+ */
+SfwVirtual *
+sfwvirtual_new_custom(SfwSensorId output, SfwVirtualFunc func, gpointer aptr)
+{
+    if( !sfwsensorid_is_valid(output) || !func )
+        return NULL;
+    return sfwvirtual_create(SFW_VIRTUAL_CUSTOM, output, func, aptr);
+}
+
+void
+sfwvirtual_delete(SfwVirtual *self)
+{
+    if( self ) {
+        sfwvirtual_detach(self);
+        g_free(self);
+    }
+}
+
+void
+sfwvirtual_delete_at(SfwVirtual **pself)
+{
+    sfwvirtual_delete(*pself), *pself = NULL;
+}
+
+SfwVirtualId
+sfwvirtual_id(const SfwVirtual *self)
+{
+    return self ? self->vrt_id : SFW_VIRTUAL_CUSTOM;
+}
+
+SfwSensorId
+sfwvirtual_sensor_id(const SfwVirtual *self)
+{
+    return self ? self->vrt_output_id : SFW_SENSOR_ID_INVALID;
+}
+
+void
+sfwvirtual_set_handler(SfwVirtual *self, SfwVirtualHandler handler,
+                       gpointer aptr)
+{
+    if( self ) {
+        self->vrt_handler = handler;
+        self->vrt_aptr    = aptr;
+    }
+}
+
+/** Forget state accumulated from previous readings
+ */
+void
+sfwvirtual_reset(SfwVirtual *self)
+{
+    if( self ) {
+        self->vrt_primed      = false;
+        self->vrt_orientation = SFW_ORIENTATION_UNDEFINED;
+        self->vrt_tilt_valid  = false;
+        self->vrt_tap_armed   = true;
+        self->vrt_tap_pending = false;
+        self->vrt_shake_peaks = 0;
+        self->vrt_shake_start = 0;
+        self->vrt_shake_quiet = 0;
+    }
+}
+
+/** Start computing readings from an already open sensor
+ *
+ * Built-in virtual sensors accept only accelerometer sensors. The
+ * sensor is not started; it is expected to be in use anyway.
+ *
+ * @return true if sensor was attached, false otherwise
+ */
+bool
+sfwvirtual_attach(SfwVirtual *self, SfwSensor *sensor)
+{
+    bool ack = false;
+
+    if( !self || !sensor )
+        goto EXIT;
+
+    if( self->vrt_id != SFW_VIRTUAL_CUSTOM &&
+        sfwreading_sensor_id(sfwsensor_reading(sensor)) != SFW_SENSOR_ID_ACCELEROMETER ) {
+        sfwlog_warning("%s: not applicable for virtual sensor", sfwsensor_name(sensor));
+        goto EXIT;
+    }
+
+    sfwvirtual_detach(self);
+    self->vrt_source_id =
+        sfwsensor_add_reading_callback(sensor, sfwvirtual_reading_cb, self);
+    if( !self->vrt_source_id )
+        goto EXIT;
+    self->vrt_source = sfwsensor_ref(sensor);
+    ack = true;
+
+EXIT:
+    return ack;
+}
+
+/** Stop computing readings from attached sensor
+ */
+void
+sfwvirtual_detach(SfwVirtual *self)
+{
+    if( self && self->vrt_source ) {
+        sfwsensor_remove_reading_callback(self->vrt_source,
+                                          self->vrt_source_id);
+        self->vrt_source_id = 0;
+        sfwsensor_unref_at(&self->vrt_source);
+    }
+}
+
+/** Feed one reading to virtual sensor
+ *
+ * Can be used instead of sfwvirtual_attach(), e.g. with readings from
+ * replayed recordings.
+ */
+void
+sfwvirtual_add(SfwVirtual *self, const SfwReading *reading)
+{
+    if( !self || !reading )
+        return;
+
+    if( self->vrt_func(self, reading, &self->vrt_reading, self->vrt_func_aptr) ) {
+        self->vrt_reading.sensor_id = self->vrt_output_id;
+        if( self->vrt_handler )
+            self->vrt_handler(self, &self->vrt_reading, self->vrt_aptr);
+    }
+}
+
+/** Get latest reading produced by virtual sensor
+ */
+const SfwReading *
+sfwvirtual_reading(const SfwVirtual *self)
+{
+    return self ? &self->vrt_reading : NULL;
+}
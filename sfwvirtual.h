@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright (c) 2026 Jollyboys Ltd.
+ *
+ * All rights reserved.
+ *
+ * This file is part of Sailfish sensors-glib package.
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef SFWVIRTUAL_H_
+# define SFWVIRTUAL_H_
+
+# include "sfwsensor.h"
+
+G_BEGIN_DECLS
+
+# pragma GCC visibility push(default)
+
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+/** Virtual sensor types
+ */
+typedef enum SfwVirtualId
+{
+    /** Readings computed by application supplied function */
+    SFW_VIRTUAL_CUSTOM,
+
+    /** Orientation state from gravity vector;
+     *  SFW_SENSOR_ID_ORIENTATION readings, emitted on change */
+    SFW_VIRTUAL_ORIENTATION,
+
+    /** Tilt angles from gravity vector in degrees, x = pitch and
+     *  y = roll; SFW_SENSOR_ID_ROTATION readings */
+    SFW_VIRTUAL_TILT,
+
+    /** Single and double taps; SFW_SENSOR_ID_TAP readings */
+    SFW_VIRTUAL_TAP,
+
+    /** Shaking; SFW_SENSOR_ID_TAP readings with SFW_TAP_TYPE_NONE
+     *  type and axis of shaking as direction */
+    SFW_VIRTUAL_SHAKE,
+} SfwVirtualId;
+
+/** Sensor readings derived locally from readings of another sensor
+ *
+ * Built-in virtual sensors take accelerometer readings as input.
+ */
+typedef struct SfwVirtual SfwVirtual;
+
+/** Function for computing virtual sensor readings
+ *
+ * @param input   reading from source sensor
+ * @param output  reading to fill in, sensor id is set by caller
+ *
+ * @return true if output reading should be delivered, false otherwise
+ */
+typedef bool (*SfwVirtualFunc)(SfwVirtual *virt, const SfwReading *input, SfwReading *output, gpointer aptr);
+
+/** Callback for receiving virtual sensor readings
+ */
+typedef void (*SfwVirtualHandler)(SfwVirtual *virt, const SfwReading *reading, gpointer aptr);
+
+/* ========================================================================= *
+ * Prototypes
+ * ========================================================================= */
+
+/* ------------------------------------------------------------------------- *
+ * SFWVIRTUAL
+ * ------------------------------------------------------------------------- */
+
+SfwVirtual       *sfwvirtual_new        (SfwVirtualId id);
+SfwVirtual       *sfwvirtual_new_custom (SfwSensorId output, SfwVirtualFunc func, gpointer aptr);
+void              sfwvirtual_delete     (SfwVirtual *self);
+void              sfwvirtual_delete_at  (SfwVirtual **pself);
+SfwVirtualId      sfwvirtual_id         (const SfwVirtual *self);
+SfwSensorId       sfwvirtual_sensor_id  (const SfwVirtual *self);
+void              sfwvirtual_set_handler(SfwVirtual *self, SfwVirtualHandler handler, gpointer aptr);
+void              sfwvirtual_reset      (SfwVirtual *self);
+bool              sfwvirtual_attach     (SfwVirtual *self, SfwSensor *sensor);
+void              sfwvirtual_detach     (SfwVirtual *self);
+void              sfwvirtual_add        (SfwVirtual *self, const SfwReading *reading);
+const SfwReading *sfwvirtual_reading    (const SfwVirtual *self);
+
+# pragma GCC visibility pop
+
+G_END_DECLS
+
+#endif /* SFWVIRTUAL_H_ */
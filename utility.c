@@ -40,6 +40,7 @@
 #include "sfwlogging.h"
 
 #include <sys/un.h>
+#include <sys/ioctl.h>
 
 #include <fcntl.h>
 
@@ -55,6 +56,13 @@ bool cancellable_finish(GCancellable **pcancellable);
 bool cancellable_cancel(GCancellable **pcancellable);
 void cancellable_start (GCancellable **pcancellable);
 
+/* ------------------------------------------------------------------------- *
+ * ASYNC_CALL
+ * ------------------------------------------------------------------------- */
+
+AsyncCall *async_call_new   (gpointer object, GCancellable *cancellable, const char *what);
+void       async_call_delete(AsyncCall *self);
+
 /* ------------------------------------------------------------------------- *
  * SOCKET
  * ------------------------------------------------------------------------- */
@@ -67,6 +75,7 @@ bool    socket_close          (int fd);
 bool    socket_close_at       (int *pfd);
 ssize_t socket_write          (int fd, const void *data, size_t size);
 ssize_t socket_read           (int fd, void *buff, size_t size);
+ssize_t socket_pending        (int fd);
 
 /* ------------------------------------------------------------------------- *
  * ERROR
@@ -117,6 +126,29 @@ cancellable_start(GCancellable **pcancellable)
     }
 }
 
+/* ========================================================================= *
+ * ASYNC_CALL
+ * ========================================================================= */
+
+AsyncCall *
+async_call_new(gpointer object, GCancellable *cancellable, const char *what)
+{
+    AsyncCall *self = g_malloc0(sizeof *self);
+    self->ac_object      = object;
+    self->ac_cancellable = gutil_object_ref(cancellable);
+    self->ac_what        = what;
+    return self;
+}
+
+void
+async_call_delete(AsyncCall *self)
+{
+    if( self ) {
+        gutil_object_unref(self->ac_cancellable);
+        g_free(self);
+    }
+}
+
 /* ========================================================================= *
  * SOCKET
  * ========================================================================= */
@@ -277,6 +309,22 @@ socket_read(int fd, void *buff, size_t size)
     return done;
 }
 
+/** Get number of bytes that can be read without blocking
+ *
+ * @return byte count, or -1 on error
+ */
+ssize_t
+socket_pending(int fd)
+{
+    int avail = 0;
+
+    if( ioctl(fd, FIONREAD, &avail) == -1 ) {
+        sfwlog_err("socket ioctl: %m");
+        return -1;
+    }
+    return avail;
+}
+
 /* ========================================================================= *
  * ERROR
  * ========================================================================= */
@@ -44,6 +44,27 @@
 
 # include <gio/gio.h>
 
+/* ========================================================================= *
+ * Types
+ * ========================================================================= */
+
+/** Bookkeeping for one asynchronous D-Bus call
+ *
+ * Passed as callback data, so that completion can be matched with
+ * the call it belongs to even after the owner has started another.
+ */
+typedef struct AsyncCall
+{
+    /** Object that made the call; reference is managed by caller */
+    gpointer      ac_object;
+
+    /** Cancellable used for the call; also identifies the call */
+    GCancellable *ac_cancellable;
+
+    /** Name of the method called, for tracing */
+    const char   *ac_what;
+} AsyncCall;
+
 /* ========================================================================= *
  * Prototypes
  * ========================================================================= */
@@ -56,6 +77,13 @@ bool cancellable_finish(GCancellable **pcancellable);
 bool cancellable_cancel(GCancellable **pcancellable);
 void cancellable_start (GCancellable **pcancellable);
 
+/* ------------------------------------------------------------------------- *
+ * ASYNC_CALL
+ * ------------------------------------------------------------------------- */
+
+AsyncCall *async_call_new   (gpointer object, GCancellable *cancellable, const char *what);
+void       async_call_delete(AsyncCall *self);
+
 /* ------------------------------------------------------------------------- *
  * SOCKET
  * ------------------------------------------------------------------------- */
@@ -68,6 +96,7 @@ bool    socket_close          (int fd);
 bool    socket_close_at       (int *pfd);
 ssize_t socket_write          (int fd, const void *data, size_t size);
 ssize_t socket_read           (int fd, void *buff, size_t size);
+ssize_t socket_pending        (int fd);
 
 /* ------------------------------------------------------------------------- *
  * ERROR